@@ -0,0 +1,124 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class ClimateStationInterpolation
+*/
+#include "ClimateStationInterpolation.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// GEO
+#include "KdTree.h"
+#include "PointWithID.h"
+#include "SensorData.h"
+#include "Station.h"
+
+namespace FiniteElement
+{
+ClimateStationInterpolation::ClimateStationInterpolation(
+    const std::vector<GEOLIB::PointWithID*>& points,
+    const std::vector<GEOLIB::Station*>& stations,
+    std::size_t n_nearest,
+    double exponent)
+    : _stations(stations),
+      _station_data_time(0.0)
+{
+    const std::size_t n_points(points.size());
+    const std::size_t n_stations(stations.size());
+    if (n_nearest == 0 || n_nearest > n_stations)
+        n_nearest = n_stations;
+
+    _point_ids.resize(n_points);
+    _row_ptr.resize(n_points + 1, 0);
+    _station_idx.reserve(n_points * n_nearest);
+    _weight.reserve(n_points * n_nearest);
+
+    // the elevation is ignored, it is small compared to the distances
+    std::vector<double> x(n_stations), y(n_stations), z(n_stations, 0.0);
+    for (std::size_t q = 0; q < n_stations; q++)
+    {
+        x[q] = (*stations[q])[0];
+        y[q] = (*stations[q])[1];
+    }
+    const GEOLIB::KdTree tree(x, y, z);
+
+    std::vector<std::size_t> ids;
+    std::vector<double> sqr_dists;
+    std::vector<std::pair<std::size_t, double> > row;
+    for (std::size_t i = 0; i < n_points; i++)
+    {
+        _point_ids[i] = points[i]->getID();
+        if (n_nearest > 0)
+        {
+            const double pnt[3] = {(*points[i])[0], (*points[i])[1], 0.0};
+            tree.getNearestPoints(pnt, n_nearest, ids, sqr_dists);
+        }
+
+        row.clear();
+        double sum(0.0);
+        for (std::size_t k = 0; k < ids.size() && n_nearest > 0; k++)
+        {
+            const double dist(std::max(DBL_MIN, std::sqrt(sqr_dists[k])));
+            const double w(1.0 / std::pow(dist, exponent));
+            if (w > DBL_MAX)
+            {
+                // the node coincides with the station
+                row.assign(1, std::make_pair(ids[k], 1.0));
+                sum = 1.0;
+                break;
+            }
+            row.push_back(std::make_pair(ids[k], w));
+            sum += w;
+        }
+        // station order as in the dense interpolation
+        std::sort(row.begin(), row.end());
+        for (std::size_t k = 0; k < row.size(); k++)
+        {
+            _station_idx.push_back(row[k].first);
+            _weight.push_back(row[k].second / sum);
+        }
+        _row_ptr[i + 1] = _station_idx.size();
+    }
+}
+
+void ClimateStationInterpolation::interpolate(double time,
+                                              std::vector<double>& values)
+{
+    const std::size_t n_stations(_stations.size());
+    if (_station_data.size() != n_stations || time != _station_data_time)
+    {
+        _station_data.resize(n_stations);
+        for (std::size_t q = 0; q < n_stations; q++)
+            _station_data[q] = _stations[q]->getSensorData()->getData(
+                SensorDataType::RECHARGE, time, true);
+        _station_data_time = time;
+    }
+
+    const long n_points(static_cast<long>(_point_ids.size()));
+    values.resize(n_points);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < n_points; i++)
+    {
+        double value(0.0);
+        for (std::size_t k = _row_ptr[i]; k < _row_ptr[i + 1]; k++)
+            value += _weight[k] * _station_data[_station_idx[k]];
+        values[i] = value;
+    }
+}
+}  // namespace FiniteElement
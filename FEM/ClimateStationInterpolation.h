@@ -0,0 +1,71 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class ClimateStationInterpolation
+
+   Inverse distance interpolation of climate station data onto the surface
+   nodes of a mesh (source terms with distribution type CLIMATE).
+*/
+#ifndef CLIMATE_STATION_INTERPOLATION_INC
+#define CLIMATE_STATION_INTERPOLATION_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace GEOLIB
+{
+class PointWithID;
+class Station;
+}
+
+namespace FiniteElement
+{
+/*!
+   \brief Sparse inverse distance weighting operator from the climate
+   stations to the surface nodes.
+
+   Every node is interpolated from its k nearest stations only (horizontal
+   distance, weight 1/d^exponent). The stations are found with a k-d tree
+   and the normalised weights are stored row by row in compressed sparse row
+   format, so memory and time grow with nodes x k instead of nodes x
+   stations. With k equal to the number of stations the result is the same
+   as the former dense interpolation.
+*/
+class ClimateStationInterpolation
+{
+public:
+    /// \param n_nearest number of stations per node; 0 means all stations
+    ClimateStationInterpolation(
+        const std::vector<GEOLIB::PointWithID*>& points,
+        const std::vector<GEOLIB::Station*>& stations,
+        std::size_t n_nearest = 0,
+        double exponent = 2.0);
+
+    std::size_t getNumberOfPoints() const { return _point_ids.size(); }
+    /// Mesh node ID of the i-th surface point
+    std::size_t getPointID(std::size_t i) const { return _point_ids[i]; }
+    /// Interpolates the RECHARGE data of the stations at the given time.
+    /// The station values are looked up once per time.
+    void interpolate(double time, std::vector<double>& values);
+
+private:
+    const std::vector<GEOLIB::Station*>& _stations;
+    std::vector<std::size_t> _point_ids;
+
+    std::vector<std::size_t> _row_ptr;
+    std::vector<std::size_t> _station_idx;
+    std::vector<double> _weight;
+
+    double _station_data_time;
+    std::vector<double> _station_data;
+};
+}  // namespace FiniteElement
+
+#endif
@@ -1136,13 +1136,13 @@ void CDUMUXData::ReadDuMuxData(CRFProcess* m_pcs,
    Return: true or false
    Programming: 08/2010 SB
    Modification:
+   11/2018 node value indices are looked up once outside the node loop
    -------------------------------------------------------------------------*/
 void CDUMUXData::WriteDataToGeoSys(CRFProcess* m_pcs)
 {
     CFEMesh* m_msh = fem_msh_vector[0];  // SB: ToDo hart gesetzt
     MeshLib::CElem* m_ele = NULL;
     CFiniteElementStd* fem;
-    long index;
     double value = 0;
     // double n_vel_x[8], n_vel_y[8], n_vel_z[8];
     Math_Group::vec<long> nod_index(8);
@@ -1156,97 +1156,52 @@ void CDUMUXData::WriteDataToGeoSys(CRFProcess* m_pcs)
 
     fem = m_pcs->fem;
 
+    // indices of the node values, +1... new time level
+    const int index_pressure1 = m_pcs->GetNodeValueIndex("PRESSURE1") + 1;
+    const int index_velocity1[3] = {m_pcs->GetNodeValueIndex("VELOCITY_X1"),
+                                    m_pcs->GetNodeValueIndex("VELOCITY_Y1"),
+                                    m_pcs->GetNodeValueIndex("VELOCITY_Z1")};
+    const int index_density1 = m_pcs->GetNodeValueIndex("DENSITY1");
+    int index_pressure2 = -1, index_saturation1 = -1, index_density2 = -1;
+    int index_velocity2[3] = {-1, -1, -1};
+    if (this->Phases.size() == 2)
+    {
+        index_pressure2 = m_pcs->GetNodeValueIndex("PRESSURE2") + 1;
+        index_saturation1 = m_pcs->GetNodeValueIndex("SATURATION1") + 1;
+        index_velocity2[0] = m_pcs->GetNodeValueIndex("VELOCITY_X2");
+        index_velocity2[1] = m_pcs->GetNodeValueIndex("VELOCITY_Y2");
+        index_velocity2[2] = m_pcs->GetNodeValueIndex("VELOCITY_Z2");
+        index_density2 = m_pcs->GetNodeValueIndex("DENSITY2");
+    }
+
     for (unsigned long i = 0; i < m_msh->nod_vector.size(); i++)
     {
         // TF abbreviation
         PointDuMux const* const pnt_dumux(this->NodeData[i]);
         // pressure of wetting phase
-
-        index =
-            m_pcs->GetNodeValueIndex("PRESSURE1") + 1;  //+1... new time level
-        // TF commented out since we want to use the improved PointDuMux class
-        //		value = this->NodeData[i]->getPhasePressure()[1] -
-        // this->NodeData[i]->getPhasePressure()[0];
         value =
             pnt_dumux->getPhasePressure()[1] - pnt_dumux->getPhasePressure()[0];
-        m_pcs->SetNodeValue(i, index, value);
-        // transfer of velocities to OGS nodes
-        index = m_pcs->GetNodeValueIndex("VELOCITY_X1");  //+1... new time level
-        // TF commented out since we want to use the improved PointDuMux class
-        //		value = this->NodeData[i]->q[0][0];
-        value = pnt_dumux->getQ()[0][0];
-        m_pcs->SetNodeValue(i, index, value);
-        // transfer of velocities to OGS nodes
-        index = m_pcs->GetNodeValueIndex("VELOCITY_Y1");  //+1... new time level
-        // TF commented out since we want to use the improved PointDuMux class
-        //		value = this->NodeData[i]->q[0][1];
-        value = pnt_dumux->getQ()[0][1];
-        m_pcs->SetNodeValue(i, index, value);
+        m_pcs->SetNodeValue(i, index_pressure1, value);
         // transfer of velocities to OGS nodes
-        index = m_pcs->GetNodeValueIndex("VELOCITY_Z1");  //+1... new time level
-        // TF commented out since we want to use the improved PointDuMux class
-        //		value = this->NodeData[i]->q[0][2];
-        value = pnt_dumux->getQ()[0][2];
-        m_pcs->SetNodeValue(i, index, value);
-        index = m_pcs->GetNodeValueIndex("DENSITY1");  //+1... new time level
-        // TF commented out since we want to use the improved PointDuMux class
-        //		value = this->NodeData[i]->phase_density[0];
+        for (int k = 0; k < 3; k++)
+            m_pcs->SetNodeValue(i, index_velocity1[k], pnt_dumux->getQ()[0][k]);
         value = pnt_dumux->getPhaseDensity()[0];
-        m_pcs->SetNodeValue(i, index, value);
+        m_pcs->SetNodeValue(i, index_density1, value);
 
         if (this->Phases.size() == 2)
         {
             // pressure of nonwetting phase
-            index = m_pcs->GetNodeValueIndex("PRESSURE2") +
-                    1;  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->phase_pressure[1];
             value = pnt_dumux->getPhasePressure()[1];
-            m_pcs->SetNodeValue(i, index, value);
+            m_pcs->SetNodeValue(i, index_pressure2, value);
             // saturation of wetting phase
-            index = m_pcs->GetNodeValueIndex("SATURATION1") +
-                    1;  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->phase_saturation[0];
             value = pnt_dumux->getPhaseSaturation()[0];
-            m_pcs->SetNodeValue(i, index, value);
-            // saturation of nonwetting phase
-            // index = m_pcs->GetNodeValueIndex("SATURATION2") + 1; //+1... new
-            // time level value = this->NodeData[i]->phase_saturation[1];
-            // m_pcs->SetNodeValue(i,index,value);
-            // transfer of velocities to OGS nodes
-            index =
-                m_pcs->GetNodeValueIndex("VELOCITY_X2");  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->q[1][0];
-            value = pnt_dumux->getQ()[1][0];
-            m_pcs->SetNodeValue(i, index, value);
-            // transfer of velocities to OGS nodes
-            index =
-                m_pcs->GetNodeValueIndex("VELOCITY_Y2");  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->q[1][1];
-            value = pnt_dumux->getQ()[1][1];
-            m_pcs->SetNodeValue(i, index, value);
+            m_pcs->SetNodeValue(i, index_saturation1, value);
             // transfer of velocities to OGS nodes
-            index =
-                m_pcs->GetNodeValueIndex("VELOCITY_Z2");  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->q[1][2];
-            value = pnt_dumux->getQ()[1][2];
-            m_pcs->SetNodeValue(i, index, value);
-            index =
-                m_pcs->GetNodeValueIndex("DENSITY2");  //+1... new time level
-            // TF commented out since we want to use the improved PointDuMux
-            // class
-            //			value = this->NodeData[i]->phase_density[1];
+            for (int k = 0; k < 3; k++)
+                m_pcs->SetNodeValue(i, index_velocity2[k],
+                                    pnt_dumux->getQ()[1][k]);
             value = pnt_dumux->getPhaseDensity()[1];
-            m_pcs->SetNodeValue(i, index, value);
+            m_pcs->SetNodeValue(i, index_density2, value);
         }
     }
 
@@ -3720,148 +3720,132 @@ bool CECLIPSEData::MakeNodeVector(void)
 }
 
 /*-------------------------------------------------------------------------
-   GeoSys - Function: InterpolateDataFromFacesToNodes
-   Task: Interpolates phase velocity from faces (Eclipse) to nodes
-   Return: true or false
-   Programming: 10/2009 BG / SB
+   GeoSys - Function: BuildFaceToNodeOperator
+   Task: Precomputes the inverse distance weights of the faces (Eclipse) at
+   the nodes of each element for the interpolation of phase velocities.
+   Faces are considered as in InterpolateDataFromFacesToNodes: only the faces
+   of the element, without faces perpendicular to the velocity component and
+   without J (I) faces for radial models in I (J) direction.
+   Return: nothing
+   Programming: 11/2018
    Modification:
    -------------------------------------------------------------------------*/
-void CECLIPSEData::InterpolateDataFromFacesToNodes(long ele_nr, double* n_vel_x,
-                                                   double* n_vel_y,
-                                                   double* n_vel_z,
-                                                   int phase_index)
+void CECLIPSEData::BuildFaceToNodeOperator(void)
 {
     CFEMesh* m_msh = fem_msh_vector[0];  // SB: ToDo hart gesetzt
     MeshLib::CElem* m_ele = NULL;
-    CFaces* m_face = NULL;
     MeshLib::CNode* m_node = NULL;
-    double distance;
-    double weight, weights_xyz[3];
-    // double sum_weights;
-    double val = 0;
-    double coord_v_x[3] = {1.0, 0.0, 0.0};
-    double coord_v_y[3] = {0.0, 1.0, 0.0};
-    double coord_v_z[3] = {0.0, 0.0, 1.0};
-    double data_separated[3];
-    double* normal_vec_face;
+    CFaces* m_face = NULL;
     Math_Group::vec<long> nod_index(8);
-    long nod_ind;
+    double* normal_vec_face;
+    double sum_weights;
     bool choose;
-    int face_flag = 1;  // option: 0...take all faces at one node, 1...take 2
-                        // faces: only the faces which belong to the element
-    // todo eingabeoption
-
-    // cout << " InterpolateDataFromFacesToNodes " << "\n" << "\n";
-
-    /* Go through GeoSys mesh, and get each element (=Eclipse block). For each
-       block, look at all corner points
-       (=Nodes) of the element, as phase velocities are needed there. For each
-       node, look at all faces connected to the node. From each face, get the
-       flow accross the face, and make a weighted sum in the nodes. Faces are
-       not considered, if the are perpendicular to the flow direction, as they
-       then would always contribute zero Faces can be choosen with two options:
-       - All faces at one node, then also information of phase velocities from
-       outside the element considered is taken into account.
-       - Or only faces which are directly connected to the element considered.
-       The resulting phase velocities are stored component wise in the vectors
-       n_vel_xyz and passed back.
-     */
-
-    // Get element for which to calculate velocities
-    m_ele = m_msh->ele_vector[ele_nr];  // get element
-    m_ele->GetNodeIndeces(nod_index);   // get node indexes of nodes on element
-
-    // if ((ele_nr == 646) || (ele_nr == 647) || (ele_nr == 648) || (ele_nr ==
-    // 683) || (ele_nr == 684) || (ele_nr == 685)  || (ele_nr == 720)  ||
-    // (ele_nr == 721)  ||  (ele_nr == 722))
-    //	cout << "Zentrum" << "\n";
-
-    for (long i = 0; i < long(nod_index.Size());
-         i++)  // go through list of connected nodes of the element
-    {          // Get the connected node
-        nod_ind = nod_index[i];
-        m_node =
-            m_msh->nod_vector[nod_ind];  // m_node = Knoten, der gerade
-                                         // behandelt wird--> siehe Koordinaten
-        // cout << " Get Node " << nod_ind << " on element " << ele_nr << "\n";
-        // Set variable to zero, initialization
-        for (long k = 0; k < 3; k++)
-        {
-            data_separated[k] = 0.0;
-            weights_xyz[k] = 0.0;
-        }
-
-        // sum the distance weighted data from each connected face
-        for (unsigned int j = 0; j < m_node->connected_faces.size(); j++)
-        {
-            distance = weight = 0.0;
-            m_face =
-                this->faces[m_node->connected_faces[j]];  // Get face on node
-            // Consider only if face is on element
-            choose = false;
-            if (m_face->connected_elements[0] == ele_nr)
-                choose = true;  // check if face is part of the element
-            if (m_face->connected_elements.size() > 1)
-                if (m_face->connected_elements[1] == ele_nr)
-                    choose = true;
-            if (face_flag == 0)
-                choose = true;
-
-            // for radial flow model
-            if (this->Radial_I == true)
-                // skip all J faces
-                if (m_face->model_axis.find("J") == 0)
-                    choose = false;
-            if (this->Radial_J == true)
-                // skip all I faces
-                if (m_face->model_axis.find("I") == 0)
-                    choose = false;
-
-            if (choose)
+    const long n_elements = long(m_msh->ele_vector.size());
+
+    this->FaceToNodeOperator.clear();
+    this->FaceToNodeRowOffset.resize(n_elements + 1);
+    this->FaceToNodeRowOffset[0] = 0;
+    for (long e = 0; e < n_elements; e++)
+        this->FaceToNodeRowOffset[e + 1] =
+            this->FaceToNodeRowOffset[e] +
+            long(m_msh->ele_vector[e]->GetNodesNumber(false));
+    this->FaceToNodeOperator.row_ptr.reserve(
+        3 * this->FaceToNodeRowOffset[n_elements] + 1);
+    this->FaceToNodeOperator.row_ptr.push_back(0);
+
+    for (long e = 0; e < n_elements; e++)
+    {
+        m_ele = m_msh->ele_vector[e];
+        m_ele->GetNodeIndeces(nod_index);
+        for (long i = 0; i < long(m_ele->GetNodesNumber(false)); i++)
+        {
+            m_node = m_msh->nod_vector[nod_index[i]];
+            for (int k = 0; k < 3; k++)
             {
-                // Testoutput
-                // cout << "\n";
-                // cout << " Node " << nod_ind << " contributed by face " <<
-                // m_face->index << ", " << m_face->model_axis
-                // << "  , " << m_face->phases[phase_index]->q_norm << ": ";
-                // for(int mm=0;mm<3;mm++) cout <<
-                // m_face->phases[phase_index]->q[mm] << ", "; cout << "\n";
-
-                distance = m_node->distance_to_connected_faces[j];
-                // Weight of each face depending on distance
-                weight = (1.0 / distance);
-                // Sum of weights
-                // sum_weights += weight;
-                normal_vec_face = m_face->PlaneEquation->GetNormalVector();
-                // Go through all three coordinates x, y, z and check, if face
-                // is perpendicular to axis
-                for (int k = 0; k < 3; k++)
+                const std::size_t row_begin =
+                    this->FaceToNodeOperator.col.size();
+                sum_weights = 0.0;
+                for (unsigned int j = 0; j < m_node->connected_faces.size();
+                     j++)
                 {
-                    if (k == 0)
-                        val = fabs(PointProduction(normal_vec_face, coord_v_x));
-                    if (k == 1)
-                        val = fabs(PointProduction(normal_vec_face, coord_v_y));
-                    if (k == 2)
-                        val = fabs(PointProduction(normal_vec_face, coord_v_z));
-                    if (val > MKleinsteZahl)  // face not perpendicular to
-                                              // ccordinate axis k
-                    {
-                        data_separated[k] +=
-                            m_face->phases[phase_index]->q[k] * weight;
-                        weights_xyz[k] += weight;
-                    }
+                    m_face = this->faces[m_node->connected_faces[j]];
+                    // Consider only if face is on element
+                    choose = (m_face->connected_elements[0] == e);
+                    if (m_face->connected_elements.size() > 1)
+                        if (m_face->connected_elements[1] == e)
+                            choose = true;
+                    // for radial flow model skip all J (I) faces
+                    if (this->Radial_I == true &&
+                        m_face->model_axis.find("J") == 0)
+                        choose = false;
+                    if (this->Radial_J == true &&
+                        m_face->model_axis.find("I") == 0)
+                        choose = false;
+                    if (!choose)
+                        continue;
+                    // face not perpendicular to coordinate axis k
+                    normal_vec_face = m_face->PlaneEquation->GetNormalVector();
+                    if (fabs(normal_vec_face[k]) <= MKleinsteZahl)
+                        continue;
+
+                    const double weight =
+                        1.0 / m_node->distance_to_connected_faces[j];
+                    this->FaceToNodeOperator.col.push_back(
+                        m_node->connected_faces[j]);
+                    this->FaceToNodeOperator.weight.push_back(weight);
+                    sum_weights += weight;
                 }
-            }  // end if face is on element
-        }      // end loop faces at one node of element considered
+                for (std::size_t l = row_begin;
+                     l < this->FaceToNodeOperator.weight.size();
+                     l++)
+                    this->FaceToNodeOperator.weight[l] /= sum_weights;
+                this->FaceToNodeOperator.row_ptr.push_back(
+                    long(this->FaceToNodeOperator.col.size()));
+            }
+        }
+    }
+}
 
-        // normalize weighted sum by sum_of_weights sum_w
+/*-------------------------------------------------------------------------
+   GeoSys - Function: InterpolateDataFromFacesToNodes
+   Task: Interpolates phase velocity from faces (Eclipse) to nodes
+   Return: true or false
+   Programming: 10/2009 BG / SB
+   Modification:
+   11/2018 weights of the faces are precomputed in BuildFaceToNodeOperator
+   -------------------------------------------------------------------------*/
+void CECLIPSEData::InterpolateDataFromFacesToNodes(long ele_nr, double* n_vel_x,
+                                                   double* n_vel_y,
+                                                   double* n_vel_z,
+                                                   int phase_index)
+{
+    /* Go through all corner points (=Nodes) of the element (=Eclipse block),
+       as phase velocities are needed there. The velocity at each node is the
+       inverse distance weighted mean of the flows across the faces of the
+       element connected to the node. Faces are not considered, if they are
+       perpendicular to the flow direction, as they then would always
+       contribute zero. The resulting phase velocities are stored component
+       wise in the vectors n_vel_xyz and passed back.
+     */
+    if (this->FaceToNodeOperator.empty())
+        this->BuildFaceToNodeOperator();
+
+    const CInterpolationCRS_ECL& op = this->FaceToNodeOperator;
+    double* n_vel[3] = {n_vel_x, n_vel_y, n_vel_z};
+    const long n_nodes = this->FaceToNodeRowOffset[ele_nr + 1] -
+                         this->FaceToNodeRowOffset[ele_nr];
+    for (long i = 0; i < n_nodes; i++)
         for (int k = 0; k < 3; k++)
         {
-            if (weights_xyz[k] > 0.0)
-                data_separated[k] = data_separated[k] / weights_xyz[k];
-            else
+            const long row = (this->FaceToNodeRowOffset[ele_nr] + i) * 3 + k;
+            double value = 0.0;
+            for (long l = op.row_ptr[row]; l < op.row_ptr[row + 1]; l++)
+                value += op.weight[l] *
+                         this->faces[op.col[l]]->phases[phase_index]->q[k];
+            n_vel[k][i] = value;
+
+            if (op.row_ptr[row] == op.row_ptr[row + 1])
             {
-                data_separated[k] = data_separated[k];
                 if ((k == 1) && (this->Radial_I == true))
                 {
                 }  // do nothing, Radial model perpendicular x axis
@@ -3875,249 +3859,198 @@ void CECLIPSEData::InterpolateDataFromFacesToNodes(long ele_nr, double* n_vel_x,
                          << "\n";
             }
         }
-        // transfer Data to node
-        n_vel_x[i] = data_separated[0];
-        n_vel_y[i] = data_separated[1];
-        n_vel_z[i] = data_separated[2];
-
-        // Test output
-        // cout << " Node " << nod_ind << " (X,Y,Z): (" << m_node->X() << ", "
-        // << m_node->Y() << ", "<< m_node->Z() <<
-        // ") " ;
-        // cout << data_separated[0] << " " << data_separated[1] << " " <<
-        // data_separated[2] << " " << "\n";
-    }  // end loop connected nodes
-
-    // Test Output
-    // for(long i=0; i< nod_index.Size();i++){
-    //	cout << " Node "<< nod_index[i] << ":  (X,Y,Z): (" <<
-    // m_msh->nod_vector[nod_index[i]]->X() << ", " <<
-    // m_msh->nod_vector[nod_index[i]]->Y() << ", "<<
-    // m_msh->nod_vector[nod_index[i]]->Z() << "):        " ;
-    //	cout << n_vel_x[i] << " " << n_vel_y[i] << " " << n_vel_z[i] << " " <<
-    //"\n";
-    //}/* */
 }
 
 /*-------------------------------------------------------------------------
-   GeoSys - Function: InterpolateDataFromBlocksToNodes
-   Task: Interpolates data like phase pressure or saturation from blocks
-   (Eclipse) to nodes (GeoSys) Return: true or false Programming: 10/2009 SB
+   GeoSys - Function: BuildBlockToNodeOperator
+   Task: Precomputes the volume weights of the blocks (Eclipse) connected to
+   each node (GeoSys) and the indices of the Eclipse variables of each phase
+   Return: nothing
+   Programming: 11/2018
    Modification:
    -------------------------------------------------------------------------*/
-void CECLIPSEData::InterpolateDataFromBlocksToNodes(CRFProcess* m_pcs,
-                                                    std::string path,
-                                                    int phase_index)
+void CECLIPSEData::BuildBlockToNodeOperator(void)
 {
-    (void)path;  // unused
     clock_t start, finish;
-    double time;
     CFEMesh* m_msh = fem_msh_vector[0];  // SB: ToDo hart gesetzt
-    CECLIPSEBlock* m_block = NULL;
     MeshLib::CNode* m_node = NULL;
-    // CFaces *m_face=NULL;
-    // WW double distance;
-    double volume;
-    double weight;
-    // double weights_xyz[3];
-    double sum_weights, sum_weights_density;
-    // WW double pressure,
-    double saturation, sat, phase_pressure, phase_press, gas_dissolved, gas_dis;
-    double vapor_component_mass_fraction, vap_comp_mass_frac;  // SB redo WTP
-    double den, density;
-    // double press;
-    // double velocity_x1, velo_x1, velocity_y1, velo_y1, velocity_z1, velo_z1;
-    CPointData_ECL* m_NodeData = NULL;
-    // m_NodeData = new CPointData;
-    // WW long variable_index_pressure = -1, variable_index_phase_pressure = -1,
-    // variable_index_saturation = -1, time_index = 0,
-    // variable_index_Gas_dissolved = -1, variable_index_Gas_density = -1,
-    // variable_index_Water_density = -1, variable_index_Oil_density = -1;
-    long variable_index_phase_pressure = -1, variable_index_saturation = -1,
-         variable_index_Gas_dissolved = -1, variable_index_Gas_density = -1,
-         variable_index_Water_density = -1, variable_index_Oil_density = -1,
-         variable_index_vapor_mass_fraction = -1;  // SB redo wtp
-    // long variable_index_velocity_x1, variable_index_velocity_y1,
-    // variable_index_velocity_z1;
+    CECLIPSEBlock* m_block = NULL;
+    double sum_weights;
 
     start = clock();
+    cout << "        BuildBlockToNodeOperator()";
 
-    cout << "        InterpolateDataFromBlocksToNodes()";
-
-    // WW variable_index_pressure = this->GetVariableIndex("PRESSURE");
-
-    // get saturation index if there are more than 1 phases
-    if (this->Phases[phase_index] == "WATER")
+    // indices of the variables of each phase
+    this->PhaseVariableIndex.resize(this->Phases.size());
+    for (std::size_t p = 0; p < this->Phases.size(); p++)
     {
-        if (int(this->Phases.size()) > 1)
-            variable_index_saturation = this->GetVariableIndex("SWAT");
-        variable_index_phase_pressure = this->GetVariableIndex("PWAT");
-        if (this->E100 == true)
-            variable_index_Water_density = this->GetVariableIndex("WAT_DEN");
-        else
-            variable_index_Water_density = this->GetVariableIndex("DENW");
-    }
-    else
-    {
-        if (this->Phases[phase_index] == "OIL")
+        CPhaseVariableIndex_ECL& var = this->PhaseVariableIndex[p];
+        var.phase_pressure = var.saturation = var.density = -1;
+        var.gas_dissolved = var.vapor_mass_fraction = -1;
+        // get saturation index if there are more than 1 phases
+        if (this->Phases[p] == "WATER")
         {
             if (int(this->Phases.size()) > 1)
-                variable_index_saturation = this->GetVariableIndex("SOIL");
-            variable_index_phase_pressure = this->GetVariableIndex("POIL");
+                var.saturation = this->GetVariableIndex("SWAT");
+            var.phase_pressure = this->GetVariableIndex("PWAT");
             if (this->E100 == true)
-                variable_index_Oil_density = this->GetVariableIndex("OIL_DEN");
+                var.density = this->GetVariableIndex("WAT_DEN");
             else
-                variable_index_Oil_density = this->GetVariableIndex("DENO");
+                var.density = this->GetVariableIndex("DENW");
         }
-        else
+        else if (this->Phases[p] == "OIL")
         {
-            if (this->Phases[phase_index] == "GAS")
-            {
-                if (int(this->Phases.size()) > 1)
-                    variable_index_saturation = this->GetVariableIndex("SGAS");
-                variable_index_phase_pressure = this->GetVariableIndex("PGAS");
-                if (this->GetVariableIndex("RS") >= 0)
-                {
-                    variable_index_Gas_dissolved = this->GetVariableIndex("RS");
-                    if (this->E100 == true)
-                        variable_index_Gas_density =
-                            this->GetVariableIndex("GAS_DEN");
-                    else
-                        variable_index_Gas_density =
-                            this->GetVariableIndex("DENG");
-                }
-                // KB Vapor component mass fraction, redo wtp
-                if (int(this->GetVariableIndex("YFW2")) >= 0)
-                {
-                    variable_index_vapor_mass_fraction =
-                        this->GetVariableIndex("YFW2");
-                }
-            }
+            if (int(this->Phases.size()) > 1)
+                var.saturation = this->GetVariableIndex("SOIL");
+            var.phase_pressure = this->GetVariableIndex("POIL");
+            if (this->E100 == true)
+                var.density = this->GetVariableIndex("OIL_DEN");
             else
+                var.density = this->GetVariableIndex("DENO");
+        }
+        else if (this->Phases[p] == "GAS")
+        {
+            if (int(this->Phases.size()) > 1)
+                var.saturation = this->GetVariableIndex("SGAS");
+            var.phase_pressure = this->GetVariableIndex("PGAS");
+            if (this->GetVariableIndex("RS") >= 0)
             {
-                cout << "This phase is not considered yet!"
-                     << "\n";
-                // system("Pause");
-                exit(0);
+                var.gas_dissolved = this->GetVariableIndex("RS");
+                if (this->E100 == true)
+                    var.density = this->GetVariableIndex("GAS_DEN");
+                else
+                    var.density = this->GetVariableIndex("DENG");
             }
+            // KB Vapor component mass fraction, redo wtp
+            var.vapor_mass_fraction = this->GetVariableIndex("YFW2");
+        }
+        else
+        {
+            cout << "This phase is not considered yet!"
+                 << "\n";
+            exit(0);
         }
     }
 
-    // WW time_index = 0;
-
-    for (unsigned long i = 0; i < m_msh->nod_vector.size(); i++)
+    // weights of the blocks connected to each node
+    CInterpolationCRS_ECL& op = this->BlockToNodeOperator;
+    op.clear();
+    op.row_ptr.reserve(m_msh->nod_vector.size() + 1);
+    op.row_ptr.push_back(0);
+    for (std::size_t i = 0; i < m_msh->nod_vector.size(); i++)
     {
-        // Get the node
         m_node = m_msh->nod_vector[i];
-        // WW	pressure = 0.0;
-        phase_pressure = 0.0;
-        saturation = 0.0;
+        const std::size_t row_begin = op.col.size();
         sum_weights = 0.0;
-        gas_dissolved = 0.0;
-        density = 0.0;
-        sum_weights_density = 0.0;
-        vapor_component_mass_fraction = 0.0;  // SB redo wtp
-
-        // sum the distance weighted data from each connected block
-        for (unsigned int j = 0; j < m_node->getConnectedElementIDs().size();
+        for (std::size_t j = 0; j < m_node->getConnectedElementIDs().size();
              j++)
         {
-            // WW distance = 0.0;
-            weight = 0.0;
             m_block = this->eclgrid[m_node->getConnectedElementIDs()[j]];
+            // representive volume of the considered node in each connected
+            // element for weighting
+            // ToDo volume weighting doesn't work if element is not simple! BG
+            const double weight = 1.0 / (m_block->volume / 8.0);
+            op.col.push_back(m_block->index);
+            op.weight.push_back(weight);
+            sum_weights += weight;
+        }
+        for (std::size_t l = row_begin; l < op.weight.size(); l++)
+            op.weight[l] /= sum_weights;
+        op.row_ptr.push_back(long(op.col.size()));
+    }
 
-            // calculate representive volume of the considered node in each
-            // connected element for weighting
-            volume =
-                m_block->volume / 8.0;  // ToDo volume weighting doesn't work if
-                                        // element is not simple!!!!!!!!! BG
-            weight = (1.0 / volume);
+    finish = clock();
+    cout << "    Time: " << (double(finish) - double(start)) / CLOCKS_PER_SEC
+         << " seconds."
+         << "\n";
+}
 
-            // Sum of weights
-            sum_weights += weight;
-            // Pressure
-            // press = this->Data[m_block->index][variable_index_pressure];
-            // pressure += press * weight;
-            // Phase pressure
-            phase_press =
-                this->Data[m_block->index][variable_index_phase_pressure];
-            phase_pressure += phase_press * weight;
-
-            // saturation
-            if (int(this->Phases.size()) > 1)
-            {
-                sat = this->Data[m_block->index][variable_index_saturation];
-                saturation += sat * weight;
-            }
+namespace
+{
+/// result[i] = sum_k weight[k] * Data[col[k]][variable] for all rows i
+void InterpolateVariable(CInterpolationCRS_ECL const& op, double** Data,
+                         long variable, std::vector<double>& result)
+{
+    const long n_rows = op.rows();
+    result.resize(n_rows);
+    for (long i = 0; i < n_rows; i++)
+    {
+        double value = 0.0;
+        for (long l = op.row_ptr[i]; l < op.row_ptr[i + 1]; l++)
+            value += op.weight[l] * Data[op.col[l]][variable];
+        result[i] = value;
+    }
+}
 
-            // dissolved gas
-            if (variable_index_Gas_dissolved > -1)
-            {
-                gas_dis =
-                    this->Data[m_block->index][variable_index_Gas_dissolved];
-                gas_dissolved += gas_dis * weight;
-                den = this->Data[m_block->index][variable_index_Gas_density];
-                if (den > 0)
-                {
-                    density += den * weight;
-                    sum_weights_density += weight;
-                }
-            }
-            // KB total molare density , redo wtp
-            if (variable_index_vapor_mass_fraction > -1)
+/// As InterpolateVariable, but only positive block values contribute and the
+/// weights are renormalized; rows without positive values are zero.
+void InterpolatePositiveVariable(CInterpolationCRS_ECL const& op,
+                                 double** Data, long variable,
+                                 std::vector<double>& result)
+{
+    const long n_rows = op.rows();
+    result.resize(n_rows);
+    for (long i = 0; i < n_rows; i++)
+    {
+        double value = 0.0, sum_weights = 0.0;
+        for (long l = op.row_ptr[i]; l < op.row_ptr[i + 1]; l++)
+        {
+            const double v = Data[op.col[l]][variable];
+            if (v > 0)
             {
-                vap_comp_mass_frac =
-                    this->Data[m_block->index]
-                              [variable_index_vapor_mass_fraction];
-                vapor_component_mass_fraction += vap_comp_mass_frac * weight;
+                value += op.weight[l] * v;
+                sum_weights += op.weight[l];
             }
+        }
+        result[i] = (sum_weights > 0) ? value / sum_weights : 0.0;
+    }
+}
+}  // namespace
 
-            if (variable_index_Water_density > -1)
-            {
-                den = this->Data[m_block->index][variable_index_Water_density];
-                if (den > 0)
-                {
-                    density += den * weight;
-                    sum_weights_density += weight;
-                }
-            }
-            if (variable_index_Oil_density > -1)
-            {
-                den = this->Data[m_block->index][variable_index_Oil_density];
-                if (den > 0)
-                {
-                    density += den * weight;
-                    sum_weights_density += weight;
-                }
-            }
+/*-------------------------------------------------------------------------
+   GeoSys - Function: InterpolateDataFromBlocksToNodes
+   Task: Interpolates data like phase pressure or saturation from blocks
+   (Eclipse) to nodes (GeoSys) Return: true or false Programming: 10/2009 SB
+   Modification:
+   11/2018 volume weights and variable indices are precomputed in
+   BuildBlockToNodeOperator, each variable is interpolated by one product
+   with the sparse operator
+   -------------------------------------------------------------------------*/
+void CECLIPSEData::InterpolateDataFromBlocksToNodes(CRFProcess* m_pcs,
+                                                    std::string path,
+                                                    int phase_index)
+{
+    (void)path;   // unused
+    (void)m_pcs;  // unused
+    clock_t start, finish;
+    double time;
+    std::vector<double> values;
 
-            // Test output
-            // if ((m_block->z_barycentre == -2001.8)) {
-            //	//cout << " Node " << i << "\n";
-            //	//cout << " :  connected block: " <<
-            // m_node->connected_elements[j] << " (X,Y,Z): " <<
-            // m_block->x_barycentre << ", " << m_block->y_barycentre << ", " <<
-            // m_block->z_barycentre << " with saturation " << sat;
-            //	//cout << "  distance: " << distance <<  " weight: " << weight
-            //<< " sum of weights: " << sum_weights <<
-            //"\n";
-            //	cout <<  "      Node " << i << " Element: " <<
-            // m_node->connected_elements[j] << " SGAS: " << sat <<
-            //"\n";
-            //}
-        }  // for j=connected_elements
+    if (this->BlockToNodeOperator.empty())
+        this->BuildBlockToNodeOperator();
 
-        // pressure = pressure / sum_weights;
-        // this->NodeData[i]->pressure = pressure;
+    start = clock();
 
-        phase_pressure = phase_pressure / sum_weights;
-        this->NodeData[i]->phase_pressure[phase_index] = phase_pressure;
-        this->NodeData[i]->pressure =
-            phase_pressure;  // the last phase pressure is the highest pressure
+    cout << "        InterpolateDataFromBlocksToNodes()";
 
-        if (int(this->Phases.size()) > 1)
+    CInterpolationCRS_ECL const& op = this->BlockToNodeOperator;
+    CPhaseVariableIndex_ECL const& var = this->PhaseVariableIndex[phase_index];
+    const long n_nodes = op.rows();
+
+    // phase pressure, the last phase pressure is the highest pressure
+    InterpolateVariable(op, this->Data, var.phase_pressure, values);
+    for (long i = 0; i < n_nodes; i++)
+    {
+        this->NodeData[i]->phase_pressure[phase_index] = values[i];
+        this->NodeData[i]->pressure = values[i];
+    }
+
+    if (int(this->Phases.size()) > 1)
+    {
+        InterpolateVariable(op, this->Data, var.saturation, values);
+        for (long i = 0; i < n_nodes; i++)
         {
-            saturation = saturation / sum_weights;
+            const double saturation = values[i];
             if ((saturation >= 0.0) && (saturation <= 1.0))
                 this->NodeData[i]->phase_saturation[phase_index] = saturation;
             else
@@ -4130,206 +4063,31 @@ void CECLIPSEData::InterpolateDataFromBlocksToNodes(CRFProcess* m_pcs,
                     this->NodeData[i]->phase_saturation[phase_index] = 1.0;
             }
         }
-        // density
-        if (sum_weights_density > 0)
-            density = density / sum_weights_density;
-        this->NodeData[i]->phase_density[phase_index] = density;
-
-        // dissolved gas in oil (black oil mode)
-        if (variable_index_Gas_dissolved > -1)
-        {
-            gas_dissolved = gas_dissolved / sum_weights;
-            this->NodeData[i]->CO2inLiquid = gas_dissolved;
-        }
+    }
 
-        // KB total molare density, redo wtp
-        if (variable_index_vapor_mass_fraction > -1)
-        {
-            vapor_component_mass_fraction =
-                vapor_component_mass_fraction / sum_weights;
-            this->NodeData[i]->VaporComponentMassFraction =
-                vapor_component_mass_fraction;
-        }
+    // density, only blocks with a positive density contribute
+    if (var.density > -1)
+        InterpolatePositiveVariable(op, this->Data, var.density, values);
+    else
+        values.assign(n_nodes, 0.0);
+    for (long i = 0; i < n_nodes; i++)
+        this->NodeData[i]->phase_density[phase_index] = values[i];
 
-        // Test output
-        // if ((m_block->z_barycentre == -2001.8)) {
-        //	//cout << " Node " << i << " (X,Y,Z): (" << m_node->X() << ", " <<
-        // m_node->Y() << ", "<< m_node->X() << ")
-        //";
-        //	//cout << " Pressure at Node " << this->NodeData[i]->pressure <<
-        //"\n";
-        //	//cout << " Node " << i << " (X,Y,Z): (" << m_node->X() << ", " <<
-        // m_node->Y() << ", "<< m_node->X() << ")
-        //";
-        //	//cout << " Saturation at Node " <<
-        // this->NodeData[i]->phase_saturation[phase_index] << "\n"; 	cout <<
-        // " Node " << i << " SGAS: " <<
-        // this->NodeData[i]->phase_saturation[phase_index] << "\n";
-        //}
+    // dissolved gas in oil (black oil mode)
+    if (var.gas_dissolved > -1)
+    {
+        InterpolateVariable(op, this->Data, var.gas_dissolved, values);
+        for (long i = 0; i < n_nodes; i++)
+            this->NodeData[i]->CO2inLiquid = values[i];
     }
 
-    // Test Output Nodes
-    // if ((m_pcs->Tim->step_current==0) || (m_pcs->Tim->step_current==1) ||
-    // (m_pcs->Tim->step_current==2) || (m_pcs->Tim->step_current==5) ||
-    // (m_pcs->Tim->step_current==10) || (m_pcs->Tim->step_current==20) ||
-    // (m_pcs->Tim->step_current==30) || (m_pcs->Tim->step_current==40) ||
-    // (m_pcs->Tim->step_current==50) || (m_pcs->Tim->step_current==100) ||
-    // (m_pcs->Tim->step_current==999) || (m_pcs->Tim->step_current==1000)) {
-    vector<string> vec_string;
-    std::string tempstring;
-    ostringstream temp;
-    double Val;
-    if (this->Phases.size() == 1)
+    // KB total molare density, redo wtp
+    if (var.vapor_mass_fraction > -1)
     {
-        int nidx1 =
-            m_pcs->GetNodeValueIndex("PRESSURE1") + 1;  //+1... new time level
-        vec_string.push_back("Node; X; Y; Z; P-Geosys; P-Eclipse");
-        for (unsigned long i = 0; i < this->NodeData.size(); i++)
-        {
-            m_NodeData = this->NodeData[i];
-            // Get the Pressure from the Geosys run
-            Val = m_pcs->GetNodeValue(i, nidx1);
-            // cout << " NodeData[" << i << "]:  (X,Y,Z): (" << m_NodeData->x <<
-            // ", " << m_NodeData->y << ", " << m_NodeData->z << "):        " ;
-            // cout << ", Geosys-P: " << Val << ", Eclipse: " <<
-            // this->NodeData[i]->pressure << "\n";;
-            temp.str("");
-            temp.clear();
-            temp << i;
-            tempstring = temp.str();
-            temp.str("");
-            temp.clear();
-            temp << m_NodeData->x;
-            tempstring += "; " + temp.str();
-            temp.str("");
-            temp.clear();
-            temp << m_NodeData->y;
-            tempstring += "; " + temp.str();
-            temp.str("");
-            temp.clear();
-            temp << m_NodeData->z;
-            tempstring += "; " + temp.str();
-            temp.str("");
-            temp.clear();
-            temp.precision(12);
-            temp << Val;
-            tempstring += "; " + temp.str();
-            temp.str("");
-            temp.clear();
-            temp.precision(12);
-            temp << this->NodeData[i]->pressure;
-            tempstring += "; " + temp.str();
-            vec_string.push_back(tempstring);
-        }
+        InterpolateVariable(op, this->Data, var.vapor_mass_fraction, values);
+        for (long i = 0; i < n_nodes; i++)
+            this->NodeData[i]->VaporComponentMassFraction = values[i];
     }
-    if (this->Phases.size() > 1)
-        if (phase_index > 0)
-        {
-            int nidx1 = m_pcs->GetNodeValueIndex("PRESSURE1") +
-                        1;  //+1... new time level
-            int nidx2 = m_pcs->GetNodeValueIndex("PRESSURE2") + 1;
-            int nidx3 = m_pcs->GetNodeValueIndex("SATURATION1") + 1;
-            // vec_string.push_back("Node; X; Y; Z; P-Geosys_phase1;
-            // P-Geosys_phase2; Saturation_Geosys_phase1; P-Eclipse_phase1;
-            // P-Eclipse_phase2; Saturation_Eclipse_phase1");
-            vec_string.push_back(
-                "Node; X; Y; Z; P-Geosys_phase1; P-Geosys_phase2; "
-                "Saturation_Geosys_phase1; P-Eclipse_phase1; "
-                "P-Eclipse_phase2; Saturation_Eclipse_phase1; q_x1; q_y1; "
-                "q_z1; q_x2; q_y2; q_z2");
-            for (unsigned long i = 0; i < this->NodeData.size(); i++)
-            {
-                m_NodeData = this->NodeData[i];
-                // cout << " NodeData[" << i << "]:  (X,Y,Z): (" <<
-                // m_NodeData->x << ", " << m_NodeData->y << ", " <<
-                // m_NodeData->z << "):        " ;
-                // cout << ", Geosys-P: " << Val << ", Eclipse: " <<
-                // this->NodeData[i]->pressure << "\n";;
-                temp.str("");
-                temp.clear();
-                temp << i;
-                tempstring = temp.str();
-                temp.str("");
-                temp.clear();
-                temp << m_NodeData->x;
-                tempstring += "; " + temp.str();
-                temp.str("");
-                temp.clear();
-                temp << m_NodeData->y;
-                tempstring += "; " + temp.str();
-                temp.str("");
-                temp.clear();
-                temp << m_NodeData->z;
-                tempstring += "; " + temp.str();
-
-                // Get the Pressure1 from the Geosys run
-                Val = m_pcs->GetNodeValue(i, nidx1);
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << Val;
-                tempstring += "; " + temp.str();
-                // Get the Pressure2 from the Geosys run
-                Val = m_pcs->GetNodeValue(i, nidx2);
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << Val;
-                tempstring += "; " + temp.str();
-                // Get the Saturation1 from the Geosys run
-                Val = m_pcs->GetNodeValue(i, nidx3);
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << Val;
-                tempstring += "; " + temp.str();
-
-                // Eclipse data
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << this->NodeData[i]->phase_pressure[0];
-                tempstring += "; " + temp.str();
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << this->NodeData[i]->phase_pressure[1];
-                tempstring += "; " + temp.str();
-                temp.str("");
-                temp.clear();
-                temp.precision(12);
-                temp << this->NodeData[i]->phase_saturation[0];
-                tempstring += "; " + temp.str();
-
-                ////Velocities
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[0][0]; tempstring += "; " + temp.str();
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[0][1]; tempstring += "; " + temp.str();
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[0][2]; tempstring += "; " + temp.str();
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[1][0]; tempstring += "; " + temp.str();
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[1][1]; tempstring += "; " + temp.str();
-                // temp.str(""); temp.clear(); temp.precision(12); temp <<
-                // this->NodeData[i]->q[1][2]; tempstring += "; " + temp.str();
-
-                vec_string.push_back(tempstring);
-            }
-        }
-
-    // CWriteTextfiles *TextFile;
-    // TextFile = new CWriteTextfiles;
-    // int position = int(path.find_last_of("\\"));
-    // std::string path_new;
-    // path_new = path.substr(0,position);
-    // position = int(path_new.find_last_of("\\"));
-    // path_new = path_new.substr(0,position);
-    // temp.str(""); temp.clear(); temp << m_pcs->Tim->step_current; tempstring
-    // = temp.str(); TextFile->Write_Text(path_new + "\\CheckNodeValues_" +
-    // tempstring + ".csv", vec_string);
-    //} // End Test Output
 
     finish = clock();
     time = (double(finish) - double(start)) / CLOCKS_PER_SEC;
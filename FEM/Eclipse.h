@@ -136,6 +136,37 @@ public:
     ~CPointData_ECL() {}
 };
 
+/* Sparse interpolation operator in compressed row storage. Row i holds the
+   columns col[row_ptr[i]] ... col[row_ptr[i+1]-1] with weights normalized to a
+   sum of one, so that the interpolated value is sum_k weight[k] * v[col[k]].
+   The operators depend only on the geometry and are built once.
+   11/2018 */
+struct CInterpolationCRS_ECL
+{
+    std::vector<long> row_ptr;
+    std::vector<long> col;
+    std::vector<double> weight;
+
+    bool empty() const { return row_ptr.empty(); }
+    long rows() const { return long(row_ptr.size()) - 1; }
+    void clear()
+    {
+        row_ptr.clear();
+        col.clear();
+        weight.clear();
+    }
+};
+
+// Indices of the ECLIPSE output variables of one phase (-1: not available)
+struct CPhaseVariableIndex_ECL
+{
+    long phase_pressure;
+    long saturation;
+    long density;
+    long gas_dissolved;
+    long vapor_mass_fraction;
+};
+
 class CBoundaryConditions
 {
 public:
@@ -213,6 +244,13 @@ public:
     long a[8][2];  // 2D Array um Keywords abzuspeichern
     std::vector<bool> eclipse_ele_active_flag;  // CB
     bool PoroPermIncludeFile;
+    // node values from block values, rows are the mesh nodes
+    CInterpolationCRS_ECL BlockToNodeOperator;
+    // node velocities from face flows, row (FaceToNodeRowOffset[ele] + i) * 3
+    // + k is the component k at local node i of element ele
+    CInterpolationCRS_ECL FaceToNodeOperator;
+    std::vector<long> FaceToNodeRowOffset;
+    std::vector<CPhaseVariableIndex_ECL> PhaseVariableIndex;
     CECLIPSEData();
     ~CECLIPSEData();
 
@@ -276,6 +314,10 @@ public:
 
     bool CalcBlockBudget(int phase_index);
 
+    void BuildBlockToNodeOperator(void);
+
+    void BuildFaceToNodeOperator(void);
+
     void InterpolateDataFromFacesToNodes(long ele_nr, double* n_vel_x,
                                          double* n_vel_y, double* n_vel_z,
                                          int phase_index);
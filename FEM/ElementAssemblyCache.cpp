@@ -0,0 +1,99 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class ElementAssemblyCache
+*/
+#include "ElementAssemblyCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace FiniteElement
+{
+ElementAssemblyCache::ElementAssemblyCache(const double tolerance)
+    : _tolerance(tolerance),
+      _dt(0.0),
+      _epoch(1),
+      _n_assembled(0),
+      _n_reused(0)
+{
+}
+
+void ElementAssemblyCache::setInputs(
+    std::vector<double const*> const& node_values, const double dt)
+{
+    if (dt == _dt && node_values == _node_values)
+        return;
+    // Start over, all stored contributions become invalid. The blocks only
+    // keep their size if the number of node value arrays is the same.
+    if (node_values.size() != _node_values.size())
+    {
+        _elements.clear();
+        _data.clear();
+    }
+    _dt = dt;
+    _node_values = node_values;
+    _epoch++;
+}
+
+bool ElementAssemblyCache::isValid(const std::size_t element_id,
+                                   long const* const nodes,
+                                   const std::size_t n_nodes) const
+{
+    if (element_id >= _elements.size())
+        return false;
+    Entry const& entry = _elements[element_id];
+    if (entry.epoch != _epoch || entry.n_nodes != n_nodes)
+        return false;
+    double const* ref = &_data[entry.offset];
+    for (std::size_t k = 0; k < _node_values.size(); k++)
+    {
+        double const* const val = _node_values[k];
+        for (std::size_t i = 0; i < n_nodes; i++, ref++)
+        {
+            if (std::fabs(val[nodes[i]] - *ref) >
+                _tolerance * std::max(std::fabs(*ref), 1.0))
+                return false;
+        }
+    }
+    return true;
+}
+
+void ElementAssemblyCache::store(const std::size_t element_id,
+                                 long const* const nodes,
+                                 const std::size_t n_nodes,
+                                 const std::size_t n_entries,
+                                 double const* const a, double const* const b)
+{
+    if (element_id >= _elements.size())
+        _elements.resize(element_id + 1);
+    Entry& entry = _elements[element_id];
+    const std::size_t n_values = n_nodes * _node_values.size();
+    const std::size_t block_size = n_values + n_entries * n_entries + n_entries;
+    if (entry.epoch == 0 || entry.n_nodes != n_nodes ||
+        entry.n_entries != n_entries)
+    {
+        // first contribution of the element
+        entry.offset = _data.size();
+        _data.resize(_data.size() + block_size);
+        entry.n_nodes = static_cast<unsigned short>(n_nodes);
+        entry.n_entries = static_cast<unsigned short>(n_entries);
+    }
+    entry.epoch = _epoch;
+    double* const block = &_data[entry.offset];
+    for (std::size_t k = 0; k < _node_values.size(); k++)
+    {
+        for (std::size_t i = 0; i < n_nodes; i++)
+            block[k * n_nodes + i] = _node_values[k][nodes[i]];
+    }
+    std::copy(a, a + n_entries * n_entries, block + n_values);
+    std::copy(b, b + n_entries, block + n_values + n_entries * n_entries);
+}
+}  // namespace FiniteElement
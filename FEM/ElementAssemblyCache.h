@@ -0,0 +1,105 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class ElementAssemblyCache
+
+   Element contributions to the global system of equations, which are reused
+   as long as the nodal values of the element do not change.
+*/
+#ifndef ELEMENT_ASSEMBLY_CACHE_INC
+#define ELEMENT_ASSEMBLY_CACHE_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace FiniteElement
+{
+/*!
+   \brief Cache of the element contributions to the global matrix and RHS.
+
+   With a contribution, the values of the element nodes in the node value
+   arrays the contribution depends on are stored. The contribution is valid
+   as long as none of these values moved away from the stored one by more
+   than tolerance * max(|stored value|, 1) and the time step size and the
+   node value arrays are unchanged. Only the nodes of the element in
+   question are compared.
+
+   All contributions are kept in one buffer. The block of an element holds
+   the node values, the matrix and the RHS one after another and is found by
+   its offset; it is allocated when the element is stored first and reused
+   afterwards.
+*/
+class ElementAssemblyCache
+{
+public:
+    explicit ElementAssemblyCache(const double tolerance);
+
+    /// Set the node value arrays, indexed by the node ID, and the time step
+    /// size of the next assembly. A change of either invalidates all stored
+    /// contributions.
+    void setInputs(std::vector<double const*> const& node_values,
+                   const double dt);
+
+    /// Check if the contribution of the element can be reused.
+    bool isValid(const std::size_t element_id, long const* const nodes,
+                 const std::size_t n_nodes) const;
+
+    /// Store the contribution of an element: the n_entries x n_entries
+    /// matrix a (row major) and the vector b.
+    void store(const std::size_t element_id, long const* const nodes,
+               const std::size_t n_nodes, const std::size_t n_entries,
+               double const* const a, double const* const b);
+
+    double const* getMatrix(const std::size_t element_id) const
+    {
+        Entry const& entry = _elements[element_id];
+        return &_data[entry.offset + entry.n_nodes * _node_values.size()];
+    }
+    double const* getRHS(const std::size_t element_id) const
+    {
+        Entry const& entry = _elements[element_id];
+        return getMatrix(element_id) + entry.n_entries * entry.n_entries;
+    }
+
+    /// Counters of the elements assembled and reused since the last reset.
+    void resetCounters()
+    {
+        _n_assembled = 0;
+        _n_reused = 0;
+    }
+    void countAssembled() { _n_assembled++; }
+    void countReused() { _n_reused++; }
+    std::size_t getNumberOfAssembled() const { return _n_assembled; }
+    std::size_t getNumberOfReused() const { return _n_reused; }
+
+private:
+    struct Entry
+    {
+        Entry() : offset(0), epoch(0), n_nodes(0), n_entries(0) {}
+        /// Begin of the block of the element in _data
+        std::size_t offset;
+        unsigned epoch;
+        unsigned short n_nodes;
+        unsigned short n_entries;
+    };
+
+    const double _tolerance;
+    double _dt;
+    /// Incremented to invalidate all elements.
+    unsigned _epoch;
+    std::vector<double const*> _node_values;
+    std::vector<Entry> _elements;
+    std::vector<double> _data;
+
+    std::size_t _n_assembled;
+    std::size_t _n_reused;
+};
+}  // namespace FiniteElement
+#endif
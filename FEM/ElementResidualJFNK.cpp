@@ -0,0 +1,34 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class ElementResidualJFNK
+*/
+#include "ElementResidualJFNK.h"
+
+namespace FiniteElement
+{
+void ElementResidualJFNK::reset(const std::size_t n_elements)
+{
+    _begin.assign(n_elements, 0);
+    _end.assign(n_elements, 0);
+    _rows.clear();
+    _values.clear();
+}
+
+void ElementResidualJFNK::store(const std::size_t element_id,
+                                long const* const rows,
+                                double const* const b_e, const std::size_t n)
+{
+    _begin[element_id] = _rows.size();
+    _rows.insert(_rows.end(), rows, rows + n);
+    _values.insert(_values.end(), b_e, b_e + n);
+    _end[element_id] = _rows.size();
+}
+}  // namespace FiniteElement
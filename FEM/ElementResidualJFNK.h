@@ -0,0 +1,56 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class ElementResidualJFNK
+
+   Element residuals of the unperturbed solution for the Jacobian free
+   Newton-Krylov (JFNK) method.
+*/
+#ifndef ELEMENT_RESIDUAL_JFNK_INC
+#define ELEMENT_RESIDUAL_JFNK_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace FiniteElement
+{
+/*!
+   \brief Contributions of the elements to the global residual vector F(u).
+
+   The contribution of an element consists of the entries of the global RHS
+   in the rows of the element nodes. The entries of all elements are stored
+   consecutively; an element without entries has an empty range.
+*/
+class ElementResidualJFNK
+{
+public:
+    /// Removes all entries and prepares the storage for n_elements elements.
+    void reset(const std::size_t n_elements);
+
+    /// Stores the contribution of the element, b_e[i] is the entry of the
+    /// global row rows[i].
+    void store(const std::size_t element_id, long const* const rows,
+               double const* const b_e, const std::size_t n);
+
+    /// Subtracts the stored contribution of the element from b.
+    void subtract(const std::size_t element_id, double* const b) const
+    {
+        for (std::size_t k = _begin[element_id]; k < _end[element_id]; k++)
+            b[_rows[k]] -= _values[k];
+    }
+
+private:
+    std::vector<std::size_t> _begin;
+    std::vector<std::size_t> _end;
+    std::vector<long> _rows;
+    std::vector<double> _values;
+};
+}  // namespace FiniteElement
+#endif
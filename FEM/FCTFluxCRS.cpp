@@ -0,0 +1,82 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class FCTFluxCRS
+*/
+#include "FCTFluxCRS.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "msh_mesh.h"
+
+namespace FiniteElement
+{
+FCTFluxCRS::FCTFluxCRS(MeshLib::CFEMesh const& mesh)
+{
+    const std::size_t n_rows(mesh.nod_vector.size());
+    std::vector<std::vector<std::size_t> > rows(n_rows);
+    for (std::size_t e = 0; e < mesh.ele_vector.size(); e++)
+    {
+        MeshLib::CElem const* const elem(mesh.ele_vector[e]);
+        const std::size_t nnodes(elem->GetNodesNumber(false));
+        for (std::size_t i = 0; i < nnodes; i++)
+        {
+            std::vector<std::size_t>& row(rows[elem->GetNodeIndex(i)]);
+            for (std::size_t j = 0; j < nnodes; j++)
+                row.push_back(elem->GetNodeIndex(j));
+        }
+    }
+
+    _row_ptr.resize(n_rows + 1);
+    _row_ptr[0] = 0;
+    for (std::size_t i = 0; i < n_rows; i++)
+    {
+        std::vector<std::size_t>& row(rows[i]);
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        _col_idx.insert(_col_idx.end(), row.begin(), row.end());
+        _row_ptr[i + 1] = _col_idx.size();
+        std::vector<std::size_t>().swap(row);
+    }
+
+    const std::size_t n_entries(_col_idx.size());
+    _transposed.resize(n_entries);
+    for (std::size_t i = 0; i < n_rows; i++)
+        for (std::size_t k = _row_ptr[i]; k < _row_ptr[i + 1]; k++)
+            _transposed[k] = find(_col_idx[k], i);
+    _active.assign(n_entries, 0);
+    _flux.assign(n_entries, 0.0);
+}
+
+std::size_t FCTFluxCRS::find(const std::size_t i, const std::size_t j) const
+{
+    std::vector<std::size_t>::const_iterator const first(_col_idx.begin() +
+                                                         _row_ptr[i]);
+    std::vector<std::size_t>::const_iterator const last(_col_idx.begin() +
+                                                        _row_ptr[i + 1]);
+    std::vector<std::size_t>::const_iterator const it(
+        std::lower_bound(first, last, j));
+    assert(it != last && *it == j);
+    return it - _col_idx.begin();
+}
+
+void FCTFluxCRS::add(const std::size_t i, const std::size_t j, const double v)
+{
+    const std::size_t k(find(i, j));
+    _active[k] = 1;
+    _flux[k] += v;
+}
+
+void FCTFluxCRS::setZero()
+{
+    std::fill(_flux.begin(), _flux.end(), 0.0);
+}
+}  // namespace FiniteElement
@@ -0,0 +1,74 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class FCTFluxCRS
+
+   Antidiffusive fluxes of the flux corrected transport (FCT), stored along
+   the sparsity pattern of the global matrix.
+*/
+#ifndef FCT_FLUX_CRS_INC
+#define FCT_FLUX_CRS_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshLib
+{
+class CFEMesh;
+}
+
+namespace FiniteElement
+{
+/*!
+   \brief Nodal matrix of the antidiffusive fluxes in compressed row storage.
+
+   The pattern consists of all pairs of element nodes including the diagonal,
+   the entries of a row are sorted by their column. An entry becomes active
+   once a flux is added to it. Only the active entries are visited by the
+   limiter, as it was the case with the previous map based storage.
+*/
+class FCTFluxCRS
+{
+public:
+    /// Sets up the pattern from the linear elements of the mesh.
+    explicit FCTFluxCRS(MeshLib::CFEMesh const& mesh);
+
+    std::size_t getRowBegin(const std::size_t i) const { return _row_ptr[i]; }
+    std::size_t getRowEnd(const std::size_t i) const
+    {
+        return _row_ptr[i + 1];
+    }
+    std::size_t getColumn(const std::size_t k) const { return _col_idx[k]; }
+    /// The index of entry (j, i) for the entry k = (i, j).
+    std::size_t getTransposed(const std::size_t k) const
+    {
+        return _transposed[k];
+    }
+    bool isActive(const std::size_t k) const { return _active[k] != 0; }
+    double& operator[](const std::size_t k) { return _flux[k]; }
+    double operator[](const std::size_t k) const { return _flux[k]; }
+
+    /// Adds v to the flux (i, j), which has to be in the pattern.
+    void add(const std::size_t i, const std::size_t j, const double v);
+
+    /// Sets all fluxes to zero, the active entries remain active.
+    void setZero();
+
+private:
+    std::size_t find(const std::size_t i, const std::size_t j) const;
+
+    std::vector<std::size_t> _row_ptr;
+    std::vector<std::size_t> _col_idx;
+    std::vector<std::size_t> _transposed;
+    std::vector<char> _active;
+    std::vector<double> _flux;
+};
+}  // namespace FiniteElement
+#endif
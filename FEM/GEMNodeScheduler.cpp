@@ -0,0 +1,122 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class GEMNodeScheduler
+*/
+#include "GEMNodeScheduler.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace
+{
+/// Number of chunks per thread; the last chunks of a step are small enough
+/// to fill the gaps between the threads.
+const unsigned CHUNKS_PER_THREAD = 64;
+
+struct MoreExpensive
+{
+    explicit MoreExpensive(const std::vector<double>& cost) : _cost(cost) {}
+
+    bool operator()(long a, long b) const
+    {
+        if (_cost[a] != _cost[b])
+            return _cost[a] > _cost[b];
+        return a < b;
+    }
+
+    const std::vector<double>& _cost;
+};
+}  // namespace
+
+GEMNodeScheduler::GEMNodeScheduler() : _next_chunk(0) {}
+
+void GEMNodeScheduler::prepare(const std::vector<long>& nodes,
+                               const std::vector<double>& cost,
+                               unsigned n_threads)
+{
+    _order = nodes;
+    _chunk_begin.clear();
+    _next_chunk = 0;
+    _thread_start.assign(n_threads, 0.0);
+    _thread_finish.assign(n_threads, 0.0);
+    if (_order.empty())
+    {
+        _chunk_begin.push_back(0);
+        return;
+    }
+
+    double total_cost = 0.0;
+    for (std::size_t i = 0; i < _order.size(); i++)
+        total_cost += cost[_order[i]];
+
+    if (!(total_cost > 0.0))
+    {
+        // No timings yet: one node per chunk, so that clusters of expensive
+        // nodes are still spread over the threads
+        for (std::size_t i = 0; i <= _order.size(); i++)
+            _chunk_begin.push_back(i);
+        return;
+    }
+
+    std::sort(_order.begin(), _order.end(), MoreExpensive(cost));
+
+    // Chunks of about equal cost, at least one node each
+    const double chunk_cost =
+        total_cost / (std::max(1u, n_threads) * CHUNKS_PER_THREAD);
+    double accumulated = 0.0;
+    _chunk_begin.push_back(0);
+    for (std::size_t i = 0; i < _order.size(); i++)
+    {
+        accumulated += cost[_order[i]];
+        if (accumulated >= chunk_cost && i + 1 < _order.size())
+        {
+            _chunk_begin.push_back(i + 1);
+            accumulated = 0.0;
+        }
+    }
+    _chunk_begin.push_back(_order.size());
+}
+
+bool GEMNodeScheduler::nextChunk(std::size_t& begin, std::size_t& end)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    if (_next_chunk + 1 >= _chunk_begin.size())
+        return false;
+    begin = _chunk_begin[_next_chunk];
+    end = _chunk_begin[_next_chunk + 1];
+    ++_next_chunk;
+    return true;
+}
+
+void GEMNodeScheduler::setThreadTimes(unsigned tid, double start,
+                                      double finish)
+{
+    _thread_start[tid] = start;
+    _thread_finish[tid] = finish;
+}
+
+void GEMNodeScheduler::report(std::ostream& os, double finish_time) const
+{
+    double busy_max = 0.0, busy_sum = 0.0;
+    os << "GEMS3K threads busy/idle [s]:";
+    for (std::size_t tid = 0; tid < _thread_start.size(); tid++)
+    {
+        const double busy = _thread_finish[tid] - _thread_start[tid];
+        const double idle = finish_time - _thread_finish[tid];
+        busy_max = std::max(busy_max, busy);
+        busy_sum += busy;
+        os << " " << tid << ": " << busy << "/" << idle;
+    }
+    if (busy_max > 0.0)
+        os << " load balance: "
+           << busy_sum / (busy_max * _thread_start.size());
+    os << "\n";
+}
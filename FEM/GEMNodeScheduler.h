@@ -0,0 +1,93 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class GEMNodeScheduler
+
+   Dynamic distribution of the GEMS3K node calculations over the worker
+   threads of REACT_GEM.
+*/
+#ifndef GEM_NODE_SCHEDULER_INC
+#define GEM_NODE_SCHEDULER_INC
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+/*!
+   \brief Shared work queue of node chunks for the GEMS3K worker threads.
+
+   Before each reaction step the nodes are ordered by their GEM solve time
+   of the previous step, most expensive first, and cut into chunks of about
+   equal cost. Expensive nodes thus form chunks of their own and are
+   dispatched first, while cheap nodes are grouped. The worker threads take
+   chunks from the queue until it is empty, so a thread that meets hard nodes
+   does not hold back work the others could do.
+*/
+class GEMNodeScheduler
+{
+public:
+    /// Position of a thread in its current chunk
+    struct Cursor
+    {
+        Cursor() : position(0), end(0) {}
+        std::size_t position;
+        std::size_t end;
+    };
+
+    GEMNodeScheduler();
+
+    /// Builds the queue for one step.
+    /// \param nodes    nodes to be calculated by this process
+    /// \param cost     solve time of the last step, indexed by node; nodes
+    ///                 without a measured time count as equally expensive
+    /// \param n_threads number of worker threads
+    void prepare(const std::vector<long>& nodes,
+                 const std::vector<double>& cost,
+                 unsigned n_threads);
+
+    /// Takes the next chunk, i.e. the positions [begin, end) in the order
+    /// of the nodes.
+    /// Returns false if the queue is empty. Thread safe.
+    bool nextChunk(std::size_t& begin, std::size_t& end);
+
+    /// Next node of the thread owning the cursor; takes a new chunk when the
+    /// current one is done. Returns false if the queue is empty.
+    bool nextNode(Cursor& cursor, long& node)
+    {
+        if (cursor.position == cursor.end &&
+            !nextChunk(cursor.position, cursor.end))
+            return false;
+        node = _order[cursor.position++];
+        return true;
+    }
+
+    /// Records when a thread passed the start barrier and when it ran out
+    /// of work.
+    void setThreadTimes(unsigned tid, double start, double finish);
+
+    /// Writes the busy and idle time of every thread for the last step;
+    /// finish_time is the time at which the last thread was done.
+    void report(std::ostream& os, double finish_time) const;
+
+private:
+    std::vector<long> _order;
+    std::vector<std::size_t> _chunk_begin;  ///< chunk i is
+                                            ///< [_chunk_begin[i],
+                                            ///< _chunk_begin[i+1])
+    std::size_t _next_chunk;
+    boost::mutex _mutex;
+
+    std::vector<double> _thread_start;
+    std::vector<double> _thread_finish;
+};
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class MatrixDiffusionSourceTerm
+*/
+#include "MatrixDiffusionSourceTerm.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// MSH
+#include "msh_mesh.h"
+
+namespace FiniteElement
+{
+MatrixDiffusionSourceTerm::MatrixDiffusionSourceTerm(
+    double transient_diffusivity,
+    double steady_diffusivity,
+    double factor,
+    std::size_t n_terms,
+    std::size_t max_terms,
+    double tolerance)
+    : _transient_diffusivity(transient_diffusivity),
+      _steady_diffusivity(steady_diffusivity),
+      _factor(factor),
+      _n_terms(std::max(n_terms, static_cast<std::size_t>(1))),
+      _max_terms(std::max(std::max(max_terms, n_terms),
+                          static_cast<std::size_t>(2))),
+      _tolerance(tolerance),
+      _n_terms_used(0),
+      _time(-DBL_MAX)
+{
+}
+
+void MatrixDiffusionSourceTerm::addNode(long node_id, double area,
+                                        const MeshLib::CFEMesh& mesh,
+                                        long mesh_node)
+{
+    double solute_volume = -1.0;
+    if (area < DBL_MIN)
+    {
+        // node in a domain
+        double tvol = 0.0;
+        double tflux_area = 0.0;
+        const std::vector<size_t>& elements(
+            mesh.nod_vector[mesh_node]->getConnectedElementIDs());
+        for (std::size_t i = 0; i < elements.size(); i++)
+        {
+            MeshLib::CElem* ele(mesh.ele_vector[elements[i]]);
+            const int n = ele->GetVertexNumber();
+            tvol += ele->GetVolume() / n;  // assuming 1 m thickness
+            tflux_area += ele->GetFluxArea() / n;  // fracture thickness
+        }
+        // diffusion in both directions perpendicular to the fracture
+        area = tvol * 2.;
+        solute_volume = tflux_area * tvol;
+    }
+
+    if (node_id >= static_cast<long>(_node_index.size()))
+        _node_index.resize(node_id + 1, -1);
+    _node_index[node_id] = static_cast<long>(_node_ids.size());
+    _node_ids.push_back(node_id);
+    _area.push_back(area);
+    _solute_volume.push_back(solute_volume);
+    _reference.push_back(-1.0);
+    _source.push_back(0.0);
+}
+
+double MatrixDiffusionSourceTerm::getSource(long node_id) const
+{
+    if (node_id < 0 || node_id >= static_cast<long>(_node_index.size()) ||
+        _node_index[node_id] < 0)
+        return 0.0;
+    return _source[_node_index[node_id]];
+}
+
+void MatrixDiffusionSourceTerm::addToHistory(long step, double time,
+                                             const std::vector<double>& values)
+{
+    const std::size_t n_nodes(_node_ids.size());
+    if (_slot.empty())
+    {
+        _slot.resize(_max_terms);
+        for (std::size_t i = 0; i < _max_terms; i++)
+            _slot[i] = i;
+        _level_time.assign(_max_terms, 0.0);
+        _values.assign(_max_terms * n_nodes, 0.0);
+    }
+    // The values of the first time step are the reference values.
+    if (step == 1)
+        std::copy(values.begin(), values.end(), _reference.begin());
+
+    std::size_t n_levels = std::max(step, 10L);
+    if (n_levels <= _max_terms)
+        n_levels = static_cast<std::size_t>(step);
+    else
+    {
+        // The oldest level is the average of all values dropped from the
+        // history.
+        n_levels = _max_terms;
+        const double n_past = static_cast<double>(
+            std::max(step - static_cast<long>(_max_terms), 0L));
+        const std::size_t cut(_slot[n_levels - 1]);
+        const std::size_t next(_slot[n_levels - 2]);
+        _level_time[cut] =
+            (_level_time[cut] * n_past + _level_time[next]) / (n_past + 1);
+        double* const v_cut(&_values[cut * n_nodes]);
+        const double* const v_next(&_values[next * n_nodes]);
+        for (std::size_t k = 0; k < n_nodes; k++)
+            v_cut[k] = (v_cut[k] * n_past + v_next[k]) / (n_past + 1);
+        --n_levels;
+    }
+    // shift the history, the oldest shifted level takes the new values
+    std::rotate(_slot.begin(), _slot.begin() + n_levels - 1,
+                _slot.begin() + n_levels);
+    _level_time[_slot[0]] = time;
+    std::copy(values.begin(), values.end(),
+              _values.begin() + _slot[0] * n_nodes);
+}
+
+void MatrixDiffusionSourceTerm::update(long step, double time, double dt,
+                                       const std::vector<double>& values)
+{
+    _time = time;
+    const long n_nodes(static_cast<long>(_node_ids.size()));
+    if (n_nodes == 0)
+        return;
+    addToHistory(step, time, values);
+
+    std::size_t n_terms =
+        std::min(static_cast<std::size_t>(std::max(step, 10L)), _n_terms);
+
+    // Kernel weights of the past values, the same for all nodes
+    const double pi = 3.1415926;
+    _weight.assign(n_terms, 0.0);
+    const double t0 = _level_time[_slot[0]];
+    for (std::size_t i = n_terms - 1; i > 0; i--)
+    {
+        const double ti = _level_time[_slot[i]];
+        const double tn = (i == n_terms - 1)
+                              ? (t0 - ti) + (_level_time[_slot[i - 1]] - ti)
+                              : t0 - _level_time[_slot[i + 1]];
+        const double tnn = t0 - ti;
+        _weight[i] = 1 / (std::sqrt(pi * _transient_diffusivity * tnn)) -
+                     1 / (std::sqrt(pi * _transient_diffusivity * tn));
+    }
+    if (n_terms > 1)
+        _weight[0] = -1 / (std::sqrt(pi * _transient_diffusivity *
+                                     (t0 - _level_time[_slot[1]])));
+
+    // The weights decrease with the age of the values: the oldest terms
+    // whose weights sum up to less than the tolerance relative to the weight
+    // of the current value are taken with the value of the oldest term kept,
+    // i.e. their weights are added to its weight. The sum of the weights
+    // stays the same, so a constant history still gives no source.
+    if (_tolerance > 0.0)
+    {
+        const double max_dropped = _tolerance * std::fabs(_weight[0]);
+        double dropped = 0.0;
+        double dropped_abs = 0.0;
+        while (n_terms > 2 &&
+               dropped_abs + std::fabs(_weight[n_terms - 1]) < max_dropped)
+        {
+            --n_terms;
+            dropped += _weight[n_terms];
+            dropped_abs += std::fabs(_weight[n_terms]);
+        }
+        _weight[n_terms - 1] += dropped;
+    }
+    _n_terms_used = n_terms;
+
+    // Sum the series of all nodes, level by level over blocks of nodes
+    const long block_size = 256;
+    const long n_blocks = (n_nodes + block_size - 1) / block_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long b = 0; b < n_blocks; b++)
+    {
+        const long begin = b * block_size;
+        const long end = std::min(begin + block_size, n_nodes);
+        double* const gradient = &_source[0];
+        const double* const reference = &_reference[0];
+        for (long k = begin; k < end; k++)
+            gradient[k] = 0.0;
+        for (std::size_t i = n_terms; i-- > 0;)
+        {
+            const double w = _weight[i];
+            const double* const v = &_values[_slot[i] * n_nodes];
+            for (long k = begin; k < end; k++)
+                gradient[k] += w * (v[k] - reference[k]);
+        }
+
+        for (long k = begin; k < end; k++)
+        {
+            double source =
+                gradient[k] * _steady_diffusivity * _factor * _area[k];
+            // not more than the solute present around a domain node
+            if (_solute_volume[k] >= 0.0)
+            {
+                const double mass_solute_present =
+                    _solute_volume[k] * values[k];
+                const double mass_to_remove = std::fabs(source) * dt;
+                if (mass_to_remove > mass_solute_present)
+                    source *= (mass_solute_present / mass_to_remove);
+            }
+            gradient[k] = source;
+        }
+    }
+}
+}  // namespace FiniteElement
@@ -0,0 +1,115 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class MatrixDiffusionSourceTerm
+
+   Analytical diffusion into the rock matrix as a source term at fracture
+   nodes (source terms with distribution type ANALYTICAL).
+*/
+#ifndef MATRIX_DIFFUSION_SOURCE_TERM_INC
+#define MATRIX_DIFFUSION_SOURCE_TERM_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace MeshLib
+{
+class CFEMesh;
+}
+
+namespace FiniteElement
+{
+/*!
+   \brief Matrix diffusion source terms of all nodes of one source term.
+
+   The source of a node is the diffusive flux into a semi-infinite matrix,
+   a superposition of the responses to the past changes of the node value
+   (Duhamel's principle). The kernel weights of the past values depend only
+   on the time history, which is the same for all nodes, so they are
+   computed once per evaluation and the series of all nodes is summed in one
+   loop over the nodes. Areas and solute volumes of the nodes are computed
+   once from the connected elements. The history keeps the same levels as
+   the former per node history, including the averaging of the values that
+   drop out of it, so the sources are the same.
+*/
+class MatrixDiffusionSourceTerm
+{
+public:
+    /// \param transient_diffusivity apparent diffusivity of the matrix
+    /// \param steady_diffusivity effective diffusivity of the matrix
+    /// \param factor conversion factor, e.g. from temperature to energy
+    /// \param n_terms number of past values in the series
+    /// \param max_terms number of past values kept in the history
+    /// \param tolerance summed weight of old values, relative to the weight
+    /// of the current value, below which the series is truncated; 0 keeps
+    /// all terms
+    MatrixDiffusionSourceTerm(double transient_diffusivity,
+                              double steady_diffusivity,
+                              double factor,
+                              std::size_t n_terms,
+                              std::size_t max_terms,
+                              double tolerance);
+
+    /// Adds a node. If the given area is zero the node lies in a domain:
+    /// area and solute volume are taken from the elements connected to the
+    /// mesh node, and the source is limited to the solute present.
+    /// \param node_id ID of the node value
+    void addNode(long node_id, double area, const MeshLib::CFEMesh& mesh,
+                 long mesh_node);
+
+    std::size_t getNumberOfNodes() const { return _node_ids.size(); }
+    long getNodeID(std::size_t k) const { return _node_ids[k]; }
+    /// Time of the last update
+    double getTime() const { return _time; }
+
+    /// Adds the node values (same order as the nodes were added) of the
+    /// given time step to the history and computes the sources.
+    void update(long step, double time, double dt,
+                const std::vector<double>& values);
+
+    /// Source of a node computed by the last update
+    double getSource(long node_id) const;
+
+    /// Number of series terms used by the last update
+    std::size_t getNumberOfTermsUsed() const { return _n_terms_used; }
+
+private:
+    void addToHistory(long step, double time,
+                      const std::vector<double>& values);
+
+    const double _transient_diffusivity;
+    const double _steady_diffusivity;
+    const double _factor;
+    const std::size_t _n_terms;
+    const std::size_t _max_terms;
+    const double _tolerance;
+
+    std::vector<long> _node_ids;
+    /// Position of a node ID in _node_ids, -1 if the node has no source
+    std::vector<long> _node_index;
+    std::vector<double> _area;
+    /// Volume of the solute around a domain node, negative for other nodes
+    std::vector<double> _solute_volume;
+    std::vector<double> _reference;
+    std::vector<double> _source;
+
+    /// History, newest first: the values of level i are stored at
+    /// _values[_slot[i] * number of nodes], so shifting the history only
+    /// moves the slot indices.
+    std::vector<std::size_t> _slot;
+    std::vector<double> _level_time;
+    std::vector<double> _values;
+    std::vector<double> _weight;
+    std::size_t _n_terms_used;
+    double _time;
+};
+}  // namespace FiniteElement
+
+#endif
@@ -3148,6 +3148,7 @@ void COutput::ELEWritePLY_TECData(fstream& tec_file)
     Math_Group::vec<MeshLib::CEdge*> ele_edges_vector(15);
     Math_Group::vec<MeshLib::CNode*> edge_nodes(3);
     double edge_mid_vector[3] = {0.0, 0.0, 0.0};
+    m_msh->ConstructEdges();
 
     for (size_t i = 0; i < ele_vector_at_geo.size(); i++)
     {
@@ -3983,6 +3984,7 @@ void COutput::CalculateTotalFlux(CFEMesh* msh, vector<long>& nodes_on_geo,
         std::cout << "no MSH and / or PCS  data for water balance";
         return;
     }
+    msh->ConstructFaces();
     CRFProcess* m_pcs_flow = NULL;
     if (isFlowProcess(m_pcs->getProcessType()))
         m_pcs_flow = m_pcs;
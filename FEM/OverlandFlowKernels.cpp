@@ -0,0 +1,349 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of the CVFEM overland flow kernels
+
+   The formulation is the one of the former
+   CFiniteElementStd::CalcOverland* member functions (MB 06/2005,
+   JOD 04/2007 and 06/2007).
+*/
+#include "OverlandFlowKernels.h"
+
+#include <cmath>
+
+#include "rf_mmp_new.h"
+
+namespace FiniteElement
+{
+OverlandFlowParameters::OverlandFlowParameters(const CMediumProperties& mmp)
+    : friction(mmp.friction_coefficient),
+      slope_exp(mmp.friction_exp_slope),
+      depth_exp(mmp.friction_exp_depth),
+      width(mmp.overland_width),
+      rill_height(mmp.rill_height),
+      rill_epsilon(mmp.rill_epsilon),
+      channel(mmp.channel),
+      rill_offset(mmp.rill_epsilon * mmp.rill_epsilon /
+                  (mmp.rill_height + mmp.rill_epsilon))
+{
+}
+
+namespace
+{
+const double line_edll[4] = {1.0, -1.0, -1.0, 1.0};
+const double line_edtt[4] = {0.0, 0.0, 0.0, 0.0};
+const double quad_edll[16] = {0.5, -0.5, 0.,  0.,  -0.5, 0.5, 0., 0.,
+                              0.,  0.,   0.5, -0.5, 0.,  0.,  -0.5, 0.5};
+const double quad_edtt[16] = {0.5, 0.,   0.,  -0.5, 0., 0.5, -0.5, 0.,
+                              0.,  -0.5, 0.5, 0.,   -0.5, 0., 0.,  0.5};
+
+bool computeGeometry(int geo_type, const double* X, const double* Y,
+                     const double* Z, OverlandElementGeometry& geo)
+{
+    switch (geo_type)
+    {
+        case 1:  // line
+        {
+            geo.n_nodes = 2;
+            const double dx = X[1] - X[0];
+            const double dy = Y[1] - Y[0];
+            geo.dx = sqrt(dx * dx + dy * dy);
+            break;
+        }
+        case 2:  // quadrilateral
+        {
+            geo.n_nodes = 4;
+            const double dx = X[1] - X[0];  // ell
+            const double dy = Y[3] - Y[0];  // ett
+            const double dzx = Z[1] - Z[0];
+            const double dzy = Z[3] - Z[0];
+            geo.dx = sqrt(dx * dx + dzx * dzx);
+            geo.dy = sqrt(dy * dy + dzy * dzy);
+            geo.area = geo.dx * geo.dy;
+            break;
+        }
+        case 4:  // triangle
+        {
+            geo.n_nodes = 3;
+            const double x2 = X[1] - X[0];
+            const double x3 = X[2] - X[0];
+            const double y2 = Y[1] - Y[0];
+            const double y3 = Y[2] - Y[0];
+            geo.area = (x2 * y3 - x3 * y2) * 0.5;
+            const double delt2inv = 1.0 / (2.0 * geo.area);
+            geo.b[0] = (y2 - y3) * delt2inv;
+            geo.b[1] = y3 * delt2inv;
+            geo.b[2] = -y2 * delt2inv;
+            geo.g[0] = (x3 - x2) * delt2inv;
+            geo.g[1] = -x3 * delt2inv;
+            geo.g[2] = x2 * delt2inv;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    for (int i = 0; i < geo.n_nodes; i++)
+        geo.z[i] = Z[i];
+    return true;
+}
+
+/// Magnitude of the head gradient, dh/ds in the direction of maximum slope
+template <int N>
+double headSlope(const OverlandElementGeometry& geo, const double* head);
+
+template <>
+double headSlope<2>(const OverlandElementGeometry& geo, const double* head)
+{
+    return fabs((head[0] - head[1]) / geo.dx);
+}
+
+template <>
+double headSlope<3>(const OverlandElementGeometry& geo, const double* head)
+{
+    const double gx =
+        geo.b[0] * head[0] + geo.b[1] * head[1] + geo.b[2] * head[2];
+    const double gy =
+        geo.g[0] * head[0] + geo.g[1] * head[1] + geo.g[2] * head[2];
+    return sqrt(gx * gx + gy * gy);
+}
+
+template <>
+double headSlope<4>(const OverlandElementGeometry& geo, const double* head)
+{
+    const double gx =
+        (head[0] - head[1] - head[2] + head[3]) / (2.0 * geo.dx);
+    const double gy =
+        (head[0] + head[1] - head[2] - head[3]) / (2.0 * geo.dy);
+    return sqrt(gx * gx + gy * gy);
+}
+
+/// Conductances axx, ayy and the lumped storage coefficient ast
+template <int N>
+void elementCoefficients(const OverlandElementGeometry& geo,
+                         const OverlandFlowParameters& par, double eslope,
+                         double dt, double& axx, double& ayy, double& ast);
+
+template <>
+void elementCoefficients<2>(const OverlandElementGeometry& geo,
+                            const OverlandFlowParameters& par, double eslope,
+                            double dt, double& axx, double& ayy, double& ast)
+{
+    axx = eslope * par.friction * par.width / geo.dx;
+    ayy = 0.0;
+    ast = geo.dx * par.width / (2.0 * dt);
+}
+
+template <>
+void elementCoefficients<3>(const OverlandElementGeometry& geo,
+                            const OverlandFlowParameters& par, double eslope,
+                            double dt, double& axx, double& ayy, double& ast)
+{
+    axx = eslope * par.friction * geo.area;
+    ayy = axx;
+    ast = geo.area / (3.0 * dt);
+}
+
+template <>
+void elementCoefficients<4>(const OverlandElementGeometry& geo,
+                            const OverlandFlowParameters& par, double eslope,
+                            double dt, double& axx, double& ayy, double& ast)
+{
+    axx = eslope * par.friction * geo.dy / geo.dx;  // ett/ell
+    ayy = eslope * par.friction * geo.dx / geo.dy;
+    ast = geo.area / (4.0 * dt);
+}
+
+/// CVFEM topology coefficients edll, edtt of the node pair (i, j)
+template <int N>
+void topology(const OverlandElementGeometry& geo, int i, int j, double& edll,
+              double& edtt);
+
+template <>
+void topology<2>(const OverlandElementGeometry& /*geo*/, int i, int j,
+                 double& edll, double& edtt)
+{
+    edll = line_edll[i * 2 + j];
+    edtt = line_edtt[i * 2 + j];
+}
+
+template <>
+void topology<3>(const OverlandElementGeometry& geo, int i, int j,
+                 double& edll, double& edtt)
+{
+    edll = geo.b[i] * geo.b[j];
+    edtt = geo.g[i] * geo.g[j];
+}
+
+template <>
+void topology<4>(const OverlandElementGeometry& /*geo*/, int i, int j,
+                 double& edll, double& edtt)
+{
+    edll = quad_edll[i * 4 + j];
+    edtt = quad_edtt[i * 4 + j];
+}
+
+/// Surface water storage of the rill or channel structure at a water depth
+inline double surfaceStorage(const OverlandFlowParameters& par, double depth)
+{
+    const double eps = par.rill_epsilon;
+    if (eps <= 0.0)
+        return depth;
+    if (par.channel)
+    {
+        const double ratio = depth / eps;
+        if (ratio > 1.0)
+            return depth;
+        if (ratio > 0.0)
+            return depth * pow(ratio, 2.0 * (1.0 - ratio));
+        return 0.0;
+    }
+    if (depth > 0.0)
+        return (depth + eps) * (depth + eps) / (depth + par.rill_height + eps) -
+               par.rill_offset;
+    return 0.0;
+}
+
+/// Upwinded conveyance of a node pair (hydraulic radius for channels)
+inline double conveyance(const OverlandFlowParameters& par, double flow_depth)
+{
+    if (flow_depth < 0.0)
+        return 0.0;
+    if (par.channel)
+        return flow_depth * pow(flow_depth * par.width /
+                                    (2 * flow_depth + par.width),
+                                par.depth_exp);
+    return pow(flow_depth, par.depth_exp + 1);
+}
+
+template <int N>
+void assemble(const OverlandElementGeometry& geo,
+              const OverlandFlowParameters& par, const double* head,
+              const double* head_old, double dt, double* residual,
+              double* jacobian)
+{
+    const double epsilon = 1.e-7;  // be carefull, like in primary variable
+                                   // dependent source terms
+
+    double dhds = headSlope<N>(geo, head);
+    if (dhds < 1.0e-10)
+        dhds = 1.0e-10;
+    const double eslope = pow(1.0 / dhds, 1 - par.slope_exp);
+    double axx, ayy, ast;
+    elementCoefficients<N>(geo, par, eslope, dt, axx, ayy, ast);
+
+    // Upwind node, conveyance and conductance of every node pair. The
+    // conveyance of a pair only changes in a Jacobian column that perturbs
+    // its upwind node, so it is kept for all other columns.
+    int upwind[N * N];
+    double ckwr[N * N], conductance[N * N], max_z[N * N];
+    double amat[N * N];
+    for (int k = 0; k < N * N; k++)
+        amat[k] = 0.0;
+    for (int i = 0; i < N; i++)
+        for (int j = i + 1; j < N; j++)
+        {
+            const int ij = i * N + j, ji = j * N + i;
+            max_z[ij] = max_z[ji] = (geo.z[i] > geo.z[j]) ? geo.z[i] : geo.z[j];
+            const int up = (head[i] > head[j]) ? i : j;
+            upwind[ij] = up;
+            upwind[ji] = (head[j] > head[i]) ? j : i;
+            ckwr[ij] = ckwr[ji] =
+                conveyance(par, head[up] - max_z[ij] - par.rill_height);
+
+            // The topology matrices are symmetric
+            double edll, edtt;
+            topology<N>(geo, i, j, edll, edtt);
+            conductance[ij] = conductance[ji] = (edll * axx) + (edtt * ayy);
+
+            const double gammaij = ckwr[ij] * conductance[ij];
+            amat[ij] = gammaij;
+            amat[ji] = gammaij;
+            amat[i * N + i] -= gammaij;
+            amat[j * N + j] -= gammaij;
+        }
+
+    // Residual
+    double swold[N];
+    for (int i = 0; i < N; i++)
+    {
+        swold[i] = surfaceStorage(par, head_old[i] - geo.z[i]);
+        const double swval = surfaceStorage(par, head[i] - geo.z[i]);
+        double sum = 0.0;
+        for (int j = 0; j < N; j++)
+            sum = sum + (amat[i * N + j] * head[j]);
+        residual[i] = sum + ast * (swval - swold[i]);
+    }
+
+    // Jacobian by forward differences, column i perturbs head[i]
+    for (int i = 0; i < N; i++)
+    {
+        const double h_eps = head[i] + epsilon;
+        double sumjac = 0.0;
+        for (int j = 0; j < N; j++)
+        {
+            if (i == j)
+                continue;
+            const int ij = i * N + j;
+            double akrw = ckwr[ij];
+            if (upwind[ij] == i)
+                akrw =
+                    conveyance(par, h_eps - max_z[ij] - par.rill_height);
+            const double gammaij = akrw * conductance[ij];
+            const double amat_eps = gammaij * (head[j] - h_eps);
+            const double amat_keep = amat[ij] * (head[j] - head[i]);
+            sumjac = sumjac + amat_eps;
+            jacobian[j * N + i] = -(amat_eps - amat_keep) / epsilon;
+        }
+        // Lumped storage term on the diagonal
+        const double stor_eps =
+            ast * (surfaceStorage(par, h_eps - geo.z[i]) - swold[i]);
+        sumjac = sumjac + stor_eps;
+        jacobian[i * N + i] = (sumjac - residual[i]) / epsilon;
+    }
+}
+}  // namespace
+
+const OverlandElementGeometry* OverlandFlowGeometryCache::get(
+    std::size_t element_index, int geo_type, const double* X, const double* Y,
+    const double* Z)
+{
+    if (element_index >= _geometry.size())
+        _geometry.resize(element_index + 1);
+    OverlandElementGeometry& geo = _geometry[element_index];
+    if (geo.n_nodes == 0 && !computeGeometry(geo_type, X, Y, Z, geo))
+        return NULL;
+    return &geo;
+}
+
+void assembleOverlandNewton(const OverlandElementGeometry& geometry,
+                            const OverlandFlowParameters& parameters,
+                            const double* head, const double* head_old,
+                            double dt, double* residual, double* jacobian)
+{
+    switch (geometry.n_nodes)
+    {
+        case 2:
+            assemble<2>(geometry, parameters, head, head_old, dt, residual,
+                        jacobian);
+            break;
+        case 3:
+            assemble<3>(geometry, parameters, head, head_old, dt, residual,
+                        jacobian);
+            break;
+        case 4:
+            assemble<4>(geometry, parameters, head, head_old, dt, residual,
+                        jacobian);
+            break;
+        default:
+            break;
+    }
+}
+}  // namespace FiniteElement
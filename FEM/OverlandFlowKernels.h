@@ -0,0 +1,98 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of the CVFEM overland flow kernels
+
+   Residual and Jacobian of the Newton assembly of overland and channel flow
+   (Manning/Chezy type friction law) for line, triangle and quadrilateral
+   elements.
+*/
+#ifndef OVERLAND_FLOW_KERNELS_INC
+#define OVERLAND_FLOW_KERNELS_INC
+
+#include <cstddef>
+#include <vector>
+
+class CMediumProperties;
+
+namespace FiniteElement
+{
+/// Friction law and surface structure of an overland flow medium.
+struct OverlandFlowParameters
+{
+    explicit OverlandFlowParameters(const CMediumProperties& mmp);
+
+    double friction;     ///< friction_coefficient
+    double slope_exp;    ///< exponent of the slope, friction_exp_slope
+    double depth_exp;    ///< exponent of the depth, friction_exp_depth
+    double width;        ///< overland_width (line elements)
+    double rill_height;
+    double rill_epsilon;
+    bool channel;
+    /// Storage offset of the rill model, eps^2/(rill_height + eps)
+    double rill_offset;
+};
+
+/*!
+   \brief Time independent data of an overland flow element.
+
+   Computed once from the element coordinates: node elevations and the
+   lengths or basis function gradients that enter the slope, conveyance and
+   CVFEM topology terms. Kept small, since it is stored for every element of
+   the surface mesh.
+*/
+struct OverlandElementGeometry
+{
+    OverlandElementGeometry() : n_nodes(0) {}
+
+    int n_nodes;  ///< 2 line, 3 triangle, 4 quadrilateral; 0 if not set
+    double z[4];
+    /// Line: length dx; quad: edge lengths dx, dy along the surface
+    double dx;
+    double dy;
+    /// Quad and triangle: area
+    double area;
+    /// Triangle: basis function gradients
+    double b[3];
+    double g[3];
+};
+
+/// Geometry of the overland flow elements of a mesh, filled on first use.
+class OverlandFlowGeometryCache
+{
+public:
+    /// Returns the cached geometry of the element or computes it from the
+    /// local coordinates X, Y, Z. Returns NULL for unsupported element types.
+    const OverlandElementGeometry* get(std::size_t element_index,
+                                       int geo_type, const double* X,
+                                       const double* Y, const double* Z);
+
+private:
+    std::vector<OverlandElementGeometry> _geometry;
+};
+
+/*!
+   \brief Newton residual and Jacobian of one overland flow element.
+
+   \param head      heads of the current iterate
+   \param head_old  heads of the previous time level
+   \param residual  residual[n_nodes]
+   \param jacobian  row major jacobian[n_nodes * n_nodes]
+
+   The upwind direction of every node pair is determined once from the
+   current heads and kept for all perturbed columns of the Jacobian.
+*/
+void assembleOverlandNewton(const OverlandElementGeometry& geometry,
+                            const OverlandFlowParameters& parameters,
+                            const double* head, const double* head_old,
+                            double dt, double* residual, double* jacobian);
+}  // namespace FiniteElement
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class ParticleConcentration
+*/
+#include "ParticleConcentration.h"
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// MSH
+#include "msh_mesh.h"
+
+// FEM
+#include "rf_random_walk.h"
+
+namespace FiniteElement
+{
+ParticleConcentration::ParticleConcentration(const MeshLib::CFEMesh& mesh)
+    : _mesh(mesh), _count(mesh.ele_vector.size(), 0), _unit_concentration(0.0)
+{
+}
+
+void ParticleConcentration::countParticles(const std::vector<Trace>& particles)
+{
+    const long n_particles(static_cast<long>(particles.size()));
+    const long n_elements(static_cast<long>(_count.size()));
+    std::fill(_count.begin(), _count.end(), 0);
+
+#ifdef _OPENMP
+    const int n_threads(omp_get_max_threads());
+    _thread_count.assign((n_threads - 1) * n_elements, 0);
+#pragma omp parallel
+    {
+        const int tid(omp_get_thread_num());
+        long* const count(tid == 0 ? &_count[0]
+                                   : &_thread_count[(tid - 1) * n_elements]);
+#pragma omp for schedule(static)
+        for (long i = 0; i < n_particles; i++)
+        {
+            const int e(particles[i].Now.elementIndex);
+            if (e >= 0 && e < n_elements)
+                ++count[e];
+        }
+    }
+    for (int t = 1; t < n_threads; t++)
+    {
+        const long* const count(&_thread_count[(t - 1) * n_elements]);
+        for (long e = 0; e < n_elements; e++)
+            _count[e] += count[e];
+    }
+#else
+    for (long i = 0; i < n_particles; i++)
+    {
+        const int e(particles[i].Now.elementIndex);
+        if (e >= 0 && e < n_elements)
+            ++_count[e];
+    }
+#endif
+
+    // unit concentration: all particles evenly distributed over the elements
+    _unit_concentration =
+        n_particles > 0 ? static_cast<double>(n_elements) / n_particles : 0.0;
+}
+
+void ParticleConcentration::getNodalConcentration(
+    std::vector<double>& node_values) const
+{
+    const std::size_t n_nodes(_mesh.nod_vector.size());
+    std::vector<double> volume(n_nodes, 0.0);
+    node_values.assign(n_nodes, 0.0);
+
+    for (std::size_t e = 0; e < _count.size(); e++)
+    {
+        const MeshLib::CElem* elem(_mesh.ele_vector[e]);
+        const double v(elem->GetVolume());
+        const double vc(v * getElementConcentration(e));
+        const int n_elem_nodes(static_cast<int>(elem->GetNodesNumber(false)));
+        for (int k = 0; k < n_elem_nodes; k++)
+        {
+            const long n(elem->GetNodeIndex(k));
+            node_values[n] += vc;
+            volume[n] += v;
+        }
+    }
+
+    for (std::size_t n = 0; n < n_nodes; n++)
+        if (volume[n] > 0.0)
+            node_values[n] /= volume[n];
+}
+}  // namespace FiniteElement
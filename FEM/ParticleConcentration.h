@@ -0,0 +1,70 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class ParticleConcentration
+
+   Reconstruction of element and node concentrations from the particles of
+   the random walk particle tracking (RWPT).
+*/
+#ifndef PARTICLE_CONCENTRATION_INC
+#define PARTICLE_CONCENTRATION_INC
+
+#include <cstddef>
+#include <vector>
+
+class Trace;
+
+namespace MeshLib
+{
+class CFEMesh;
+}
+
+namespace FiniteElement
+{
+/*!
+   \brief Particle counts per element and their smoothing onto the nodes.
+
+   The particles are counted in one pass using the element index every
+   particle already carries; with OpenMP every thread fills its own
+   histogram, which are summed afterwards. The element concentration is the
+   count normalised by the mean number of particles per element. The nodal
+   concentration is the volume weighted mean of the element concentrations
+   of the elements sharing the node, i.e. a kernel with the support of the
+   node patch.
+*/
+class ParticleConcentration
+{
+public:
+    explicit ParticleConcentration(const MeshLib::CFEMesh& mesh);
+
+    /// Counts the particles at their current positions. Particles outside
+    /// the domain are not counted.
+    void countParticles(const std::vector<Trace>& particles);
+
+    /// Number of particles in element e of the last count
+    long getCount(std::size_t e) const { return _count[e]; }
+    /// Normalised concentration of element e of the last count
+    double getElementConcentration(std::size_t e) const
+    {
+        return _count[e] * _unit_concentration;
+    }
+
+    /// Smoothes the element concentrations onto the nodes.
+    void getNodalConcentration(std::vector<double>& node_values) const;
+
+private:
+    const MeshLib::CFEMesh& _mesh;
+    std::vector<long> _count;
+    std::vector<long> _thread_count;  ///< histograms of threads 1, 2, ...
+    double _unit_concentration;  ///< 1 / mean particles per element
+};
+}  // namespace FiniteElement
+
+#endif
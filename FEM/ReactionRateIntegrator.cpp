@@ -0,0 +1,231 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class ReactionRateIntegrator
+*/
+#include "ReactionRateIntegrator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef OGS_USE_CVODE
+extern "C"
+{
+#include <cvode/cvode.h>             /* prototypes for CVODE fcts., consts. */
+#include <nvector/nvector_serial.h>  /* serial N_Vector types, fcts., macros */
+#include <cvode/cvode_dense.h>       /* prototype for CVDense */
+#include <sundials/sundials_types.h> /* definition of type realtype */
+}
+#endif
+
+#include "conversion_rate.h"
+
+namespace FiniteElement
+{
+/// CVode memory and state of one thread
+struct ReactionRateWorkspace
+{
+    explicit ReactionRateWorkspace(conversion_rate const& conv_rate);
+    ~ReactionRateWorkspace();
+
+    conversion_rate model;
+    Eigen::VectorXd y_eig;
+    Eigen::VectorXd dydx_eig;
+#ifdef OGS_USE_CVODE
+    void* cvode_mem;
+    N_Vector y;
+    N_Vector ydot;
+    N_Vector abstol;
+#endif
+};
+
+#ifdef OGS_USE_CVODE
+/**
+ * @brief Wrapper function to interface conversion_rate with SUNDIALS CVode
+ * solver
+ */
+static int cvRhsFn_conversion_rate(realtype t, N_Vector y, N_Vector ydot,
+                                   void* user_data)
+{
+    ReactionRateWorkspace& ws = *static_cast<ReactionRateWorkspace*>(user_data);
+
+    ws.y_eig(0) = NV_Ith_S(y, 0);
+    ws.model.eval(t, ws.y_eig, ws.dydx_eig);
+    NV_Ith_S(ydot, 0) = ws.dydx_eig(0);
+
+    return 0;
+}
+#endif
+
+ReactionRateWorkspace::ReactionRateWorkspace(conversion_rate const& conv_rate)
+    : model(conv_rate),
+      y_eig(Eigen::VectorXd::Zero(1)),
+      dydx_eig(Eigen::VectorXd::Zero(1))
+{
+#ifdef OGS_USE_CVODE
+    const int NEQ = 1;
+    y = N_VNew_Serial(NEQ);
+    ydot = N_VNew_Serial(NEQ);
+    abstol = N_VNew_Serial(NEQ);
+    NV_Ith_S(y, 0) = 0.0;
+    NV_Ith_S(abstol, 0) = 1e-10;
+    const realtype reltol = 1e-10;
+
+    cvode_mem = CVodeCreate(CV_ADAMS, CV_FUNCTIONAL);
+    int flag = CVodeInit(cvode_mem, cvRhsFn_conversion_rate, 0.0, y);
+    if (flag == CV_SUCCESS)
+        flag = CVodeSetUserData(cvode_mem, static_cast<void*>(this));
+    if (flag == CV_SUCCESS)
+        flag = CVodeSVtolerances(cvode_mem, reltol, abstol);
+    if (flag == CV_SUCCESS)
+        flag = CVDense(cvode_mem, NEQ);
+    if (flag != CV_SUCCESS)
+    {
+        std::cerr << "ERROR at " << __FUNCTION__ << ":" << __LINE__
+                  << ": CVode setup failed" << std::endl;
+        exit(1);
+    }
+#endif
+}
+
+ReactionRateWorkspace::~ReactionRateWorkspace()
+{
+#ifdef OGS_USE_CVODE
+    N_VDestroy_Serial(y);
+    N_VDestroy_Serial(ydot);
+    N_VDestroy_Serial(abstol);
+    CVodeFree(&cvode_mem);
+#endif
+}
+
+ReactionRateIntegrator::ReactionRateIntegrator(conversion_rate const& model)
+    : _model(model)
+{
+}
+
+ReactionRateIntegrator::~ReactionRateIntegrator()
+{
+    for (std::size_t i = 0; i < _workspaces.size(); i++)
+        delete _workspaces[i];
+}
+
+void ReactionRateIntegrator::allocateWorkspaces()
+{
+#ifdef _OPENMP
+    const std::size_t n = static_cast<std::size_t>(
+        std::max(omp_get_max_threads(), omp_get_num_threads()));
+#else
+    const std::size_t n = 1;
+#endif
+    while (_workspaces.size() < n)
+        _workspaces.push_back(new ReactionRateWorkspace(_model));
+}
+
+void ReactionRateIntegrator::integrate(ReactionRateWorkspace& ws,
+                                       ReactiveGaussPoint const& pnt,
+                                       const double delta_t, double& y_fin,
+                                       double& dydt_fin)
+{
+    ws.model.update_param(pnt.T_solid, pnt.T_gas, pnt.p_gas, pnt.w_water,
+                          pnt.rho_s_prev, pnt.phi_solid, delta_t, pnt.system);
+    // density of the reactive fraction
+    const double y_ini =
+        (pnt.rho_s_prev - pnt.xv_NR * pnt.rho_NR) / (1.0 - pnt.xv_NR);
+#ifdef OGS_USE_CVODE
+    NV_Ith_S(ws.y, 0) = y_ini;
+    int flag = CVodeReInit(ws.cvode_mem, 0.0, ws.y);
+
+    realtype t;
+    if (flag == CV_SUCCESS)
+        flag = CVode(ws.cvode_mem, delta_t, ws.y, &t, CV_NORMAL);
+    if (flag != CV_SUCCESS)
+    {
+        std::cerr << "ERROR at " << __FUNCTION__ << ":" << __LINE__
+                  << std::endl;
+    }
+
+    y_fin = NV_Ith_S(ws.y, 0);
+    cvRhsFn_conversion_rate(delta_t, ws.y, ws.ydot, &ws);
+    dydt_fin = NV_Ith_S(ws.ydot, 0);
+#else
+    (void)y_ini;
+    (void)y_fin;
+    (void)dydt_fin;
+    std::cout << "Error: CMake option OGS_USE_CVODE needs to be "
+                 "set to solve this process type!"
+              << std::endl;
+    exit(1);
+#endif
+}
+
+void ReactionRateIntegrator::integrateBatch(
+    std::vector<ReactiveGaussPoint> const& batch, const double delta_t)
+{
+#ifdef _OPENMP
+    ReactionRateWorkspace& ws = *_workspaces[omp_get_thread_num()];
+#else
+    ReactionRateWorkspace& ws = *_workspaces[0];
+#endif
+    for (std::size_t i = 0; i < batch.size(); i++)
+    {
+        ReactiveGaussPoint const& pnt = batch[i];
+        double y_new, y_dot_new;
+        integrate(ws, pnt, delta_t, y_new, y_dot_new);
+
+        // cut off when limits are reached
+        double rho_react;
+        if (y_new < pnt.rho_lower)
+            rho_react = pnt.rho_lower;
+        else if (y_new > pnt.rho_upper)
+            rho_react = pnt.rho_upper;
+        else
+            rho_react = y_new;
+
+        *pnt.rho_s_curr = (1.0 - pnt.xv_NR) * rho_react + pnt.xv_NR * pnt.rho_NR;
+        *pnt.q_R = y_dot_new * (1.0 - pnt.xv_NR);
+    }
+}
+
+void ReactionRateIntegrator::startBatch(const double delta_t)
+{
+    // all workspaces exist before the first task runs
+    if (_batches.empty())
+        allocateWorkspaces();
+    _batches.push_back(std::vector<ReactiveGaussPoint>());
+    std::vector<ReactiveGaussPoint>* const batch = &_batches.back();
+    batch->swap(_points);
+#ifdef _OPENMP
+#pragma omp task firstprivate(batch, delta_t)
+#endif
+    integrateBatch(*batch, delta_t);
+}
+
+void ReactionRateIntegrator::submit(const double delta_t)
+{
+    const std::size_t batch_size = 64;
+    if (_points.size() >= batch_size)
+        startBatch(delta_t);
+}
+
+void ReactionRateIntegrator::integrate(const double delta_t)
+{
+    if (!_points.empty())
+        startBatch(delta_t);
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+    _batches.clear();
+}
+}  // namespace FiniteElement
@@ -0,0 +1,108 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class ReactionRateIntegrator
+
+   Time integration of the solid density of the reactive Gauss points of the
+   TES and TNEQ processes.
+*/
+#ifndef REACTION_RATE_INTEGRATOR_INC
+#define REACTION_RATE_INTEGRATOR_INC
+
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include "FEMEnums.h"
+
+class conversion_rate;
+
+namespace FiniteElement
+{
+struct ReactionRateWorkspace;
+
+/// State of a reactive Gauss point for one time step.
+struct ReactiveGaussPoint
+{
+    double T_solid;
+    double T_gas;
+    double p_gas;  ///< in bar
+    double w_water;
+    double rho_s_prev;
+    double phi_solid;
+    SolidReactiveSystem system;
+
+    /// Volume fraction and density of the non reactive solid
+    double xv_NR;
+    double rho_NR;
+    /// Limits of the density of the reactive solid
+    double rho_lower;
+    double rho_upper;
+
+    /// Locations of the results, rho_s_curr and q_R of the Gauss point
+    double* rho_s_curr;
+    double* q_R;
+};
+
+/*!
+   \brief Batched integration of the conversion rate with SUNDIALS CVode.
+
+   The Gauss points are collected during the element loop. The element loop
+   itself runs on one thread; if it is executed inside an OpenMP single
+   region, submit() hands every full batch of points to an OpenMP task, so
+   the other threads integrate while the loop continues. integrate() takes
+   the rest and waits for all batches. Each thread owns a workspace, which
+   holds the CVode memory, the state vectors and a copy of the conversion
+   rate model. The workspaces are allocated once and reinitialised for every
+   Gauss point, so that the process wide conversion_rate object is not
+   modified.
+*/
+class ReactionRateIntegrator
+{
+public:
+    /// The conversion rate model is copied into the workspaces, it has to
+    /// outlive the integrator.
+    explicit ReactionRateIntegrator(conversion_rate const& model);
+    ~ReactionRateIntegrator();
+
+    void add(ReactiveGaussPoint const& pnt) { _points.push_back(pnt); }
+    std::size_t size() const { return _points.size(); }
+
+    /// Starts the integration of the collected points over the time step
+    /// delta_t as a task once a batch is full.
+    void submit(const double delta_t);
+
+    /// Integrates the remaining points over the time step delta_t, waits for
+    /// the submitted batches and clears them. All results are written when
+    /// it returns.
+    void integrate(const double delta_t);
+
+private:
+    ReactionRateIntegrator(ReactionRateIntegrator const&);
+    ReactionRateIntegrator& operator=(ReactionRateIntegrator const&);
+
+    /// y_fin and dydt_fin are the density of the reactive solid and its rate
+    /// of change at the end of the time step before applying the limits.
+    void integrate(ReactionRateWorkspace& ws, ReactiveGaussPoint const& pnt,
+                   const double delta_t, double& y_fin, double& dydt_fin);
+    void integrateBatch(std::vector<ReactiveGaussPoint> const& batch,
+                        const double delta_t);
+    void startBatch(const double delta_t);
+    void allocateWorkspaces();
+
+    conversion_rate const& _model;
+    std::vector<ReactionRateWorkspace*> _workspaces;
+    /// Points collected since the last submitted batch
+    std::vector<ReactiveGaussPoint> _points;
+    /// Submitted batches, a list so that running tasks keep their batch
+    std::list<std::vector<ReactiveGaussPoint> > _batches;
+};
+}  // namespace FiniteElement
+#endif
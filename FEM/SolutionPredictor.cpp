@@ -0,0 +1,90 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class SolutionPredictor
+*/
+#include "SolutionPredictor.h"
+
+#include <algorithm>
+
+namespace FiniteElement
+{
+SolutionPredictor::SolutionPredictor(int order, std::size_t n_values)
+    : _max_levels(static_cast<std::size_t>(std::max(1, std::min(order, 2))) +
+                  1),
+      _n_values(n_values),
+      _levels(_max_levels),
+      _n_levels(0),
+      _n_bounded(0)
+{
+}
+
+void SolutionPredictor::store(double time,
+                              const std::vector<double*>& variables)
+{
+    // drop solutions of rejected steps
+    while (_n_levels > 0 && _levels[_n_levels - 1].time >= time)
+        --_n_levels;
+    // drop the oldest solution, its buffer is used for the new one
+    if (_n_levels == _max_levels)
+    {
+        std::rotate(_levels.begin(), _levels.begin() + 1, _levels.end());
+        --_n_levels;
+    }
+
+    Level& level = _levels[_n_levels++];
+    level.time = time;
+    level.values.resize(variables.size() * _n_values);
+    for (std::size_t v = 0; v < variables.size(); v++)
+        std::copy(variables[v], variables[v] + _n_values,
+                  level.values.begin() + v * _n_values);
+}
+
+bool SolutionPredictor::predict(double time,
+                                const std::vector<double*>& variables,
+                                const std::vector<double>& lower,
+                                const std::vector<double>& upper)
+{
+    _n_bounded = 0;
+    if (_n_levels < 2)
+        return false;
+
+    // Lagrange weights of the stored solutions at the new time
+    double weight[3];
+    for (std::size_t k = 0; k < _n_levels; k++)
+    {
+        weight[k] = 1.0;
+        for (std::size_t l = 0; l < _n_levels; l++)
+            if (l != k)
+                weight[k] *= (time - _levels[l].time) /
+                             (_levels[k].time - _levels[l].time);
+    }
+
+    const Level& last = _levels[_n_levels - 1];
+    for (std::size_t v = 0; v < variables.size(); v++)
+    {
+        const std::size_t offset = v * _n_values;
+        double* const u = variables[v];
+        for (std::size_t i = 0; i < _n_values; i++)
+        {
+            double value = 0.0;
+            for (std::size_t k = 0; k < _n_levels; k++)
+                value += weight[k] * _levels[k].values[offset + i];
+            if (value < lower[v] || value > upper[v])
+            {
+                value = last.values[offset + i];
+                ++_n_bounded;
+            }
+            u[i] = value;
+        }
+    }
+    return true;
+}
+}  // namespace FiniteElement
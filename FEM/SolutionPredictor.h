@@ -0,0 +1,71 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class SolutionPredictor
+
+   Extrapolation in time of the last accepted solutions as the first
+   nonlinear iterate of a time step.
+*/
+#ifndef SOLUTION_PREDICTOR_INC
+#define SOLUTION_PREDICTOR_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace FiniteElement
+{
+/*!
+   \brief Predictor for the primary variables of a process.
+
+   Keeps the last order+1 accepted solutions with their times and evaluates
+   the Lagrange polynomial through them (linear for order 1, quadratic for
+   order 2) at the new time, so variable time step sizes are accounted for.
+   A predicted value outside the bounds of its variable is replaced by the
+   last accepted value of the node.
+*/
+class SolutionPredictor
+{
+public:
+    /// \param order 1 linear, 2 quadratic extrapolation
+    /// \param n_values number of values per variable
+    SolutionPredictor(int order, std::size_t n_values);
+
+    /// Stores the accepted solution at the given time. Stored solutions at
+    /// this or later times, e.g. from a rejected step, are replaced.
+    void store(double time, const std::vector<double*>& variables);
+
+    /// Overwrites the variables by the extrapolation to the given time.
+    /// Does nothing and returns false if less than two solutions are stored.
+    /// \param lower, upper bounds of every variable
+    bool predict(double time, const std::vector<double*>& variables,
+                 const std::vector<double>& lower,
+                 const std::vector<double>& upper);
+
+    /// Number of values reset to the last solution by the last prediction
+    std::size_t getNumberOfBoundedValues() const { return _n_bounded; }
+
+private:
+    struct Level
+    {
+        double time;
+        std::vector<double> values;  ///< all variables, one after the other
+    };
+
+    const std::size_t _max_levels;
+    const std::size_t _n_values;
+    /// Stored solutions, oldest first; the buffers of dropped levels are
+    /// reused.
+    std::vector<Level> _levels;
+    std::size_t _n_levels;
+    std::size_t _n_bounded;
+};
+}  // namespace FiniteElement
+
+#endif
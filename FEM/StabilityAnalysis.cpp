@@ -0,0 +1,154 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class StabilityAnalysis
+*/
+#include "StabilityAnalysis.h"
+
+#include <cfloat>
+#include <cmath>
+
+#include "fem_ele_std.h"
+#include "mathlib.h"
+#include "rf_mmp_new.h"
+#include "rf_pcs.h"
+#include "rfmat_cp.h"
+
+namespace
+{
+/// Minimum value and the smallest element index where it occurs
+struct MinLoc
+{
+    double value;
+    long element;
+    MinLoc() : value(DBL_MAX), element(-1) {}
+    void update(const double v, const long e)
+    {
+        if (v < value || (v == value && e < element))
+        {
+            value = v;
+            element = e;
+        }
+    }
+};
+}  // namespace
+
+namespace FiniteElement
+{
+StabilityAnalysis::StabilityAnalysis(CRFProcess* flow_pcs,
+                                     CRFProcess* transport_pcs)
+    : _flow_pcs(flow_pcs),
+      _porosity(mmp_vector.size()),
+      _dispersivity(mmp_vector.size()),
+      _pore_diffusion(mmp_vector.size(), 0.0)
+{
+    // element of each group for the diffusion coefficient
+    std::vector<long> group_element(mmp_vector.size(), -1);
+    std::vector<MeshLib::CElem*> const& elements = flow_pcs->m_msh->ele_vector;
+    for (long e = (long)elements.size() - 1; e >= 0; e--)
+    {
+        const std::size_t group = elements[e]->GetPatchIndex();
+        if (group < group_element.size())
+            group_element[group] = e;
+    }
+
+    CompProperties* m_cp =
+        transport_pcs ? cp_vec[transport_pcs->pcs_component_number] : NULL;
+    double g[3] = {0., 0., 0.};
+    const double theta = 0.0;
+    for (std::size_t i = 0; i < mmp_vector.size(); i++)
+    {
+        CMediumProperties* m_mmp = mmp_vector[i];
+        m_mmp->m_pcs = flow_pcs;
+        _porosity[i] = m_mmp->Porosity(m_mmp->Fem_Ele_Std);
+        _dispersivity[i] = m_mmp->mass_dispersion_longitudinal;
+        if (m_cp && group_element[i] >= 0)
+        {
+            // without tortuosity model the diffusion coefficient is used as is
+            const double tortuosity =
+                (m_mmp->tortuosity_model > 0)
+                    ? m_mmp->TortuosityFunction(group_element[i], g, theta)
+                    : 1.0;
+            _pore_diffusion[i] =
+                tortuosity * m_cp->CalcDiffusionCoefficientCP(
+                                 group_element[i], theta, transport_pcs);
+        }
+    }
+}
+
+StabilityLimits StabilityAnalysis::evaluate(const double dt) const
+{
+    std::vector<MeshLib::CElem*> const& elements = _flow_pcs->m_msh->ele_vector;
+    const long n_elements = (long)elements.size();
+    const int pcs_no = _flow_pcs->pcs_number;
+
+    MinLoc courant, diffusion, peclet;  // peclet: minimum of -Pe
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        MinLoc local_courant, local_diffusion, local_peclet;
+        double velocity[3] = {0., 0., 0.};
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (long e = 0; e < n_elements; e++)
+        {
+            MeshLib::CElem* elem = elements[e];
+            const double length = elem->GetRepLength();
+            const std::size_t group = elem->GetPatchIndex();
+            ele_gp_value[e]->getIPvalue_vec(pcs_no, velocity);
+            double advective_velocity =
+                MBtrgVec(velocity, 3) / _porosity[group];
+            // kg44 avoid zero velocity..otherwise stable_time_step is a
+            // problem
+            if (advective_velocity < DBL_EPSILON)
+                advective_velocity = DBL_EPSILON;
+            elem->SetCourant(dt * advective_velocity / length);
+            local_courant.update(length / advective_velocity, e);
+
+            const double D = _pore_diffusion[group] +
+                             _dispersivity[group] * advective_velocity;
+            if (D > 0.0)
+            {
+                local_diffusion.update(0.5 * length * length / D, e);
+                local_peclet.update(-advective_velocity * length / D, e);
+            }
+        }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            courant.update(local_courant.value, local_courant.element);
+            diffusion.update(local_diffusion.value, local_diffusion.element);
+            peclet.update(local_peclet.value, local_peclet.element);
+        }
+    }
+
+    StabilityLimits limits;
+    limits.courant_time_step = courant.value;
+    limits.courant_element = courant.element;
+    limits.diffusion_time_step = diffusion.value;
+    limits.diffusion_element = diffusion.element;
+    limits.max_peclet = (peclet.element < 0) ? 0.0 : -peclet.value;
+    limits.peclet_element = peclet.element;
+    if (diffusion.value < courant.value)
+    {
+        limits.recommended_time_step = diffusion.value;
+        limits.critical_element = diffusion.element;
+    }
+    else
+    {
+        limits.recommended_time_step = courant.value;
+        limits.critical_element = courant.element;
+    }
+    return limits;
+}
+}  // namespace FiniteElement
@@ -0,0 +1,75 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class StabilityAnalysis
+
+   Element-wise stability limits of the transport discretization for the
+   adaptive time step control.
+*/
+#ifndef STABILITY_ANALYSIS_INC
+#define STABILITY_ANALYSIS_INC
+
+#include <vector>
+
+class CRFProcess;
+
+namespace FiniteElement
+{
+/// Stability limits of one time step and the elements where they occur.
+struct StabilityLimits
+{
+    /// Largest step with a Courant number of one
+    double courant_time_step;
+    long courant_element;
+    /// Largest step with a diffusion (Neumann) number of 1/2
+    double diffusion_time_step;
+    long diffusion_element;
+    /// Largest grid Peclet number
+    double max_peclet;
+    long peclet_element;
+    /// Minimum of the Courant and the diffusion time step
+    double recommended_time_step;
+    long critical_element;
+};
+
+/*!
+   \brief Courant, grid Peclet and diffusion number of all elements in one
+   pass.
+
+   With the pore velocity v = |q| / n, the representative element length L
+   and the pore diffusion/dispersion coefficient D = tau D_m + alpha_L v,
+   the element limits are
+   - Courant number Cr = v dt / L,
+   - grid Peclet number Pe = v L / D,
+   - diffusion number Ne = D dt / L^2.
+
+   Porosity, longitudinal dispersivity and pore diffusion coefficient are
+   evaluated once per material group when the object is created, so the
+   element loop only reads the velocities and can run in parallel.
+*/
+class StabilityAnalysis
+{
+public:
+    /// flow_pcs provides the velocities, transport_pcs (may be NULL) the
+    /// molecular diffusion coefficient.
+    StabilityAnalysis(CRFProcess* flow_pcs, CRFProcess* transport_pcs);
+
+    /// Computes the limits for the time step dt and stores the Courant
+    /// number of each element.
+    StabilityLimits evaluate(const double dt) const;
+
+private:
+    CRFProcess* _flow_pcs;
+    std::vector<double> _porosity;
+    std::vector<double> _dispersivity;
+    std::vector<double> _pore_diffusion;
+};
+}  // namespace FiniteElement
+#endif
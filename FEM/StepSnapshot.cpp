@@ -0,0 +1,85 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class StepSnapshot
+*/
+#include "StepSnapshot.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace FiniteElement
+{
+StepSnapshot::StepSnapshot() : _n_bytes(0), _has_checkpoint(false) {}
+
+void StepSnapshot::clear()
+{
+    _regions.clear();
+    _vectors.clear();
+    _n_bytes = 0;
+    _has_checkpoint = false;
+}
+
+void StepSnapshot::addBytes(void* data, std::size_t n_bytes)
+{
+    if (!data || n_bytes == 0)
+        return;
+    char* const begin = static_cast<char*>(data);
+    if (!_regions.empty())
+    {
+        Region& last = _regions.back();
+        if (last.data + last.n_bytes == begin)
+        {
+            last.n_bytes += n_bytes;
+            _n_bytes += n_bytes;
+            _has_checkpoint = false;
+            return;
+        }
+    }
+    Region region = {begin, n_bytes};
+    _regions.push_back(region);
+    _n_bytes += n_bytes;
+    _has_checkpoint = false;
+}
+
+void StepSnapshot::checkpoint()
+{
+    if (_buffer.size() < _n_bytes)
+        _buffer.resize(_n_bytes);
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < _regions.size(); i++)
+    {
+        std::memcpy(&_buffer[offset], _regions[i].data, _regions[i].n_bytes);
+        offset += _regions[i].n_bytes;
+    }
+    _has_checkpoint = true;
+}
+
+void StepSnapshot::restore() const
+{
+    if (!_has_checkpoint)
+        return;
+    for (std::size_t i = 0; i < _vectors.size(); i++)
+        if (!_vectors[i].unchanged(_vectors[i]))
+        {
+            std::cout << "Error in StepSnapshot::restore: a registered "
+                         "vector was resized since the checkpoint"
+                      << "\n";
+            exit(1);
+        }
+    std::size_t offset = 0;
+    for (std::size_t i = 0; i < _regions.size(); i++)
+    {
+        std::memcpy(_regions[i].data, &_buffer[offset], _regions[i].n_bytes);
+        offset += _regions[i].n_bytes;
+    }
+}
+}  // namespace FiniteElement
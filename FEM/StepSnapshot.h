@@ -0,0 +1,107 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class StepSnapshot
+
+   Copy of the state that a rejected time step has to get back, taken at
+   the beginning of the step.
+*/
+#ifndef STEP_SNAPSHOT_INC
+#define STEP_SNAPSHOT_INC
+
+#include <cstddef>
+#include <vector>
+
+namespace FiniteElement
+{
+/*!
+   \brief Checkpoint and rollback of registered memory regions.
+
+   State holders register the memory regions that a time step changes and
+   that the reverse copy of the node values does not restore (Gauss point
+   values, stresses and internal variables of the deformation, chemistry
+   arrays, particles).
+   checkpoint() copies all regions into one contiguous buffer, restore()
+   copies them back. Regions that follow each other in memory are merged on
+   registration.
+*/
+class StepSnapshot
+{
+public:
+    StepSnapshot();
+
+    /// Removes all regions; the buffer is kept for the next checkpoint.
+    void clear();
+
+    /// Registers n values starting at data.
+    template <typename T>
+    void add(T* data, std::size_t n)
+    {
+        addBytes(static_cast<void*>(data), n * sizeof(T));
+    }
+
+    /// Registers the elements of a vector. The vector must be neither
+    /// resized nor reallocated between checkpoint() and restore(); restore()
+    /// checks this and aborts the run otherwise.
+    template <typename T>
+    void add(std::vector<T>& v)
+    {
+        if (v.empty())
+            return;
+        VectorCheck check = {&v, &v[0], v.size(), &vectorUnchanged<T>};
+        _vectors.push_back(check);
+        addBytes(static_cast<void*>(&v[0]), v.size() * sizeof(T));
+    }
+
+    void addBytes(void* data, std::size_t n_bytes);
+
+    /// Saves the current contents of all regions.
+    void checkpoint();
+
+    /// Writes the saved contents back. The regions must not have been
+    /// reallocated since the checkpoint.
+    void restore() const;
+
+    std::size_t getNumberOfBytes() const { return _n_bytes; }
+    std::size_t getNumberOfRegions() const { return _regions.size(); }
+    bool hasCheckpoint() const { return _has_checkpoint; }
+
+private:
+    struct Region
+    {
+        char* data;
+        std::size_t n_bytes;
+    };
+
+    struct VectorCheck
+    {
+        const void* vector;
+        const void* data;
+        std::size_t size;
+        bool (*unchanged)(const VectorCheck&);
+    };
+
+    template <typename T>
+    static bool vectorUnchanged(const VectorCheck& check)
+    {
+        const std::vector<T>& v =
+            *static_cast<const std::vector<T>*>(check.vector);
+        return v.size() == check.size && &v[0] == check.data;
+    }
+
+    std::vector<Region> _regions;
+    std::vector<VectorCheck> _vectors;
+    std::vector<char> _buffer;
+    std::size_t _n_bytes;
+    bool _has_checkpoint;
+};
+}  // namespace FiniteElement
+
+#endif
@@ -0,0 +1,443 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of the ODE solvers of the kinetic
+   reactions
+*/
+#include "StiffODESolver.h"
+
+#include <cmath>
+
+namespace FiniteElement
+{
+namespace
+{
+const double safety_factor = 0.9;
+const double min_step_factor = 0.2;
+const double max_step_factor = 6.0;
+/// Trials of a step before it is given up
+const int max_step_trials = 40;
+
+/// Dense LU with partial pivoting, used where the factorisation over the
+/// pattern meets a vanishing pivot.
+bool denseFactorize(std::vector<double>& a, std::vector<int>& permutation,
+                    int n)
+{
+    for (int k = 0; k < n; k++)
+    {
+        int p = k;
+        for (int i = k + 1; i < n; i++)
+        {
+            if (std::fabs(a[i * n + k]) > std::fabs(a[p * n + k]))
+                p = i;
+        }
+        if (a[p * n + k] == 0.0)
+            return false;
+        permutation[k] = p;
+        if (p != k)
+        {
+            for (int j = 0; j < n; j++)
+                std::swap(a[k * n + j], a[p * n + j]);
+        }
+        for (int i = k + 1; i < n; i++)
+        {
+            const double factor = (a[i * n + k] /= a[k * n + k]);
+            if (factor == 0.0)
+                continue;
+            for (int j = k + 1; j < n; j++)
+                a[i * n + j] -= factor * a[k * n + j];
+        }
+    }
+    return true;
+}
+
+void denseSolve(std::vector<double> const& a,
+                std::vector<int> const& permutation, int n, double* b)
+{
+    for (int k = 0; k < n; k++)
+    {
+        std::swap(b[k], b[permutation[k]]);
+        for (int i = k + 1; i < n; i++)
+            b[i] -= a[i * n + k] * b[k];
+    }
+    for (int k = n - 1; k >= 0; k--)
+    {
+        double sum = b[k];
+        for (int j = k + 1; j < n; j++)
+            sum -= a[k * n + j] * b[j];
+        b[k] = sum / a[k * n + k];
+    }
+}
+
+// Rodas3 in the form of Hairer and Wanner. Row i of a and c holds the
+// coefficients of the stages before stage i.
+const double rodas3_gamma = 0.5;
+const double rodas3_a[4][3] = {
+    {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {2.0, 0.0, 1.0}};
+const double rodas3_c[4][3] = {{0.0, 0.0, 0.0},
+                               {4.0, 0.0, 0.0},
+                               {1.0, -1.0, 0.0},
+                               {1.0, -1.0, -8.0 / 3.0}};
+const double rodas3_alpha[4] = {0.0, 0.0, 1.0, 1.0};
+const double rodas3_gamma_i[4] = {0.5, 1.5, 0.0, 0.0};
+const double rodas3_m[4] = {2.0, 0.0, 1.0, 1.0};
+const double rodas3_e[4] = {0.0, 0.0, 0.0, 1.0};
+const int rodas3_error_order = 3;
+
+// Dormand-Prince 5(4): nodes, coefficients, weights of the fifth order
+// solution and differences to the weights of the fourth order solution.
+const double dopri_c[7] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0,
+                           8.0 / 9.0, 1.0, 1.0};
+const double dopri_a[7][6] = {
+    {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0},
+    {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0},
+    {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0,
+     0.0, 0.0},
+    {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+     -5103.0 / 18656.0, 0.0},
+    {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0,
+     11.0 / 84.0}};
+const double dopri_b[7] = {35.0 / 384.0,     0.0,          500.0 / 1113.0,
+                           125.0 / 192.0,    -2187.0 / 6784.0,
+                           11.0 / 84.0,      0.0};
+const double dopri_e[7] = {71.0 / 57600.0,      0.0,
+                           -71.0 / 16695.0,     71.0 / 1920.0,
+                           -17253.0 / 339200.0, 22.0 / 525.0,
+                           -1.0 / 40.0};
+const int dopri_error_order = 5;
+}  // namespace
+
+ODEErrorControl::ODEErrorControl(double rtol, double const* atol, int n,
+                                 int order)
+    : _rtol(rtol), _atol(atol), _n(n), _exponent(1.0 / order)
+{
+}
+
+double ODEErrorControl::error(double const* y0, double const* y1,
+                              double const* e) const
+{
+    double sum = 0.0;
+    for (int i = 1; i <= _n; i++)
+    {
+        const double scale =
+            _atol[i] + _rtol * std::max(std::fabs(y0[i]), std::fabs(y1[i]));
+        const double r = e[i] / scale;
+        sum += r * r;
+    }
+    return std::sqrt(sum / _n);
+}
+
+double ODEErrorControl::factor(double error, bool rejected_before) const
+{
+    double f = max_step_factor;
+    if (error > 0.0)
+        f = std::min(max_step_factor,
+                     std::max(min_step_factor,
+                              safety_factor * std::pow(error, -_exponent)));
+    if (rejected_before)
+        f = std::min(f, 1.0);
+    return f;
+}
+
+void SparseLUPattern::reset(int n)
+{
+    _n = n;
+    _nonzero.assign(static_cast<std::size_t>(n) * n, 0);
+    for (int i = 0; i < n; i++)
+        _nonzero[i * n + i] = 1;
+    analyse();
+}
+
+bool SparseLUPattern::merge(double** dfdy)
+{
+    bool extended = false;
+    for (int i = 0; i < _n; i++)
+    {
+        for (int j = 0; j < _n; j++)
+        {
+            if (dfdy[i + 1][j + 1] != 0.0 && !_nonzero[i * _n + j])
+            {
+                _nonzero[i * _n + j] = 1;
+                extended = true;
+            }
+        }
+    }
+    if (extended)
+        analyse();
+    return extended;
+}
+
+void SparseLUPattern::analyse()
+{
+    std::vector<char> fill(_nonzero);
+    _lower.assign(_n, std::vector<int>());
+    _upper.assign(_n, std::vector<int>());
+    for (int k = 0; k < _n; k++)
+    {
+        for (int j = k + 1; j < _n; j++)
+        {
+            if (fill[k * _n + j])
+                _upper[k].push_back(j);
+        }
+        for (int i = k + 1; i < _n; i++)
+        {
+            if (!fill[i * _n + k])
+                continue;
+            _lower[k].push_back(i);
+            for (std::size_t u = 0; u < _upper[k].size(); u++)
+                fill[i * _n + _upper[k][u]] = 1;
+        }
+    }
+}
+
+bool SparseLUPattern::factorize(std::vector<double>& a) const
+{
+    for (int k = 0; k < _n; k++)
+    {
+        double row_scale = 0.0;
+        for (int j = 0; j < _n; j++)
+            row_scale = std::max(row_scale, std::fabs(a[k * _n + j]));
+        const double pivot = a[k * _n + k];
+        if (std::fabs(pivot) <= 1.0e-12 * row_scale)
+            return false;
+
+        std::vector<int> const& lower = _lower[k];
+        std::vector<int> const& upper = _upper[k];
+        double const* const row_k = &a[k * _n];
+        for (std::size_t l = 0; l < lower.size(); l++)
+        {
+            double* const row_i = &a[lower[l] * _n];
+            const double factor = (row_i[k] /= pivot);
+            for (std::size_t u = 0; u < upper.size(); u++)
+                row_i[upper[u]] -= factor * row_k[upper[u]];
+        }
+    }
+    return true;
+}
+
+void SparseLUPattern::solve(std::vector<double> const& a, double* b) const
+{
+    for (int k = 0; k < _n; k++)
+    {
+        std::vector<int> const& lower = _lower[k];
+        for (std::size_t l = 0; l < lower.size(); l++)
+            b[lower[l]] -= a[lower[l] * _n + k] * b[k];
+    }
+    for (int k = _n - 1; k >= 0; k--)
+    {
+        std::vector<int> const& upper = _upper[k];
+        double sum = b[k];
+        for (std::size_t u = 0; u < upper.size(); u++)
+            sum -= a[k * _n + upper[u]] * b[upper[u]];
+        b[k] = sum / a[k * _n + k];
+    }
+}
+
+RosenbrockSolver::RosenbrockSolver(int n, ODERightHandSide rhs,
+                                   ODEJacobian jacobian, long node)
+    : _n(n),
+      _rhs(rhs),
+      _jacobian(jacobian),
+      _node(node),
+      _jacobian_storage(static_cast<std::size_t>(n + 1) * (n + 1), 0.0),
+      _jacobian_rows(n + 1),
+      _dfdt(n + 1, 0.0),
+      _matrix(static_cast<std::size_t>(n) * n, 0.0),
+      _permutation(n, 0),
+      _dense(false),
+      _u(static_cast<std::size_t>(n_stages) * n, 0.0),
+      _y0(n + 1, 0.0),
+      _y_stage(n + 1, 0.0),
+      _f_stage(n + 1, 0.0),
+      _error(n + 1, 0.0)
+{
+    for (int i = 0; i <= n; i++)
+        _jacobian_rows[i] = &_jacobian_storage[i * (n + 1)];
+    _pattern.reset(n);
+}
+
+/// Builds and factorises (1/(gamma h)) I - J.
+bool RosenbrockSolver::factorize(double h)
+{
+    const double diagonal = 1.0 / (rodas3_gamma * h);
+    for (int i = 0; i < _n; i++)
+    {
+        for (int j = 0; j < _n; j++)
+            _matrix[i * _n + j] = -_jacobian_rows[i + 1][j + 1];
+        _matrix[i * _n + i] += diagonal;
+    }
+    _matrix_copy = _matrix;
+    _dense = !_pattern.factorize(_matrix);
+    if (!_dense)
+        return true;
+    _matrix.swap(_matrix_copy);
+    return denseFactorize(_matrix, _permutation, _n);
+}
+
+void RosenbrockSolver::solve(double* b) const
+{
+    if (_dense)
+        denseSolve(_matrix, _permutation, _n, b);
+    else
+        _pattern.solve(_matrix, b);
+}
+
+bool RosenbrockSolver::step(double y[], double const dydt[], double& t,
+                            double h, double rtol, double const atol[],
+                            double& h_done, double& h_next)
+{
+    const ODEErrorControl control(rtol, atol, _n, rodas3_error_order);
+    std::copy(y, y + _n + 1, _y0.begin());
+    // The Jacobian is evaluated once and kept for the retried step sizes.
+    _jacobian(t, &_y0[0], &_dfdt[0], &_jacobian_rows[0], _n, _node);
+    _pattern.merge(&_jacobian_rows[0]);
+
+    bool rejected = false;
+    for (int trial = 0; trial < max_step_trials; trial++)
+    {
+        if (t + h == t)
+            break;
+        if (!factorize(h))
+        {
+            h *= min_step_factor;
+            rejected = true;
+            continue;
+        }
+
+        for (int s = 0; s < n_stages; s++)
+        {
+            // Stages at the initial state reuse f(t, y)
+            bool initial_state = (rodas3_alpha[s] == 0.0);
+            for (int j = 0; j < s; j++)
+                initial_state = initial_state && (rodas3_a[s][j] == 0.0);
+            double const* f = dydt;
+            if (!initial_state)
+            {
+                for (int i = 1; i <= _n; i++)
+                {
+                    double value = _y0[i];
+                    for (int j = 0; j < s; j++)
+                        value += rodas3_a[s][j] * _u[j * _n + i - 1];
+                    _y_stage[i] = value;
+                }
+                _rhs(t + rodas3_alpha[s] * h, &_y_stage[0], &_f_stage[0], _n,
+                     _node, h);
+                f = &_f_stage[0];
+            }
+
+            double* const u = &_u[s * _n];
+            for (int i = 0; i < _n; i++)
+            {
+                double value = f[i + 1] + rodas3_gamma_i[s] * h * _dfdt[i + 1];
+                for (int j = 0; j < s; j++)
+                    value += rodas3_c[s][j] / h * _u[j * _n + i];
+                u[i] = value;
+            }
+            solve(u);
+        }
+
+        for (int i = 1; i <= _n; i++)
+        {
+            double value = _y0[i];
+            double error = 0.0;
+            for (int s = 0; s < n_stages; s++)
+            {
+                value += rodas3_m[s] * _u[s * _n + i - 1];
+                error += rodas3_e[s] * _u[s * _n + i - 1];
+            }
+            _y_stage[i] = value;
+            _error[i] = error;
+        }
+        const double error = control.error(&_y0[0], &_y_stage[0], &_error[0]);
+
+        if (error <= 1.0)
+        {
+            std::copy(_y_stage.begin() + 1, _y_stage.end(), y + 1);
+            t += h;
+            h_done = h;
+            h_next = h * control.factor(error, rejected);
+            return true;
+        }
+        // A NaN error means the trial left the range of the rates
+        h *= (error != error) ? min_step_factor : control.factor(error, true);
+        rejected = true;
+    }
+    return false;
+}
+
+DormandPrinceSolver::DormandPrinceSolver(int n, ODERightHandSide rhs,
+                                         long node)
+    : _n(n),
+      _rhs(rhs),
+      _node(node),
+      _k(static_cast<std::size_t>(n_stages) * (n + 1), 0.0),
+      _y0(n + 1, 0.0),
+      _y_stage(n + 1, 0.0),
+      _error(n + 1, 0.0)
+{
+}
+
+bool DormandPrinceSolver::step(double y[], double const dydt[], double& t,
+                               double h, double rtol, double const atol[],
+                               double& h_done, double& h_next)
+{
+    const ODEErrorControl control(rtol, atol, _n, dopri_error_order);
+    const std::size_t stride = _n + 1;
+    std::copy(y, y + _n + 1, _y0.begin());
+    std::copy(dydt, dydt + _n + 1, _k.begin());
+
+    bool rejected = false;
+    for (int trial = 0; trial < max_step_trials; trial++)
+    {
+        if (t + h == t)
+            break;
+        for (int s = 1; s < n_stages; s++)
+        {
+            for (int i = 1; i <= _n; i++)
+            {
+                double increment = 0.0;
+                for (int j = 0; j < s; j++)
+                    increment += dopri_a[s][j] * _k[j * stride + i];
+                _y_stage[i] = _y0[i] + h * increment;
+            }
+            _rhs(t + dopri_c[s] * h, &_y_stage[0], &_k[s * stride], _n, _node,
+                 h);
+        }
+
+        for (int i = 1; i <= _n; i++)
+        {
+            double increment = 0.0;
+            double error = 0.0;
+            for (int s = 0; s < n_stages; s++)
+            {
+                increment += dopri_b[s] * _k[s * stride + i];
+                error += dopri_e[s] * _k[s * stride + i];
+            }
+            _y_stage[i] = _y0[i] + h * increment;
+            _error[i] = h * error;
+        }
+        const double error = control.error(&_y0[0], &_y_stage[0], &_error[0]);
+
+        if (error <= 1.0)
+        {
+            std::copy(_y_stage.begin() + 1, _y_stage.end(), y + 1);
+            t += h;
+            h_done = h;
+            h_next = h * control.factor(error, rejected);
+            return true;
+        }
+        h *= (error != error) ? min_step_factor : control.factor(error, true);
+        rejected = true;
+    }
+    return false;
+}
+}  // namespace FiniteElement
@@ -0,0 +1,250 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of the ODE solvers of the kinetic reactions
+
+   A Rosenbrock solver for stiff and an explicit Runge-Kutta solver for
+   non-stiff systems y' = f(t, y), both with embedded error estimates and
+   step size control.
+*/
+#ifndef STIFF_ODE_SOLVER_INC
+#define STIFF_ODE_SOLVER_INC
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace FiniteElement
+{
+/// Right hand side dydt = f(t, y) of an ODE system. The vectors are 1-based
+/// (y[1..n]) as in the kinetic reaction routines; h is the current step
+/// size, node the mesh node the system belongs to.
+typedef void (*ODERightHandSide)(double t, double y[], double dydt[], int n,
+                                 long node, double h);
+/// Jacobian dfdy[1..n][1..n] and partial time derivative dfdt[1..n] of f.
+typedef void (*ODEJacobian)(double t, double y[], double dfdt[],
+                            double** dfdy, int n, long node);
+
+/*!
+   \brief Error control shared by the ODE solvers.
+
+   The error of a step is the root mean square of the error estimates
+   e_i / (atol_i + rtol * max(|y0_i|, |y1_i|)). A step is accepted if the
+   error is not larger than 1. The next step size is the current one scaled
+   by safety * error^(-1/q), q the order of the error estimate plus one,
+   limited to [min_factor, max_factor]; after a rejection the step size is
+   not increased.
+*/
+class ODEErrorControl
+{
+public:
+    /// \param atol absolute tolerances atol[1..n]
+    /// \param order order of the error estimate plus one
+    ODEErrorControl(double rtol, double const* atol, int n, int order);
+
+    /// Error of a step from y0 to y1 with the error estimates e; all
+    /// vectors are 1-based.
+    double error(double const* y0, double const* y1, double const* e) const;
+    /// Factor for the next step size
+    double factor(double error, bool rejected_before) const;
+
+private:
+    const double _rtol;
+    double const* const _atol;
+    const int _n;
+    const double _exponent;
+};
+
+/*!
+   \brief Symbolic LU factorisation over the sparsity pattern of a Jacobian.
+
+   The sparsity of the reaction Jacobian depends only on the reaction
+   network. The fill-in is computed once and kept; entries that appear later
+   (e.g. a Monod term that was zero at first) are merged into the pattern.
+   The numeric factorisation runs without pivoting over the pattern; if a
+   pivot degenerates, the matrix is factorised densely with partial
+   pivoting.
+*/
+class SparseLUPattern
+{
+public:
+    SparseLUPattern() : _n(0) {}
+
+    void reset(int n);
+    /// Merges the nonzeros of a 1-based Jacobian into the pattern. Returns
+    /// true if the pattern had to be extended.
+    bool merge(double** dfdy);
+    /// In-place LU of the dense row-major matrix a restricted to the
+    /// pattern. Returns false if a pivot degenerates.
+    bool factorize(std::vector<double>& a) const;
+    /// Solves LU x = b for the factors from factorize(); b is 0-based.
+    void solve(std::vector<double> const& a, double* b) const;
+
+private:
+    void analyse();
+
+    int _n;
+    std::vector<char> _nonzero;
+    /// Rows below and columns right of the pivot, for each pivot
+    std::vector<std::vector<int> > _lower;
+    std::vector<std::vector<int> > _upper;
+};
+
+/*!
+   \brief Rosenbrock solver for stiff ODE systems.
+
+   Rodas3 (Sandu et al., Atmospheric Environment 31, 1997), a stiffly
+   accurate and L-stable Rosenbrock method of order 3 with four stages and
+   an embedded method of order 2. It is written in the form without matrix
+   vector products of Hairer and Wanner (Solving Ordinary Differential
+   Equations II, Sec. IV.7): the stage vectors u_i solve
+
+     (1/(gamma h) I - J) u_i = f(t + alpha_i h, y + sum_j a_ij u_j)
+                               + sum_j c_ij / h u_j + gamma_i h df/dt
+
+   and y1 = y + sum_i m_i u_i with the error estimate sum_i e_i u_i. The
+   work arrays belong to the solver object, so solvers of different threads
+   do not share any state.
+*/
+class RosenbrockSolver
+{
+public:
+    RosenbrockSolver(int n, ODERightHandSide rhs, ODEJacobian jacobian,
+                     long node);
+
+    /// Advances y[1..n] from t by one accepted step, trying the step size h
+    /// first and smaller ones if the error is too large. dydt is f(t, y),
+    /// atol[1..n] are the absolute tolerances. Returns false, with y and t
+    /// unchanged, if no step size is accepted.
+    bool step(double y[], double const dydt[], double& t, double h,
+              double rtol, double const atol[], double& h_done,
+              double& h_next);
+
+private:
+    bool factorize(double h);
+    void solve(double* b) const;
+
+    static const int n_stages = 4;
+
+    const int _n;
+    const ODERightHandSide _rhs;
+    const ODEJacobian _jacobian;
+    const long _node;
+
+    std::vector<double> _jacobian_storage;
+    std::vector<double*> _jacobian_rows;
+    std::vector<double> _dfdt;
+    std::vector<double> _matrix;
+    std::vector<double> _matrix_copy;
+    std::vector<int> _permutation;
+    bool _dense;
+    SparseLUPattern _pattern;
+
+    /// Stage vectors, 0-based, stage by stage
+    std::vector<double> _u;
+    std::vector<double> _y0;
+    std::vector<double> _y_stage;
+    std::vector<double> _f_stage;
+    std::vector<double> _error;
+};
+
+/*!
+   \brief Explicit Runge-Kutta solver for non-stiff ODE systems.
+
+   The Dormand-Prince 5(4) pair (Hairer, Norsett and Wanner, Solving
+   Ordinary Differential Equations I, Sec. II.5), continued with the fifth
+   order solution.
+*/
+class DormandPrinceSolver
+{
+public:
+    DormandPrinceSolver(int n, ODERightHandSide rhs, long node);
+
+    /// See RosenbrockSolver::step()
+    bool step(double y[], double const dydt[], double& t, double h,
+              double rtol, double const atol[], double& h_done,
+              double& h_next);
+
+private:
+    static const int n_stages = 7;
+
+    const int _n;
+    const ODERightHandSide _rhs;
+    const long _node;
+
+    /// Stage derivatives, 1-based, stage by stage
+    std::vector<double> _k;
+    std::vector<double> _y0;
+    std::vector<double> _y_stage;
+    std::vector<double> _error;
+};
+
+/*!
+   \brief Integrates y[1..n] from t0 to t1 with one of the solvers above.
+
+   \param h initial step size
+   \param h_min smallest step size allowed before the end of the interval
+   \param h_next step size proposed for a following integration
+   \param n_unreduced number of steps taken with the step size tried first
+   \param n_reduced number of steps taken after a reduction of the step size
+   \return false if a step fails, the step size falls below h_min or
+   max_steps steps do not reach t1. y is only changed on success.
+*/
+template <typename Solver>
+bool integrateODE(Solver& solver, ODERightHandSide rhs, double y[], int n,
+                  double t0, double t1, double rtol, double const atol[],
+                  double h, double h_min, long node, int max_steps,
+                  double& h_next, int& n_unreduced, int& n_reduced)
+{
+    std::vector<double> y_current(y, y + n + 1);
+    std::vector<double> dydt(n + 1, 0.0);
+    const double direction = (t1 >= t0) ? 1.0 : -1.0;
+    h = (h < 0.0 ? -h : h) * direction;
+    n_unreduced = 0;
+    n_reduced = 0;
+    h_next = h;
+    if (t1 == t0)
+        return true;
+
+    double t = t0;
+    for (int i = 0; i < max_steps; i++)
+    {
+        // The last step ends exactly at t1
+        const double remaining = t1 - t;
+        const bool last = (h * direction >= remaining * direction);
+        const double h_try = last ? remaining : h;
+
+        rhs(t, &y_current[0], &dydt[0], n, node, h_try);
+        double h_done = 0.0;
+        if (!solver.step(&y_current[0], &dydt[0], t, h_try, rtol, atol,
+                         h_done, h))
+            return false;
+        if (h_done == h_try)
+            n_unreduced++;
+        else
+            n_reduced++;
+
+        if (last && h_done == h_try)
+        {
+            std::copy(y_current.begin() + 1, y_current.end(), y + 1);
+            // The last step may have been shortened to end at t1
+            if (h * direction > h_next * direction)
+                h_next = h;
+            return true;
+        }
+        if (h * direction <= h_min)
+            return false;
+        h_next = h;
+    }
+    return false;
+}
+}  // namespace FiniteElement
+
+#endif
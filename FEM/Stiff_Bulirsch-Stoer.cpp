@@ -10,92 +10,119 @@
 #include "Stiff_Bulirsch-Stoer.h"
 #include "stdlib.h"
 #include <iostream>
+#include <vector>
+
+#include "StiffODESolver.h"
 
 /* interne Deklarationen */
 double* dvector(long nl, long nh);
 void free_dvector(double* v, long nl, long nh);
-void stifbs(double y[], double dydx[], int nv, double* xx, double htry,
-            double eps, double yscal[], double* hdid, double* hnext,
-            void (*derivs)(double, double[], double[], int, long, double));
-void odeint(
+bool stifbs(double y[], double dydx[], int nv, double* xx, double htry,
+            double eps, double atol[], double* hdid, double* hnext,
+            void (*derivs)(double, double[], double[], int, long, double),
+            long node);
+bool rkqs(double y[], double dydx[], int n, double* x, double htry, double eps,
+          double atol[], double* hdid, double* hnext,
+          void (*derivs)(double, double[], double[], int, long, double),
+          long node);
+bool odeint(
     double ystart[], int nvar, double x1, double x2, double eps, double h1,
-    double hmin, double* hnext, int* nok, int* nbad,
+    double hmin, double* nexth, int* nok, int* nbad,
     void (*derivs)(double, double[], double[], int, long, double),
     bool (*stifbs)(double[], double[], int, double*, double, double, double[],
                    double*, double*,
-                   void (*)(double, double[], double[], int, long, double)),
+                   void (*)(double, double[], double[], int, long, double),
+                   long),
     bool (*rkqs)(double[], double[], int, double*, double, double, double[],
                  double*, double*,
                  void (*)(double, double[], double[], int, long, double), long),
-    long, int);
+    long node, int SolverType);
 
-double* dvector(long /*nl*/, long /*nh*/)
+/* Vectors are addressed v[nl..nh]; nl is 0 or 1 for all callers, so the
+ * storage simply starts at index 0 and the first nl entries stay unused. */
+double* dvector(long nl, long nh)
 {
-    // Removed
-    std::cout << "Error: dvector not implemented!" << std::endl;
-    return NULL;
+    if (nl < 0 || nh < nl)
+    {
+        std::cout << "Error: dvector called with invalid range [" << nl << ","
+                  << nh << "]" << std::endl;
+        abort();
+    }
+    return new double[nh + 1]();
 }
 
-void free_dvector(double* /*v*/, long /*nl*/, long /*nh*/)
+void free_dvector(double* v, long /*nl*/, long /*nh*/)
 {
-    // Removed
-    std::cout << "Error: free_dvector not implemented!" << std::endl;
+    delete[] v;
 }
 
-/* Input: y=current_conc, dydx=their_derivs, xx=current_time,
- * htry=suggested_stepsize     */
-/* Ouput: y=updated_conc,  xx=end_time, hdid=achieved_stepsize , hnext=
- * estimated_next_ss */
+namespace
+{
+typedef bool (*ODEStepper)(double[], double[], int, double*, double, double,
+                           double[], double*, double*,
+                           void (*)(double, double[], double[], int, long,
+                                    double),
+                           long);
+
+/// Stepper function given to odeint, as a solver for integrateODE
+class ODEStepperFunction
+{
+public:
+    ODEStepperFunction(ODEStepper stepper, int n,
+                       FiniteElement::ODERightHandSide rhs, long node)
+        : _stepper(stepper), _n(n), _rhs(rhs), _node(node)
+    {
+    }
+    bool step(double y[], double const dydt[], double& t, double h,
+              double rtol, double const atol[], double& h_done,
+              double& h_next)
+    {
+        return _stepper(y, const_cast<double*>(dydt), _n, &t, h, rtol,
+                        const_cast<double*>(atol), &h_done, &h_next, _rhs,
+                        _node);
+    }
+
+private:
+    const ODEStepper _stepper;
+    const int _n;
+    const FiniteElement::ODERightHandSide _rhs;
+    const long _node;
+};
+}  // namespace
+
+/* One step of the stiff solver (Rosenbrock method Rodas3, see
+ * StiffODESolver.h). Input: y=current_conc, dydx=their_derivs,
+ * xx=current_time, htry=suggested_stepsize, eps=relative tolerance,
+ * atol=absolute tolerances. Output: y=updated_conc, xx=end_time,
+ * hdid=achieved_stepsize, hnext=estimated_next_ss. The name is kept from
+ * the former Bulirsch-Stoer step. */
 bool stifbs(double y[], double dydx[], int nv, double* xx, double htry,
-            double eps, double yscal[], double* hdid, double* hnext,
+            double eps, double atol[], double* hdid, double* hnext,
             void (*derivs)(double, double[], double[], int, long, double),
             long node)
 {
-    // The following void type casting is just to supress warnings
-    // Once this function is filled with using these arguments, these casting
-    // should be removed.
-    (void)y;
-    (void)dydx;
-    (void)nv;
-    (void)xx;
-    (void)htry;
-    (void)eps;
-    (void)yscal;
-    (void)hdid;
-    (void)hnext;
-    (void)derivs;
-    (void)node;
-
-    // Removed
-    std::cout << "Error: stifbs not implemented!" << std::endl;
-    return false;
+    FiniteElement::RosenbrockSolver solver(nv, derivs, jacobn, node);
+    return solver.step(y, dydx, *xx, htry, eps, atol, *hdid, *hnext);
 }
 
+/* One step of the explicit solver (Dormand-Prince 5(4)) for non-stiff
+ * reaction networks (SolverType 2), arguments as for stifbs. */
 bool rkqs(double y[], double dydx[], int n, double* x, double htry, double eps,
-          double yscal[], double* hdid, double* hnext,
+          double atol[], double* hdid, double* hnext,
           void (*derivs)(double, double[], double[], int, long, double),
           long node)
 {
-    // The following void type casting is just to supress warnings
-    // Once this function is filled with using these arguments, these casting
-    // should be removed.
-    (void)y;
-    (void)dydx;
-    (void)n;
-    (void)x;
-    (void)htry;
-    (void)eps;
-    (void)yscal;
-    (void)hdid;
-    (void)hnext;
-    (void)derivs;
-    (void)node;
-
-    // Removed
-    std::cout << "Error: rkqs not implemented!" << std::endl;
-    return false;
+    FiniteElement::DormandPrinceSolver solver(n, derivs, node);
+    return solver.step(y, dydx, *x, htry, eps, atol, *hdid, *hnext);
 }
 
+/* Integrates ystart[1..nvar] from x1 to x2 with the stiff stepper
+ * (SolverType 1) or the explicit stepper (SolverType 2) and the relative
+ * tolerance eps. nok/nbad count the steps taken with the step size tried
+ * first and with a reduced one; nexth returns the step size proposed for
+ * the next call. For the steppers of this file, one solver object holds the
+ * work arrays and the LU pattern during the whole call. Returns false if
+ * the step size falls below hmin or MAXSTEP steps do not reach x2. */
 bool odeint(
     double ystart[], int nvar, double x1, double x2, double eps, double h1,
     double hmin, double* nexth, int* nok, int* nbad,
@@ -109,26 +136,26 @@ bool odeint(
                  void (*)(double, double[], double[], int, long, double), long),
     long node, int SolverType)
 {
-    // The following void type casting is just to supress warnings
-    // Once this function is filled with using these arguments, these casting
-    // should be removed.
-    (void)ystart;
-    (void)nvar;
-    (void)x1;
-    (void)x2;
-    (void)eps;
-    (void)h1;
-    (void)hmin;
-    (void)nexth;
-    (void)nok;
-    (void)nbad;
-    (void)derivs;
-    (void)stifbs;
-    (void)rkqs;
-    (void)node;
-    (void)SolverType;
+    // Concentrations are controlled relative to their size only
+    const std::vector<double> atol(nvar + 1, TINY);
+    const ODEStepper stepper = (SolverType == 2) ? rkqs : stifbs;
 
-    // Removed
-    std::cout << "Error: odeint not implemented!" << std::endl;
-    return false;
+    if (stepper == &::stifbs)
+    {
+        FiniteElement::RosenbrockSolver solver(nvar, derivs, jacobn, node);
+        return FiniteElement::integrateODE(solver, derivs, ystart, nvar, x1,
+                                           x2, eps, &atol[0], h1, hmin, node,
+                                           MAXSTEP, *nexth, *nok, *nbad);
+    }
+    if (stepper == &::rkqs)
+    {
+        FiniteElement::DormandPrinceSolver solver(nvar, derivs, node);
+        return FiniteElement::integrateODE(solver, derivs, ystart, nvar, x1,
+                                           x2, eps, &atol[0], h1, hmin, node,
+                                           MAXSTEP, *nexth, *nok, *nbad);
+    }
+    ODEStepperFunction solver(stepper, nvar, derivs, node);
+    return FiniteElement::integrateODE(solver, derivs, ystart, nvar, x1, x2,
+                                       eps, &atol[0], h1, hmin, node, MAXSTEP,
+                                       *nexth, *nok, *nbad);
 }
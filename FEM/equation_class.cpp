@@ -77,6 +77,10 @@ using namespace std;
 //
 namespace Math_Group
 {
+/// Number of iterations between two residual replacements in the pipelined
+/// solvers
+static const int pipe_replacement_period = 50;
+
 /**************************************************************************
    Task: Linear equation::Constructor
    Programing:
@@ -212,7 +216,11 @@ void Linear_EQS::ConfigNumerics(CNumerics* m_num, const long n)
             break;
         case 5:
             solver_name = "CG";
+#if defined(USE_MPI)
+            nbuffer = 5;
+#else
             nbuffer = 3;
+#endif
             break;
         case 6:
             solver_name = "CGNR";
@@ -247,6 +255,14 @@ void Linear_EQS::ConfigNumerics(CNumerics* m_num, const long n)
             H.resize(m_gmres + 1, m_gmres + 1);
             nbuffer = m_gmres + 4;
             break;
+        case 14:
+            solver_name = "PipeCG";
+            nbuffer = 9;
+            break;
+        case 15:
+            solver_name = "PipeBiCGStab";
+            nbuffer = 12;
+            break;
     }
     // Buffer
     /*
@@ -507,6 +523,12 @@ int Linear_EQS::Solver(double* xg, const long n)
         case 7:
             iter = CGS(xg, n);
             break;
+        case 14:
+            iter = PipeCG(xg, n);
+            break;
+        case 15:
+            iter = PipeBiCGStab(xg, n);
+            break;
     }
     cpu_time_local += MPI_Wtime();
     cpu_time += cpu_time_local;
@@ -889,6 +911,10 @@ int Linear_EQS::Solver()
         case 13:
             return GMRES();
             break;
+        case 14:
+            return PipeCG();
+        case 15:
+            return PipeBiCGStab();
     }
     return -1;
 }
@@ -1029,15 +1055,26 @@ double Linear_EQS::dot(const double* xx, const double* yy, const long n)
  ********************************************************************/
 inline void Linear_EQS::MatrixMulitVec(double* xx, double* yy)
 {
-    //
-    A->multiVec(xx, yy);
 #if defined(NEW_BREDUCE)
+    A->multiVec(xx, yy);
     dom->ReduceBorderV(yy);
 #else
-    dom->Local2Border(yy, border_buffer0);
-    MPI_Allreduce(border_buffer0, border_buffer1, A->Dof() * dom->BSize(),
-                  MPI_DOUBLE, MPI_SUM, comm_DDC);
-    dom->Border2Local(border_buffer1, yy);
+    // The receives from the neighbours are posted before the product.
+    dom->BeginBorderExchange();
+    if (A->IsSymmetric())
+        A->multiVec(xx, yy);
+    else
+    {
+        // The border rows are computed and sent first, the interior rows
+        // while the messages are under way.
+        const int nq = dom->NumNodeRanges();
+        for (int k = 0; k < nq; k++)
+            A->multiVec(xx, yy, dom->BorderBegin(k), dom->BorderEnd(k));
+        dom->SendBorderV(yy);
+        for (int k = 0; k < nq; k++)
+            A->multiVec(xx, yy, dom->InteriorBegin(k), dom->InteriorEnd(k));
+    }
+    dom->EndBorderExchange(yy);
 #endif
 }
 /*!
@@ -1049,15 +1086,14 @@ inline void Linear_EQS::MatrixMulitVec(double* xx, double* yy)
  ********************************************************************/
 inline void Linear_EQS::TransMatrixMulitVec(double* xx, double* yy)
 {
-    //
-    A->Trans_MultiVec(xx, yy);
 #if defined(NEW_BREDUCE)
+    A->Trans_MultiVec(xx, yy);
     dom->ReduceBorderV(yy);
 #else
-    dom->Local2Border(yy, border_buffer0);
-    MPI_Allreduce(border_buffer0, border_buffer1, A->Dof() * dom->BSize(),
-                  MPI_DOUBLE, MPI_SUM, comm_DDC);
-    dom->Border2Local(border_buffer1, yy);
+    // The receives from the neighbours are posted before the product.
+    dom->BeginBorderExchange();
+    A->Trans_MultiVec(xx, yy);
+    dom->EndBorderExchange(yy);
 #endif
 }
 #endif
@@ -1784,11 +1820,8 @@ void Linear_EQS::ComputePreconditioner_Jacobi()
 #if defined(NEW_BREDUCE)
     dom->ReduceBorderV(prec_M);
 #else
-    dom->Local2Border(prec_M, border_buffer0);  // to buffer
-    MPI_Allreduce(border_buffer0, border_buffer1, A->Dof() * dom->BSize(),
-                  MPI_DOUBLE, MPI_SUM, comm_DDC);
+    dom->ExchangeBorderV(prec_M);
 #endif
-    dom->Border2Local(border_buffer1, prec_M);
 }
 /*************************************************************************
    GeoSys-Function:
@@ -1813,6 +1846,10 @@ void Linear_EQS::Precond_Jacobi(const double* vec_s, double* vec_r)
    Task: Linear equation::CG
    Programing:
    01/2008 WW/
+
+   CG of Chronopoulos and Gear (J. Comput. Appl. Math. 25, 1989): with
+   u = M^{-1}r and w = Au, the coefficients follow from (r, u), (w, u)
+   and |r|^2 alone, so one reduction per iteration is enough.
 **************************************************************************/
 int Linear_EQS::CG(double* xg, const long n)
 {
@@ -1822,7 +1859,9 @@ int Linear_EQS::CG(double* xg, const long n)
     //
     double* p = f_buffer[0];
     double* r = f_buffer[1];
-    double* s = f_buffer[2];
+    double* s = f_buffer[2];  // Ap
+    double* u = f_buffer[3];
+    double* w = f_buffer[4];
     //
 
     //*** Norm b
@@ -1845,45 +1884,61 @@ int Linear_EQS::CG(double* xg, const long n)
     for (long i = 0; i < size; i++)
         r[i] = b[i] - s[i];  // r = b-Ax
     //   Collect border r
-    dom->Local2Border(r, border_buffer0);  //
-    MPI_Allreduce(border_buffer0, border_buffer1, size_b, MPI_DOUBLE, MPI_SUM,
-                  comm_DDC);
-    dom->Border2Local(border_buffer1, r);
-    //
-    // Preconditioning: M^{-1}r
-    Precond(r, s);
-    for (long i = 0; i < size; i++)
-        p[i] = s[i];
+    dom->ExchangeBorderV(r);
+    //
+    // u = M^{-1}r, w = Au
+    Precond(r, u);
+    MatrixMulitVec(u, w);
+    // gamma = (r, u), delta = (w, u) and |r|^2 in one reduction
+    double val[3];
+    const double* xx[3] = {r, w, r};
+    const double* yy[3] = {u, u, r};
+    Dots(xx, yy, 3, val);
     // Check the convergence
-    if ((error = Norm(r) / bNorm) < tol)
+    if ((error = sqrt(val[2]) / bNorm) < tol)
     {
         Message();
         return 1;
     }
+    for (long i = 0; i < size; i++)
+    {
+        p[i] = 0.;
+        s[i] = 0.;
+    }
     //
-    double rr = dot(r, s);
-    //
+    double alpha = 1.0, gamma_0 = 1.0;
     for (iter = 1; iter <= max_iter; ++iter)
     {
-        MatrixMulitVec(p, s);
-        const double alpha = rr / dot(p, s);
+        // alpha = (r, u) / (p, Ap) from the recurrence of Ap
+        const double gamma = val[0];
+        double beta = 0.;
+        double denom = val[1];
+        if (iter > 1)
+        {
+            beta = gamma / gamma_0;
+            denom -= beta * gamma / alpha;
+        }
+        if (fabs(denom) < DBL_MIN)  // Breakdown, (p, Ap) = 0
+        {
+            iter = max_iter + 1;
+            break;
+        }
+        alpha = gamma / denom;
+        gamma_0 = gamma;
         // Update
         for (long i = 0; i < size; i++)
         {
+            p[i] = u[i] + beta * p[i];
+            s[i] = w[i] + beta * s[i];
             x[i] += alpha * p[i];
             r[i] -= alpha * s[i];
         }
-        if ((error = Norm(r) / bNorm) < tol)
+        // Preconditioner and product for the next coefficients
+        Precond(r, u);
+        MatrixMulitVec(u, w);
+        Dots(xx, yy, 3, val);
+        if ((error = sqrt(val[2]) / bNorm) < tol)
             break;
-        // Preconditioner
-        Precond(r, s);
-        //
-        double rrM1 = rr;
-        rr = dot(s, r);
-        //
-        const double beta = rr / rrM1;
-        for (long i = 0; i < size; i++)
-            p[i] = s[i] + beta * p[i];
     }
     //
     // concancert internal x
@@ -1937,10 +1992,7 @@ int Linear_EQS::CGS(double* xg, const long n)
     for (long i = 0; i < size; i++)
         r0[i] = b[i] - v[i];  // r = b-Ax
     //   Collect border r
-    dom->Local2Border(r0, border_buffer0);  //  buffer
-    MPI_Allreduce(border_buffer0, border_buffer1, size_b, MPI_DOUBLE, MPI_SUM,
-                  comm_DDC);
-    dom->Border2Local(border_buffer1, r0);
+    dom->ExchangeBorderV(r0);
     //
     for (long i = 0; i < size; i++)
     {
@@ -2072,10 +2124,7 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
     for (long i = 0; i < size; i++)
         r0[i] = b[i] - s[i];  // r = b-Ax
     //   Collect border r
-    dom->Local2Border(r0, border_buffer0);  // buffer
-    MPI_Allreduce(border_buffer0, border_buffer1, size_b, MPI_DOUBLE, MPI_SUM,
-                  comm_DDC);
-    dom->Border2Local(border_buffer1, r0);
+    dom->ExchangeBorderV(r0);
 
 #ifdef TEST_MPI
     // TEST
@@ -2116,12 +2165,24 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
         v[i] = 0.;
         p[i] = 0.;
     }
-    if ((error = Norm(r) / bNorm) < tol)
+    // |r|^2 and rho_1 = (r0, r) of the first iteration in one reduction
+    double val[5];
+    const double* xx_r[2] = {r, r0};
+    const double* yy_r[2] = {r, r};
+    Dots(xx_r, yy_r, 2, val);
+    if ((error = sqrt(val[0]) / bNorm) < tol)
     {
         if (myrank == 0)  // Make screen output only by processor 0
             Message();
         return 0;
     }
+    double rho_1 = val[1];
+    // |s|^2, (t, t), (t, s), (r0, s) and (r0, t) in one reduction. With
+    // r = s - omega t, the last two give rho_1 of the next iteration and,
+    // with the first three, |r|^2, so that an iteration needs only this
+    // reduction and the one for alpha.
+    const double* xx_s[5] = {s, t, t, r0, r0};
+    const double* yy_s[5] = {s, t, s, s, t};
 
     /*
        //TEST
@@ -2135,7 +2196,6 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
     //
     for (iter = 1; iter <= max_iter; iter++)
     {
-        const double rho_1 = dot(r0, r);
         if (fabs(rho_1) < DBL_MIN)
             break;
 
@@ -2179,20 +2239,21 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
         //
         for (long i = 0; i < size; i++)
             s[i] = r[i] - alpha * v[i];
-        const double norm_v = sqrt(dot(s, s));
-        if ((error = norm_v / bNorm) < tol)
+        //  M^{-1}s,
+        Precond(s, s_h);
+        // A* M^{-1}s
+        MatrixMulitVec(s_h, t);
+        // The check of |s| is delayed to the reduction with the dot
+        // products of t
+        Dots(xx_s, yy_s, 5, val);
+        if ((error = sqrt(val[0]) / bNorm) < tol)
         {
             for (long i = 0; i < size; i++)
                 x[i] += alpha * p_h[i];
             break;
         }
-
-        //  M^{-1}s,
-        Precond(s, s_h);
-        // A* M^{-1}s
-        MatrixMulitVec(s_h, t);
         //
-        const double tt = dot(t, t);
+        const double tt = val[1];
 
 #ifdef TEST_MPI
         // TEST
@@ -2202,7 +2263,7 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
 #endif
 
         if (tt > DBL_MIN)
-            omega = dot(t, s) / tt;
+            omega = val[2] / tt;
         else
             omega = 1.0;
         // Update solution
@@ -2212,8 +2273,18 @@ int Linear_EQS::BiCGStab(double* xg, const long n)
             r[i] = s[i] - omega * t[i];
         }
         rho_0 = rho_1;
-        //
-        const double norm_v1 = sqrt(dot(r, r));
+        rho_1 = val[3] - omega * val[4];
+        double norm_v1 =
+            sqrt(std::max(val[0] - 2.0 * omega * val[2] + omega * omega * tt,
+                          0.0));
+        // The recurrence of |r|^2 cancels near convergence; convergence is
+        // only accepted with the actual residual.
+        if (norm_v1 / bNorm < tol)
+        {
+            Dots(xx_r, yy_r, 2, val);
+            norm_v1 = sqrt(val[0]);
+            rho_1 = val[1];
+        }
 
 #ifdef TEST_MPI
         // TEST
@@ -2313,10 +2384,7 @@ int Linear_EQS::BiCG(double* xg, const long n)
     for (long i = 0; i < size; i++)
         r[i] = b[i] - rt[i];  // r = b-Ax
     //   Collect border r
-    dom->Local2Border(r, border_buffer0);  //  buffer
-    MPI_Allreduce(border_buffer0, border_buffer1, size_b, MPI_DOUBLE, MPI_SUM,
-                  comm_DDC);
-    dom->Border2Local(border_buffer1, r);
+    dom->ExchangeBorderV(r);
     //
     // Initial.
     for (long i = 0; i < size; i++)
@@ -2418,6 +2486,403 @@ int Linear_EQS::BiCG(double* xg, const long n)
     return iter <= max_iter;
 }
 #endif
+/*\!
+ ********************************************************************
+   Local contributions to n dot products (xx[k], yy[k]), computed in
+   one pass over the vectors. In the parallel case, the entries on
+   the border are weighted as in dot(), and the contributions still
+   have to be summed over all ranks.
+ ********************************************************************/
+void Linear_EQS::LocalDots(const double* const* xx, const double* const* yy,
+                           const int n, double* val)
+{
+#if defined(USE_MPI)
+    for (int k = 0; k < n; k++)
+        val[k] = dom->Dot_Interior(xx[k], yy[k]) +
+                 dom->Dot_Border_Vec(xx[k], yy[k]);
+#else
+    for (int k = 0; k < n; k++)
+        val[k] = 0.;
+    for (long i = 0; i < size_A; i++)
+        for (int k = 0; k < n; k++)
+            val[k] += xx[k][i] * yy[k][i];
+#endif
+}
+
+/*\!
+ ********************************************************************
+   n dot products with one reduction
+ ********************************************************************/
+void Linear_EQS::Dots(const double* const* xx, const double* const* yy,
+                      const int n, double* val)
+{
+#if defined(USE_MPI)
+    double val_i[8];
+    LocalDots(xx, yy, n, val_i);
+    MPI_Allreduce(val_i, val, n, MPI_DOUBLE, MPI_SUM, comm_DDC);
+#else
+    LocalDots(xx, yy, n, val);
+#endif
+}
+
+/*\!
+ ********************************************************************
+   Residual r = b-Ax. vec_h is a buffer.
+ ********************************************************************/
+void Linear_EQS::Residual(double* r, double* vec_h)
+{
+    const long size = A->Dim();
+#if defined(USE_MPI)
+    A->multiVec(x, vec_h);
+#else
+    MultiVec(x, vec_h);
+#endif
+    for (long i = 0; i < size; i++)
+        r[i] = b[i] - vec_h[i];
+#if defined(USE_MPI)
+    dom->ExchangeBorderV(r);
+#endif
+}
+
+/*\!
+ ********************************************************************
+   Product of A and a vector. With JFNK, the product of the Jacobian
+   and the vector.
+ ********************************************************************/
+void Linear_EQS::MultiVec(double* vec_s, double* vec_r)
+{
+#if defined(USE_MPI)
+    MatrixMulitVec(vec_s, vec_r);
+#else
+#ifdef JFNK_H2M
+    if (a_pcs)  /// JFNK
+        a_pcs->Jacobian_Multi_Vector_JFNK(vec_s, vec_r);
+    else
+#endif
+        A->multiVec(vec_s, vec_r);
+#endif
+}
+
+/*\!
+ ********************************************************************
+   Product of A M^{-1} and a vector, the operator of the right
+   preconditioned solvers. vec_h is a buffer for M^{-1} vec_s.
+ ********************************************************************/
+void Linear_EQS::PrecondMultiVec(double* vec_s, double* vec_h, double* vec_r)
+{
+    Precond(vec_s, vec_h);
+    MultiVec(vec_h, vec_r);
+}
+
+/*************************************************************************
+   GeoSys-Function:
+   Task: Pipelined preconditioned CG solver
+
+   Pipelined CG of Ghysels and Vanroose (Parallel Computing 40, 2014).
+   The three dot products of an iteration are summed in one reduction,
+   which overlaps with the preconditioner and the matrix vector
+   product of the iteration. All vector updates are done in one pass.
+
+   The recurrences let the residual drift from b-Ax. Therefore the
+   residual and the auxiliary vectors are recomputed every
+   pipe_replacement_period iterations, and before convergence is
+   accepted.
+ **************************************************************************/
+#if defined(USE_MPI)
+int Linear_EQS::PipeCG(double* xg, const long n)
+#else
+int Linear_EQS::PipeCG()
+#endif
+{
+    //
+    const long size = A->Dim();
+    double* r = f_buffer[0];
+    double* u = f_buffer[1];
+    double* w = f_buffer[2];
+    double* m = f_buffer[3];
+    double* nn = f_buffer[4];
+    double* z = f_buffer[5];
+    double* q = f_buffer[6];
+    double* s = f_buffer[7];
+    double* p = f_buffer[8];
+    //
+    // Norm of b
+#if defined(USE_MPI)
+    for (long i = 0; i < size; i++)
+        r[i] = b[i];
+    dom->ExchangeBorderV(r);  // b on the border
+    if (CheckNormRHS(Norm(r)))
+        return 0;
+    dom->Global2Local(xg, x, n);
+#else
+    if (CheckNormRHS(Norm(b)))
+        return 0;
+#endif
+    // r = b-Ax, u = M^{-1}r, w = Au
+    Residual(r, s);
+    PrecondMultiVec(r, u, w);
+    for (long i = 0; i < size; i++)
+    {
+        z[i] = 0.;
+        q[i] = 0.;
+        s[i] = 0.;
+        p[i] = 0.;
+    }
+    //
+    double alpha = 1.0, gamma_0 = 1.0;
+    double val[3];
+    // gamma = (r, u), delta = (w, u), |r|^2
+    const double* xx[3] = {r, w, r};
+    const double* yy[3] = {u, u, r};
+    for (iter = 0;; ++iter)
+    {
+#if defined(USE_MPI)
+        double val_i[3];
+        LocalDots(xx, yy, 3, val_i);
+        MPI_Request request;
+        MPI_Iallreduce(val_i, val, 3, MPI_DOUBLE, MPI_SUM, comm_DDC, &request);
+#else
+        LocalDots(xx, yy, 3, val);
+#endif
+        // m = M^{-1}w, n = Am
+        PrecondMultiVec(w, m, nn);
+#if defined(USE_MPI)
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+        error = sqrt(val[2]) / bNorm;
+        if (iter > 0 && (error < tol || iter % pipe_replacement_period == 0))
+        {
+            // Residual replacement
+            Residual(r, nn);
+            PrecondMultiVec(r, u, w);
+            MultiVec(p, s);
+            PrecondMultiVec(s, q, z);
+            Dots(xx, yy, 3, val);
+            PrecondMultiVec(w, m, nn);
+            error = sqrt(val[2]) / bNorm;
+        }
+        if (error < tol)
+            break;
+        if (iter == max_iter)
+        {
+            iter++;  // Not converged, as in CG()
+            break;
+        }
+        //
+        const double gamma = val[0];
+        double beta = 0.;
+        double denom = val[1];
+        if (iter > 0)
+        {
+            beta = gamma / gamma_0;
+            denom -= beta * gamma / alpha;
+        }
+        if (fabs(denom) < DBL_MIN)  // Breakdown, (p, Ap) = 0
+        {
+            iter = max_iter + 1;
+            break;
+        }
+        alpha = gamma / denom;
+        gamma_0 = gamma;
+        // Update
+        for (long i = 0; i < size; i++)
+        {
+            z[i] = nn[i] + beta * z[i];
+            q[i] = m[i] + beta * q[i];
+            s[i] = w[i] + beta * s[i];
+            p[i] = u[i] + beta * p[i];
+            x[i] += alpha * p[i];
+            r[i] -= alpha * s[i];
+            u[i] -= alpha * q[i];
+            w[i] -= alpha * z[i];
+        }
+    }
+    //
+#if defined(USE_MPI)
+    // concancert internal x
+    dom->CatInnerX(xg, x, n);
+#endif
+    Message();
+    return iter <= max_iter;
+}
+
+/*************************************************************************
+   GeoSys-Function:
+   Task: Pipelined BiCGStab solver
+
+   Right preconditioned version of the pipelined BiCGStab of Cools and
+   Vanroose (Parallel Computing 65, 2017). The products with A M^{-1}
+   are replaced by recurrences, so that each of the two reductions of
+   an iteration overlaps with one preconditioned matrix vector product.
+   The dot products of a reduction are fused into one pass, and so are
+   the vector updates. The update of the solution is accumulated in
+   the preconditioned space and mapped back by M^{-1}, when the
+   residual is replaced (see PipeCG) and at the end.
+ **************************************************************************/
+#if defined(USE_MPI)
+int Linear_EQS::PipeBiCGStab(double* xg, const long n)
+#else
+int Linear_EQS::PipeBiCGStab()
+#endif
+{
+    //
+    const long size = A->Dim();
+    double* r0 = f_buffer[0];
+    double* r = f_buffer[1];
+    double* w = f_buffer[2];
+    double* t = f_buffer[3];
+    double* p = f_buffer[4];
+    double* s = f_buffer[5];
+    double* z = f_buffer[6];
+    double* q = f_buffer[7];
+    double* y = f_buffer[8];
+    double* v = f_buffer[9];
+    double* dx = f_buffer[10];  // Update of M x
+    double* h = f_buffer[11];   // Buffer for M^{-1}
+    //
+    // Norm of b
+#if defined(USE_MPI)
+    for (long i = 0; i < size; i++)
+        r[i] = b[i];
+    dom->ExchangeBorderV(r);  // b on the border
+    if (CheckNormRHS(Norm(r)))
+        return 0;
+    dom->Global2Local(xg, x, n);
+#else
+    if (CheckNormRHS(Norm(b)))
+        return 0;
+#endif
+    // r = b-Ax
+    Residual(r, h);
+    for (long i = 0; i < size; i++)
+    {
+        r0[i] = r[i];
+        p[i] = 0.;
+        s[i] = 0.;
+        z[i] = 0.;
+        v[i] = 0.;
+        dx[i] = 0.;
+    }
+    iter = 0;
+    double rho = dot(r, r);
+    if ((error = sqrt(rho) / bNorm) < tol)
+    {
+        Message();
+        return 0;
+    }
+    // w = AM^{-1}r, t = AM^{-1}w
+    PrecondMultiVec(r, h, w);
+    PrecondMultiVec(w, h, t);
+    const double r0w = dot(r0, w);
+    if (fabs(r0w) < DBL_MIN)
+    {
+        Message();
+        return 0;
+    }
+    double alpha = rho / r0w;
+    double beta = 0., omega = 1.0;
+    bool breakdown = false;
+    double val[5];
+    // (q, y), (y, y)
+    const double* xx1[2] = {q, y};
+    const double* yy1[2] = {y, y};
+    // (r0, r), (r0, w), (r0, s), (r0, z), |r|^2
+    const double* xx2[5] = {r0, r0, r0, r0, r};
+    const double* yy2[5] = {r, w, s, z, r};
+    //
+    for (iter = 1; iter <= max_iter; iter++)
+    {
+        for (long i = 0; i < size; i++)
+        {
+            p[i] = r[i] + beta * (p[i] - omega * s[i]);
+            s[i] = w[i] + beta * (s[i] - omega * z[i]);
+            z[i] = t[i] + beta * (z[i] - omega * v[i]);
+            q[i] = r[i] - alpha * s[i];
+            y[i] = w[i] - alpha * z[i];
+        }
+#if defined(USE_MPI)
+        double val_i[5];
+        MPI_Request request;
+        LocalDots(xx1, yy1, 2, val_i);
+        MPI_Iallreduce(val_i, val, 2, MPI_DOUBLE, MPI_SUM, comm_DDC, &request);
+#else
+        LocalDots(xx1, yy1, 2, val);
+#endif
+        // v = AM^{-1}z
+        PrecondMultiVec(z, h, v);
+#if defined(USE_MPI)
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+        omega = (val[1] > DBL_MIN) ? val[0] / val[1] : 1.0;
+        //
+        for (long i = 0; i < size; i++)
+        {
+            dx[i] += alpha * p[i] + omega * q[i];
+            r[i] = q[i] - omega * y[i];
+            w[i] = y[i] - omega * (t[i] - alpha * v[i]);
+        }
+#if defined(USE_MPI)
+        LocalDots(xx2, yy2, 5, val_i);
+        MPI_Iallreduce(val_i, val, 5, MPI_DOUBLE, MPI_SUM, comm_DDC, &request);
+#else
+        LocalDots(xx2, yy2, 5, val);
+#endif
+        // t = AM^{-1}w
+        PrecondMultiVec(w, h, t);
+#if defined(USE_MPI)
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+        error = sqrt(val[4]) / bNorm;
+        if (error < tol || iter % pipe_replacement_period == 0)
+        {
+            // Residual replacement
+            Precond(dx, h);
+            for (long i = 0; i < size; i++)
+            {
+                x[i] += h[i];
+                dx[i] = 0.;
+            }
+            Residual(r, h);
+            PrecondMultiVec(r, h, w);
+            PrecondMultiVec(w, h, t);
+            PrecondMultiVec(p, h, s);
+            PrecondMultiVec(s, h, z);
+            PrecondMultiVec(z, h, v);
+            Dots(xx2, yy2, 5, val);
+            if ((error = sqrt(val[4]) / bNorm) < tol)
+                break;
+        }
+        // Breakdowns are treated as in BiCGStab()
+        if (fabs(val[0]) < DBL_MIN)  // rho = (r0, r) = 0
+        {
+            breakdown = true;
+            break;
+        }
+        if (fabs(omega) < DBL_MIN)
+            break;
+        beta = (alpha / omega) * (val[0] / rho);
+        rho = val[0];
+        // (r0, AM^{-1}p) of the next iteration
+        const double denom = val[1] + beta * val[2] - beta * omega * val[3];
+        if (fabs(denom) < DBL_MIN)
+        {
+            breakdown = true;
+            break;
+        }
+        alpha = rho / denom;
+    }
+    // x += M^{-1} dx
+    Precond(dx, h);
+    for (long i = 0; i < size; i++)
+        x[i] += h[i];
+#if defined(USE_MPI)
+    // concancert internal x
+    dom->CatInnerX(xg, x, n);
+#endif
+    //
+    Message();
+    return breakdown ? 0 : iter;
+}
 //------------------------------------------------------------------------
 }  // namespace Math_Group
 #endif  // if defined(NEW_EQS)
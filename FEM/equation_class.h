@@ -87,6 +87,8 @@ public:
     int BiCG(double* xg, const long n);  // 02.2010. WW
     int BiCGStab(double* xg, const long n);
     int CGS(double* xg, const long n);
+    int PipeCG(double* xg, const long n);
+    int PipeBiCGStab(double* xg, const long n);
     double GetCPUtime() const { return cpu_time; }
 #else
 #if defined(LIS) || defined(MKL)  // NW
@@ -107,6 +109,8 @@ public:
     int AMG1R5() { return -1; }
     int UMF() { return -1; }
     int GMRES();
+    int PipeCG();
+    int PipeBiCGStab();
 #endif
     //
     void Initialize();
@@ -175,6 +179,14 @@ private:  // Dot not remove this!
     double dot(const double* xx, const double* yy);
     inline double Norm(const double* xx) { return sqrt(dot(xx, xx)); }
     inline bool CheckNormRHS(const double normb_new);
+    // Pipelined solvers
+    void LocalDots(const double* const* xx, const double* const* yy,
+                   const int n, double* val);
+    void Dots(const double* const* xx, const double* const* yy, const int n,
+              double* val);
+    void Residual(double* r, double* vec_h);
+    void MultiVec(double* vec_s, double* vec_r);
+    void PrecondMultiVec(double* vec_s, double* vec_h, double* vec_r);
 #ifdef JFNK_H2M
     /// 30.06.2010. WW
     CRFProcess* a_pcs;
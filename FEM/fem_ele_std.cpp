@@ -26,6 +26,10 @@
 #include "rf_msp_new.h"
 #include "eos.h"
 #include "SparseMatrixDOK.h"
+#include "FCTFluxCRS.h"
+#include "ReactionRateIntegrator.h"
+#include "OverlandFlowKernels.h"
+#include "StepSnapshot.h"
 
 #include "pcs_dm.h"  // displacement coupled
 #include "rfmat_cp.h"
@@ -54,17 +58,6 @@ using Math_Group::CSparseMatrix;
 #include "par_ddc.h"
 #endif
 
-#ifdef OGS_USE_CVODE
-extern "C"
-{
-#include <cvode/cvode.h>             /* prototypes for CVODE fcts., consts. */
-#include <nvector/nvector_serial.h>  /* serial N_Vector types, fcts., macros */
-#include <cvode/cvode_dense.h>       /* prototype for CVDense */
-#include <sundials/sundials_dense.h> /* definitions DlsMat DENSE_ELEM */
-#include <sundials/sundials_types.h> /* definition of type realtype */
-}
-#endif
-
 #include "pcs_dm.h"  // displacement coupled
 
 #include "PhysicalConstant.h"
@@ -129,7 +122,7 @@ CFiniteElementStd::CFiniteElementStd(CRFProcess* Pcs, const int C_Sys_Flad,
     GasProp = NULL;
 
     //
-    edlluse = edttuse = NULL;
+    overland_geometry = NULL;
     idx_vel_disp = NULL;  // WW
     weight_func = NULL;   // WW
     idx_vel = new int[3];
@@ -303,8 +296,7 @@ CFiniteElementStd::CFiniteElementStd(CRFProcess* Pcs, const int C_Sys_Flad,
         // case 'O':                             // Liquid flow
         case OVERLAND_FLOW:
             PcsType = EPT_OVERLAND_FLOW;
-            edlluse = new double[16];  // WW
-            edttuse = new double[16];
+            overland_geometry = new OverlandFlowGeometryCache();
             break;
 
         // case 'R':                             //OK4104 Richards flow
@@ -570,10 +562,7 @@ CFiniteElementStd::~CFiniteElementStd()
     delete StiffMatrix;
     delete AuxMatrix;
     delete AuxMatrix1;
-    if (edlluse)
-        delete[] edlluse;
-    if (edttuse)
-        delete[] edttuse;
+    delete overland_geometry;
 
     StiffMatrix = NULL;
     AuxMatrix = NULL;
@@ -1013,504 +1002,6 @@ void CFiniteElementStd::SetMaterial(int /*phase*/)
     //----------------------------------------------------------------------
 }
 
-/*************************************************************************
-   FEMLib-Function:
-   Task: Line element integration data for CVFEM overland flow
-      to move
-   Programming:
-     6/2007 : JOD
- **************************************************************************/
-void CFiniteElementStd::GetOverlandBasisFunctionMatrix_Line()
-{
-    edlluse[0] = 1.0;
-    edlluse[1] = -1.0;
-    edlluse[2] = -1.0;
-    edlluse[3] = 1.0;
-
-    edttuse[0] = 0.0;
-    edttuse[1] = 0.0;
-    edttuse[2] = 0.0;
-    edttuse[3] = 0.0;
-    ////MB nur Zeitweise hier
-}
-/*************************************************************************
-   FEMLib-Function:
-   Task: Quad element integration data for CVFEM overland flow
-      to move
-   Programming:
-         ?    MB
- **************************************************************************/
-void CFiniteElementStd::GetOverlandBasisFunctionMatrix_Quad()
-{
-    edlluse[0] = 0.5;
-    edlluse[1] = -0.5;
-    edlluse[2] = 0.0;
-    edlluse[3] = 0.0;
-    edlluse[4] = -0.5;
-    edlluse[5] = 0.5;
-    edlluse[6] = 0.;
-    edlluse[7] = 0.;
-    edlluse[8] = 0.;
-    edlluse[9] = 0.;
-    edlluse[10] = 0.5;
-    edlluse[11] = -0.5;
-    edlluse[12] = 0.;
-    edlluse[13] = 0.;
-    edlluse[14] = -0.5;
-    edlluse[15] = 0.5;
-
-    edttuse[0] = 0.5;
-    edttuse[1] = 0.;
-    edttuse[2] = 0.;
-    edttuse[3] = -0.5;
-    edttuse[4] = 0.;
-    edttuse[5] = 0.5;
-    edttuse[6] = -0.5;
-    edttuse[7] = 0.;
-    edttuse[8] = 0.;
-    edttuse[9] = -0.5;
-    edttuse[10] = 0.5;
-    edttuse[11] = 0.;
-    edttuse[12] = -0.5;
-    edttuse[13] = 0.;
-    edttuse[14] = 0.;
-    edttuse[15] = 0.5;
-}
-
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates consitutive relationships for CVFEM Overland Flow -> swval,
-swold for surface structure Programing: 06/2005 MB Implementation 04/2007 JOD
-modifications
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandNLTERMS(double* haa, double* haaOld,
-                                            double* swval, double* swold)
-{
-    if (MediaProp->channel == 1)
-        CalcOverlandNLTERMSChannel(haa, haaOld, swval, swold);
-    else
-        CalcOverlandNLTERMSRills(haa, haaOld, swval, swold);
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates consitutive relationships for CVFEM Overland Flow -> swval,
-swold for surface structure Programing: 06/2007 JOD implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandNLTERMSRills(double* haa, double* haaOld,
-                                                 double* swval, double* swold)
-{
-    double WDepth[4], WDepthOld[4];
-    double rill_height = MediaProp->rill_height;
-    double eps = MediaProp->rill_epsilon;
-
-    for (int i = 0; i < nnodes; i++)
-    {
-        WDepth[i] = haa[i] - Z[i];
-        WDepthOld[i] = haaOld[i] - Z[i];
-        if (MediaProp->rill_epsilon > 0)
-        {
-            if (WDepth[i] > 0)
-                swval[i] = (WDepth[i] + eps) * (WDepth[i] + eps) /
-                               (WDepth[i] + rill_height + eps) -
-                           pow(eps, 2.) / (rill_height + eps);
-            else
-                swval[i] = 0;
-
-            if (WDepthOld[i] > 0)
-                // JOD
-                swold[i] = (WDepthOld[i] + eps) * (WDepthOld[i] + eps) /
-                               (WDepthOld[i] + rill_height + eps) -
-                           pow(eps, 2.) / (rill_height + eps);
-            else
-                swold[i] = 0;
-        }  // end epsilon > 0
-        else
-        {
-            swval[i] = WDepth[i];
-            swold[i] = WDepthOld[i];
-        }
-    }
-}
-
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates consitutive relationships for CVFEM Overland Flow -> swval,
-swold for channel Programing: 06/2007 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandNLTERMSChannel(double* haa, double* haaOld,
-                                                   double* swval, double* swold)
-{
-    double WDepth[4], WDepthOld[4];
-    double eps = MediaProp->rill_epsilon;
-    double ratio;
-    double xxx;
-
-    for (int i = 0; i < 2; i++)
-    {
-        WDepth[i] = haa[i] - Z[i];
-        WDepthOld[i] = haaOld[i] - Z[i];
-        if (eps > 0)
-        {
-            ratio = WDepth[i] / eps;
-            if (ratio > 1.0)
-                swval[i] = WDepth[i];
-            else if (ratio > 0.0)
-            {
-                xxx = 2.0 * (1.0 - ratio);
-                swval[i] = WDepth[i] * pow(ratio, xxx);
-            }
-            else
-                swval[i] = 0.0;
-            ////////////////////////
-
-            ratio = WDepthOld[i] / eps;
-            if (ratio > 1.0)
-                swold[i] = WDepthOld[i];
-            else if (ratio > 0.0)
-            {
-                xxx = 2.0 * (1.0 - ratio);
-                swold[i] = WDepthOld[i] * pow(ratio, xxx);
-            }
-            else
-                swold[i] = 0.0;
-        }  // end epsilon > 0
-        else
-        {
-            swval[i] = WDepth[i];
-            swold[i] = WDepthOld[i];
-        }
-    }  // end for
-}
-
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates upstream weighting for CVFEM Overland Flow -> ckwr and iups
-   Programing:
-   06/2005 MB Implementation
-   04/2007 JOD modifications
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCKWR(double* head, double* ckwr, int* iups)
-{
-    double width = MediaProp->overland_width;
-    double depth_exp = MediaProp->friction_exp_depth;
-    double rill_depth = MediaProp->rill_height;
-    int i, j;
-    double maxZ;
-    double flow_depth;
-
-    for (i = 0; i < nnodes; i++)
-        for (j = 0; j < nnodes; j++)
-        {
-            maxZ = MMax(Z[i], Z[j]);
-            if (head[i] > head[j])
-            {
-                iups[i * nnodes + j] = i;
-                flow_depth = head[i] - maxZ - rill_depth;
-            }
-            else
-            {
-                iups[i * nnodes + j] = j;
-                flow_depth = head[j] - maxZ - rill_depth;
-            }
-            ////////////////////////////////////////
-            if (flow_depth < 0.0)
-                ckwr[i * nnodes + j] = 0.0;
-            else
-            {
-                if (MediaProp->channel == 1)
-                    ckwr[i * nnodes + j] =
-                        flow_depth *
-                        pow(flow_depth * width / (2 * flow_depth + width),
-                            depth_exp);
-                else
-                    ckwr[i * nnodes + j] = pow(flow_depth, depth_exp + 1);
-            }
-        }  // end for j
-           // end for i
-}
-
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates upstream weighting for CVFEM Overland Flow -> ckwr and iups
-      at node (i,j)
-     used in AssemleParabolicEquationNewtonJacobi()
-   Programing:
-   06/2005 MB Implementation
-   04/2007 JOD modifications
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCKWRatNodes(int i, int j, double* head,
-                                                double* ckwr, int* iups)
-{
-    double width = MediaProp->overland_width;
-    double depth_exp = MediaProp->friction_exp_depth;
-    double rill_depth = MediaProp->rill_height;
-    double flow_depth;
-    double maxZ;
-
-    maxZ = MMax(Z[i], Z[j]);
-    if (iups[i * nnodes + j] == i)
-        flow_depth = head[i] - maxZ - rill_depth;
-    else
-        flow_depth = head[j] - maxZ - rill_depth;
-    ///////////////////////////////////////
-    if (flow_depth < 0.0)
-        *ckwr = 0;
-    else
-    {
-        if (MediaProp->channel == 1)
-            *ckwr =
-                flow_depth *
-                pow(flow_depth * width / (2 * flow_depth + width), depth_exp);
-        else
-            *ckwr = pow(flow_depth, depth_exp + 1);
-    }
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task: calculate upwinded diffusion matric coefficient for CVFEM
-      used in AssemleParabolicEquationNewton()
-             AssemleParabolicEquationNewtonJacobi()
-   Programing:
-   06/2007 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandUpwindedCoefficients(double** amat,
-                                                         double* ckwr,
-                                                         double axx, double ayy)
-{
-    // double** amat;
-    double gammaij;
-
-    // amat = (double**) Malloc(nnodes * sizeof(double));
-    // for (int i = 0; i < nnodes; i++)
-    //  amat[i] = (double*) Malloc(nnodes*sizeof(double));
-
-    // for (int i = 0; i < nnodes; i++)
-    //  for (int j = 0; j < nnodes; j++)
-    //    amat[i][j]= 0.0;
-
-    for (int i = 0; i < nnodes; i++)
-        for (int j = (i + 1); j < nnodes; j++)
-        {
-            gammaij = ckwr[i * nnodes + j] * ((edlluse[i * nnodes + j] * axx) +
-                                              (edttuse[i * nnodes + j] * ayy));
-            amat[i][j] = gammaij;
-            amat[j][i] = gammaij;
-            amat[i][i] = amat[i][i] - gammaij;
-            amat[j][j] = amat[j][j] - gammaij;
-        }
-
-    // return amat;
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task: residual vector for overland CVFEM
-      used in AssemleParabolicEquationNewton()
-   Programing:
-   06/2007 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandResidual(double* head, double* swval,
-                                             double* swold, double ast,
-                                             double* residual, double** amat)
-{
-    double sum;
-    double storinit[4], astor[4], rhs[4];
-
-    MNulleVec(astor, 4);
-    MNulleVec(rhs, nnodes);
-
-    for (int i = 0; i < nnodes; i++)  // storage term
-        rhs[i] = -ast * (swval[i] - swold[i]);
-
-    /* if(MediaProp->channel ==1){ // channel, JOD removed, don't know what it
-       was for astor[0] = swval[0] * ast; astor[1] = swval[1] * ast; rhs[0] =
-       swold[0] * ast * HaaOld[0]; // swval ????? rhs[1] = swold[1] * ast *
-       HaaOld[1]; // swval ?????
-       }
-     */
-    // Form the residual excluding the right hand side vector
-
-    for (int i = 0; i < nnodes; i++)
-    {
-        sum = 0.0;
-        for (int j = 0; j < nnodes; j++)
-            sum = sum + (amat[i][j] * head[j]);
-        // astor = 0, rillDepth??
-        storinit[i] = -rhs[i] + astor[i] * (head[i] - Z[i]);
-        residual[i] = sum + storinit[i];
-    }
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task: calcukate jacobi overland CVFEM
-      used in  AssemleParabolicEquationNewtonJacobi()
-   Programing:
-   06/2007 JOD Implementation
-**************************************************************************/
-double CFiniteElementStd::CalcOverlandJacobiNodes(int i, int j, double* head,
-                                                  double* headKeep, double akrw,
-                                                  double axx, double ayy,
-                                                  double** amat, double* sumjac)
-{
-    double jacobi, gammaij, amatEps, amatKeep;
-
-    gammaij =
-        akrw * (axx * edlluse[i * nnodes + j] + ayy * edttuse[i * nnodes + j]);
-    amatEps = gammaij * (head[j] - head[i]);
-    amatKeep = amat[i][j] * (headKeep[j] - headKeep[i]);
-    jacobi = -(amatEps - amatKeep);
-
-    *sumjac = *sumjac + amatEps;
-
-    return jacobi;
-}
-
-/**************************************************************************
-   FEMLib-Method:
-   Task: calculate topology coefficients for overland CVFEM
-   Programing:
-   08/2006 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCoefficients(double* head, double* axx,
-                                                 double* ayy, double* ast)
-{
-    if (MeshElement->geo_type == 1)
-    {
-        CalcOverlandCoefficientsLine(head, axx, ast);
-        ayy = 0;
-    }
-    else if (MeshElement->geo_type == 2)
-        CalcOverlandCoefficientsQuad(head, axx, ayy, ast);
-    else if (MeshElement->geo_type == 4)
-        CalcOverlandCoefficientsTri(head, axx, ayy, ast);
-    else
-        std::cout << "Error in CFiniteElementStd::CalcOverlandCoefficients !!!";
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task:  calculate topology coefficientsfor overland CVFEM, line elements
-   Programing:
-   08/2006 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCoefficientsLine(double* head, double* axx,
-                                                     double* ast)
-{
-    double dx, dy;  // WW, dzx;
-    double delt, dhds;
-    double fric, width, eslope, slope_exp;
-
-    fric = MediaProp->friction_coefficient;
-    slope_exp = MediaProp->friction_exp_slope;
-    width = MediaProp->overland_width;
-
-    dx = X[1] - X[0];
-    dy = Y[1] - Y[0];
-    // WW dzx = Z[1] - Z[0];
-    delt = sqrt(dx * dx + dy * dy);
-    dhds = fabs((head[0] - head[1]) / delt);
-
-    GetOverlandBasisFunctionMatrix_Line();
-
-    dhds = MMax(1.0e-10, dhds);
-    eslope = 1.0 / dhds;
-    eslope = pow(eslope, 1 - slope_exp);
-
-    *axx = eslope * fric * width / delt;
-    *ast = delt * width / (double)(nnodes * dt);
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task:  calculate topology coefficientsfor overland CVFEM, rectangles
-   Programing:
-   08/2006 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCoefficientsQuad(double* head, double* axx,
-                                                     double* ayy, double* ast)
-{
-    double dx, dy, dzx, dzy;
-    double delt;
-    double dhds, GradH[2];
-    double fric, eslope, slope_exp;
-
-    fric = MediaProp->friction_coefficient;
-    slope_exp = MediaProp->friction_exp_slope;
-
-    /////////////////////////////
-    dx = X[1] - X[0];  // ell
-    dy = Y[3] - Y[0];  // ett
-    dzx = Z[1] - Z[0];
-    dzy = Z[3] - Z[0];
-    dx = sqrt(dx * dx + dzx * dzx);
-    dy = sqrt(dy * dy + dzy * dzy);
-    delt = dx * dy;
-
-    GetOverlandBasisFunctionMatrix_Quad();
-
-    GradH[0] = (head[0] - head[1] - head[2] + head[3]) / (2.0 * dx);
-    GradH[1] = (head[0] + head[1] - head[2] - head[3]) / (2.0 * dy);
-    // dh/ds (dh in the direction of maximum slope)
-    dhds = sqrt((GradH[0] * GradH[0]) + (GradH[1] * GradH[1]));
-    dhds = MMax(1.0e-10, dhds);
-    eslope = 1.0 / dhds;
-    eslope = pow(eslope, 1 - slope_exp);
-
-    *axx = eslope * fric * dy / dx;  // ett/ell
-    *ayy = eslope * fric * dx / dy;
-    *ast = delt / (double)(nnodes * dt);
-}
-/**************************************************************************
-   FEMLib-Method:
-   Task:  calculate topology coefficientsfor overland CVFEM, triangles
-   Programing:
-   08/2006 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::CalcOverlandCoefficientsTri(double* head, double* axx,
-                                                    double* ayy, double* ast)
-{
-    double x2, x3, y2, y3;
-    double delt, delt2, delt2inv, b[3], g[3];
-    double dhds, GradH[2];
-    double fric, eslope, slope_exp;
-
-    fric = MediaProp->friction_coefficient;
-    slope_exp = MediaProp->friction_exp_slope;
-
-    x2 = X[1] - X[0];
-    x3 = X[2] - X[0];
-    y2 = Y[1] - Y[0];
-    y3 = Y[2] - Y[0];
-    delt = (x2 * y3 - x3 * y2) * 0.5;
-    delt2 = 2.0 * delt;
-    delt2inv = 1.0 / delt2;
-
-    /////////////////////  GetOverlandBasisFunctionMatrix_Tri()
-    b[0] = (y2 - y3) * delt2inv;
-    b[1] = y3 * delt2inv;
-    b[2] = -y2 * delt2inv;
-    g[0] = (x3 - x2) * delt2inv;
-    g[1] = -x3 * delt2inv;
-    g[2] = x2 * delt2inv;
-
-    for (int i = 0; i < nnodes; i++)
-        for (int j = 0; j < nnodes; j++)
-        {
-            edlluse[i * nnodes + j] = b[i] * b[j];
-            edttuse[i * nnodes + j] = g[i] * g[j];
-        }
-    //////////////////////////
-
-    GradH[0] = (b[0] * head[0] + b[1] * head[1] + b[2] * head[2]);
-    GradH[1] = (g[0] * head[0] + g[1] * head[1] + g[2] * head[2]);
-    // dh/ds (dh in the direction of maximum slope)
-    dhds = sqrt((GradH[0] * GradH[0]) + (GradH[1] * GradH[1]));
-    dhds = MMax(1.0e-10, dhds);
-    eslope = 1.0 / dhds;
-
-    eslope = pow(eslope, 1 - slope_exp);
-    *axx = eslope * fric * delt;
-    *ayy = eslope * fric * delt;
-    *ast = delt / (double)(nnodes * dt);
-}
-
 /**************************************************************************
    FEMLib-Method:
    Task: Calculate nodal enthalpy
@@ -6305,104 +5796,6 @@ void CFiniteElementStd::Assemble_Gravity_Multiphase()
    }
  */
 
-#ifdef OGS_USE_CVODE
-/**
- * @brief Wrapper function to interface conversion_rate with SUNDIALS CVode
- * solver
- */
-int cvRhsFn_conversion_rate(realtype t, N_Vector y, N_Vector ydot,
-                            void* user_data)
-{
-    conversion_rate& conv_rate = *(conversion_rate*)user_data;
-
-    Eigen::VectorXd y_eig = Eigen::VectorXd::Zero(1);
-    y_eig(0) = NV_Ith_S(y, 0);
-
-    Eigen::VectorXd dydx_eig = Eigen::VectorXd::Zero(1);
-
-    conv_rate.eval(t, y_eig, dydx_eig);
-
-    NV_Ith_S(ydot, 0) = dydx_eig(0);
-
-    return 0;
-}
-
-/**
- * @brief Solves reaction kinetics using SUNDIALS CVode solver
- * @param y_ini      initial value y
- * @param delta_t    time step
- * @param conv_rate  conversion rate object that supplies the rhs of the ode
- * @param y_fin      output parameter of y at the end of integration
- * @param dydt_fin   output parameter of dy/dt at the end of integration
- */
-void cvode_conversion_rate(const double y_ini, double delta_t,
-                           conversion_rate* conv_rate, double& y_fin,
-                           double& dydt_fin)
-{
-    const realtype T0 = 0.0;
-    const int NEQ = 1;
-
-    /* Create serial vector of length NEQ for I.C. and abstol */
-    N_Vector y = N_VNew_Serial(NEQ);
-    // if (check_flag((void *)y, "N_VNew_Serial", 0)) return(1);
-    N_Vector abstol = N_VNew_Serial(NEQ);
-    // if (check_flag((void *)abstol, "N_VNew_Serial", 0)) return(1);
-
-    // set initial condition
-    // rho_s, reactive fraction
-    NV_Ith_S(y, 0) = y_ini;
-
-    /* Set the scalar relative tolerance */
-    realtype reltol = 1e-10;
-    /* Set the vector absolute tolerance */
-    NV_Ith_S(abstol, 1) = 1e-10;
-
-    void* cvode_mem = CVodeCreate(CV_ADAMS, CV_FUNCTIONAL);
-    // if (check_flag((void *)cvode_mem, "CVodeCreate", 0)) return(1);
-
-    /* Call CVodeInit to initialize the integrator memory and specify the
-     * user's right hand side function in y'=f(t,y), the inital time T0, and
-     * the initial dependent variable vector y. */
-    int flag = CVodeInit(cvode_mem, cvRhsFn_conversion_rate, T0, y);
-    // if (check_flag(&flag, "CVodeInit", 1)) return(1);
-
-    flag = CVodeSetUserData(cvode_mem, (void*)conv_rate);
-
-    /* Call CVodeSVtolerances to specify the scalar relative tolerance
-     * and vector absolute tolerances */
-    flag = CVodeSVtolerances(cvode_mem, reltol, abstol);
-    // if (check_flag(&flag, "CVodeSVtolerances", 1)) return(1);
-
-    /* Call CVDense to specify the CVDENSE dense linear solver */
-    flag = CVDense(cvode_mem, NEQ);
-    // if (check_flag(&flag, "CVDense", 1)) return(1);
-
-    realtype t;
-    flag = CVode(cvode_mem, delta_t, y, &t, CV_NORMAL);
-    // std::cout << "result at time " << t << " is " << NV_Ith_S(y,0) <<
-    // std::endl;
-    if (flag != CV_SUCCESS)
-    {
-        std::cerr << "ERROR at " << __FUNCTION__ << ":" << __LINE__
-                  << std::endl;
-    }
-
-    N_Vector ydot = N_VNew_Serial(NEQ);
-
-    y_fin = NV_Ith_S(y, 0);
-    flag = cvRhsFn_conversion_rate(delta_t, y, ydot, conv_rate);
-    dydt_fin = NV_Ith_S(ydot, 0);
-
-    /* Free y and abstol vectors */
-    N_VDestroy_Serial(y);
-    N_VDestroy_Serial(ydot);
-    N_VDestroy_Serial(abstol);
-
-    /* Free integrator memory */
-    CVodeFree(&cvode_mem);
-}
-#endif
-
 // HS, TN 07/2013 Calculates Reaction rate
 void CFiniteElementStd::CalcSolidDensityRate()
 {
@@ -6452,9 +5845,6 @@ void CFiniteElementStd::CalcSolidDensityRate()
             T_s = T_g;  // avoid compiler warning;
         }
 
-        // get time step size
-        const double delta_t = pcs->Tim->time_step_length;
-
         // TODO [CL] Why?
         // poro = mmp_vector[group]->porosity;
         const double poro = MediaProp->Porosity(Index, pcs->m_num->ls_theta);
@@ -6477,40 +5867,23 @@ void CFiniteElementStd::CalcSolidDensityRate()
             else
             {  // Fuer CaOH2 im Moment
 
-                pcs->m_conversion_rate->update_param(
-                    T_s, T_g, p_g / 1.0e5, w_mf, gp_ele->rho_s_prev[gp],
-                    1.0 - poro, delta_t, SolidProp->getSolidReactiveSystem());
-
-#ifdef OGS_USE_CVODE
-                const double xv_NR =
-                    SolidProp->non_reactive_solid_volume_fraction;
-                const double rho_NR = SolidProp->non_reactive_solid_density;
-                double y_new, y_dot_new;
-                cvode_conversion_rate(
-                    (gp_ele->rho_s_prev[gp] - xv_NR * rho_NR) / (1.0 - xv_NR),
-                    delta_t, pcs->m_conversion_rate, y_new, y_dot_new);
-
-                double rho_react;
-
-                // cut off when limits are reached
-                if (y_new < SolidProp->lower_solid_density_limit)
-                    rho_react = SolidProp->lower_solid_density_limit;
-                else if (y_new > SolidProp->upper_solid_density_limit)  //{
-                    rho_react = SolidProp->upper_solid_density_limit;
-                else
-                    rho_react = y_new;
-
-                // TN - reactive fraction
-                gp_ele->rho_s_curr[gp] =
-                    (1.0 - xv_NR) * rho_react + xv_NR * rho_NR;
-
-                gp_ele->q_R[gp] = y_dot_new * (1.0 - xv_NR);
-#else
-                std::cout << "Error: CMake option OGS_USE_CVODE needs to be "
-                             "set to solve this process type!"
-                          << std::endl;
-                exit(1);
-#endif
+                // integrated together with the other Gauss points after the
+                // element loop, see CRFProcess::CalIntegrationPointValue()
+                FiniteElement::ReactiveGaussPoint pnt;
+                pnt.T_solid = T_s;
+                pnt.T_gas = T_g;
+                pnt.p_gas = p_g / 1.0e5;
+                pnt.w_water = w_mf;
+                pnt.rho_s_prev = gp_ele->rho_s_prev[gp];
+                pnt.phi_solid = 1.0 - poro;
+                pnt.system = SolidProp->getSolidReactiveSystem();
+                pnt.xv_NR = SolidProp->non_reactive_solid_volume_fraction;
+                pnt.rho_NR = SolidProp->non_reactive_solid_density;
+                pnt.rho_lower = SolidProp->lower_solid_density_limit;
+                pnt.rho_upper = SolidProp->upper_solid_density_limit;
+                pnt.rho_s_curr = &gp_ele->rho_s_curr[gp];
+                pnt.q_R = &gp_ele->q_R[gp];
+                pcs->m_reaction_integrator->add(pnt);
             }
         }
         else
@@ -8157,6 +7530,7 @@ void CFiniteElementStd::add2GlobalMatrixII()
 
         local_vec = NodalVal;
         local_matrix = Laplace->getEntryArray();  // Temporary use
+        const bool batch_assembly = eqs->isBatchAssembly();
         for (i = 0; i < m_dim; i++)
         {
             i_dom = i / act_nodes;
@@ -8169,6 +7543,15 @@ void CFiniteElementStd::add2GlobalMatrixII()
                 MeshElement->nodes[local_idx[in]]->GetEquationIndex() * dof +
                 i_dom;
 
+            // The rows of the active nodes are added to the assembly buffer
+            // directly, without the copy to local_matrix.
+            if (batch_assembly)
+            {
+                eqs->addMatrixEntries(1, &idxm[i], n_dim, idxn,
+                                      &loc_m[i_full]);
+                continue;
+            }
+
             for (int j = 0; j < dim_full; j++)
             {
                 local_matrix[i * dim_full + j] = loc_m[i_full + j];
@@ -8237,7 +7620,8 @@ void CFiniteElementStd::add2GlobalMatrixII()
     os_t.close();
 #endif  // ifdef assmb_petsc_test
 
-    eqs->addMatrixEntries(m_dim, idxm, n_dim, idxn, local_matrix);
+    if (act_nodes == nnodes || !eqs->isBatchAssembly())
+        eqs->addMatrixEntries(m_dim, idxm, n_dim, idxn, local_matrix);
     eqs->setArrayValues(1, m_dim, idxm, local_vec);
     // eqs->AssembleRHS_PETSc();
     // eqs->AssembleMatrixPETSc(MAT_FINAL_ASSEMBLY );
@@ -8372,7 +7756,7 @@ void CFiniteElementStd::CalcFEM_FCT()
     //----------------------------------------------------------------------
     // Initialize FCT flux with consistent mass matrix: f_ij = m_ij
     //----------------------------------------------------------------------
-    Math_Group::SparseMatrixDOK* FCT_Flux = this->pcs->FCT_AFlux;
+    FiniteElement::FCTFluxCRS* FCT_Flux = this->pcs->FCT_AFlux;
     for (int i = 0; i < nnodes; i++)
     {
         long node_i_id = this->MeshElement->nodes_index[i];
@@ -8385,8 +7769,8 @@ void CFiniteElementStd::CalcFEM_FCT()
             if (v == .0)
                 v = (*this->Mass)(j, i);  // look for inner nodes
 #endif
-            (*FCT_Flux)(node_i_id, node_j_id) += v;
-            (*FCT_Flux)(node_j_id, node_i_id) += v;
+            FCT_Flux->add(node_i_id, node_j_id, v);
+            FCT_Flux->add(node_j_id, node_i_id, v);
         }
     }
 
@@ -8712,60 +8096,36 @@ void CFiniteElementStd::AssembleMixedHyperbolicParabolicEquation()
    06/2007 JOD Separation of 1D channel and overland flow
             Introduction of rill depth
          Surface structure with parameter rill_epsilon in st-file
+   11/2018 Residual and Jacobian evaluated by the kernels of
+           OverlandFlowKernels, element geometry cached
 **************************************************************************/
 void CFiniteElementStd::AssembleParabolicEquationNewton()
 {
 #if !defined(USE_PETSC)  // && !defined(other parallel libs)//03~04.3012. WW
     double haaOld[4], haa[4];
-    int nidx;
-    double axx = 0, ayy = 0, ast = 0.0, ckwr[16];
-    double swval[4], swold[4];
-    double residual[4];
-    double** jacobian;
-    double** amat;
-    int iups[16];
-
-    jacobian = (double**)Malloc(nnodes * sizeof(double));
-    amat = (double**)Malloc(nnodes * sizeof(double));
-    for (int i = 0; i < nnodes; i++)
+    double residual[4], jacobian[16];
+
+    const OverlandElementGeometry* geometry = overland_geometry->get(
+        MeshElement->GetIndex(), MeshElement->geo_type, X, Y, Z);
+    if (!geometry)
     {
-        jacobian[i] = (double*)Malloc(nnodes * sizeof(double));
-        amat[i] = (double*)Malloc(nnodes * sizeof(double));
+        std::cout << "Error in CFiniteElementStd::"
+                     "AssembleParabolicEquationNewton: element type not "
+                     "supported for overland flow !!!"
+                  << "\n";
+        return;
     }
 
-    //////////////////////////// initialize with 0
-    MNulleMat(ckwr, nnodes, nnodes);
-    MNulleMat(edlluse, nnodes, nnodes);
-    MNulleMat(edttuse, nnodes, nnodes);
-    for (int i = 0; i < nnodes; i++)
-        for (int j = 0; j < nnodes; j++)
-        {
-            jacobian[i][j] = 0;
-            amat[i][j] = 0;
-        }
-
     /////////////////////////// fetch head (depth)
-    nidx = pcs->GetNodeValueIndex("HEAD");
-
+    const int nidx = pcs->GetNodeValueIndex("HEAD");
     for (int i = 0; i < nnodes; i++)
     {
         haa[i] = pcs->GetNodeValue(nodes[i], nidx + 1);
         haaOld[i] = pcs->GetNodeValue(nodes[i], nidx);
     }
-    ///////////////////////////// assemble upwinded coefficients
-    CalcOverlandCoefficients(haa, &axx, &ayy, &ast);
-    // compute axx, ayy, ast  basis functions edlluse, edttuse (element topology
-    // (with friction coef and inv. headdiff))
-    CalcOverlandNLTERMS(haa, haaOld, swval, swold);
-    // compute swval, swold, introduces surface structure in storage term
-    CalcOverlandCKWR(haa, ckwr, iups);
-    // compute ckwr, iups,  upstream weighting, hydraulic radius for channel
-    CalcOverlandUpwindedCoefficients(amat, ckwr, axx, ayy);
-    // Form elemental matrix
     /////////////////////////// form residual vector and jacobi matrix
-    CalcOverlandResidual(haa, swval, swold, ast, residual, amat);
-    AssembleParabolicEquationNewtonJacobian(jacobian, haa, haaOld, axx, ayy,
-                                            amat, ast, swold, residual, iups);
+    assembleOverlandNewton(*geometry, OverlandFlowParameters(*MediaProp), haa,
+                           haaOld, dt, residual, jacobian);
     /////////////////////////// store
     for (int i = 0; i < nnodes; i++)
     {
@@ -8780,95 +8140,17 @@ void CFiniteElementStd::AssembleParabolicEquationNewton()
 #if defined(NEW_EQS)  // WW
             (*pcs->eqs_new->A)(NodeShift[problem_dimension_dm] + eqs_number[i],
                                NodeShift[problem_dimension_dm] +
-                                   eqs_number[j]) += jacobian[i][j];  // WW
+                                   eqs_number[j]) +=
+                jacobian[i * nnodes + j];  // WW
 #else
             MXInc(NodeShift[problem_dimension_dm] + eqs_number[i],
                   NodeShift[problem_dimension_dm] + eqs_number[j],
-                  jacobian[i][j]);
+                  jacobian[i * nnodes + j]);
 #endif
     }
-
-    for (int i = 0; i < nnodes; i++)
-    {
-        free(jacobian[i]);
-        free(amat[i]);
-    }
-    free(jacobian);
-    free(amat);
 #endif
 }
 
-/**************************************************************************
-   FEMLib-Method:
-   Task: Calculates jacobi matrix for AssembleParabolicEquationNewton()
-      be carefull with epsilon
-   Programing:
-   06/2007 JOD Implementation
-**************************************************************************/
-void CFiniteElementStd::AssembleParabolicEquationNewtonJacobian(
-    double** jacob,
-    double* haa,
-    double* hOld,
-    double axx,
-    double ayy,
-    double** amat,
-    double ast,
-    double* swold,
-    double* residual,
-    int* iups)
-{
-    // double** jacob;
-    double hEps[4], hKeep[4], swval_eps[4];
-    double sumjac, stor_eps, akrw, remember;
-    double epsilon = 1.e-7;  // be carefull, like in primary variable dependent
-                             // source terms (critical depth, normal depth)
-
-    /* jacob = (double**) Malloc(nnodes * sizeof(double));
-       for (int i = 0; i < nnodes; i++)
-       jacob[i] = (double*) Malloc(nnodes*sizeof(double));
-       for (int i = 0; i < nnodes; i++)
-       for (int j = 0; j < nnodes; j++)
-         jacob[i][j]= 0.0;
-     */
-    for (int i = 0; i < nnodes; i++)
-    {
-        hEps[i] = haa[i] + epsilon;
-        hKeep[i] = haa[i];
-    }
-
-    CalcOverlandNLTERMS(hEps, hOld, swval_eps, swold);
-    // compute swval_eps, swold, introduces surface structure in storage term
-
-    for (int i = 0; i < nnodes; i++)  // Form jacobian !
-    {
-        remember = haa[i];
-        haa[i] = hEps[i];
-        sumjac = 0.0;
-
-        for (int j = 0; j < nnodes; j++)
-            if (i != j)  // nondiagonal
-            {
-                CalcOverlandCKWRatNodes(i, j, haa, &akrw, iups);
-                // compute ckwr, iups,  upstream weighting, hydraulic radius for
-                // channel
-                jacob[j][i] = CalcOverlandJacobiNodes(i, j, haa, hKeep, akrw,
-                                                      axx, ayy, amat, &sumjac) /
-                              epsilon;
-                // if(MediaProp->channel ==1)
-                // sumjac +=  swval_eps[i] * ast * (Haa[i] - Hold[i]);
-            }  // end if (i!=j)
-        // end j
-
-        // Compute diagonal for row i, Lump the storage term
-        stor_eps = ast * (swval_eps[i] - swold[i]);
-        sumjac = sumjac + stor_eps;
-        jacob[i][i] = (sumjac - residual[i]) / epsilon;
-        haa[i] = remember;
-    }  // end i
-
-    // return jacob;
-}
-
 /***************************************************************************
    GeoSys - Funktion:
            CFiniteElementStd:: Assemby_strainCPL
@@ -10377,6 +9659,22 @@ void ElementValue::GetEleVelocity(double* vec)
     }
 }
 
+void ElementValue::RegisterStepState(StepSnapshot& snapshot)
+{
+    snapshot.add(Velocity.getEntryArray(), Velocity.Size());
+#ifdef USE_TRANSPORT_FLUX
+    snapshot.add(TransportFlux.getEntryArray(), TransportFlux.Size());
+#endif
+    snapshot.add(Velocity_g.getEntryArray(), Velocity_g.Size());
+    if (pcs->getProcessType() == FiniteElement::TNEQ ||
+        pcs->getProcessType() == FiniteElement::TES)
+    {
+        snapshot.add(rho_s_prev, Velocity.Cols());
+        snapshot.add(rho_s_curr, Velocity.Cols());
+        snapshot.add(q_R, Velocity.Cols());
+    }
+}
+
 // WW
 ElementValue::~ElementValue()
 {
@@ -87,6 +87,9 @@ using Math_Group::SymMatrix;
 using Math_Group::Vec;
 using process::CRFProcessDeformation;
 
+class OverlandFlowGeometryCache;
+class StepSnapshot;
+
 class CFiniteElementStd : public CElement
 {
 public:
@@ -180,58 +183,6 @@ public:
     // OK
     void AssembleParabolicEquationRHSVector();
 
-    // CVFEM functions for overland flow   JOD
-    // to move
-    void GetOverlandBasisFunctionMatrix_Line();
-    // to move
-    void GetOverlandBasisFunctionMatrix_Quad();
-    void CalcOverlandCoefficients(double* head,
-                                  double* axx,
-                                  double* ayy,
-                                  double* ast);
-    void CalcOverlandCoefficientsLine(double* head, double* axx, double* ast);
-    void CalcOverlandCoefficientsQuad(double* head,
-                                      double* axx,
-                                      double* ayy,
-                                      double* ast);
-    void CalcOverlandCoefficientsTri(double* head,
-                                     double* axx,
-                                     double* ayy,
-                                     double* ast);
-    void CalcOverlandNLTERMS(double* H,
-                             double* HaaOld,
-                             double* swval,
-                             double* swold);
-    void CalcOverlandNLTERMSRills(double* H,
-                                  double* HaaOld,
-                                  double* swval,
-                                  double* swold);
-    void CalcOverlandNLTERMSChannel(double* H,
-                                    double* HaaOld,
-                                    double* swval,
-                                    double* swold);
-    void CalcOverlandCKWR(double* head, double* ckwr, int* iups);
-    void CalcOverlandCKWRatNodes(
-        int i, int j, double* head, double* ckwr, int* iups);
-    void CalcOverlandResidual(double* head,
-                              double* swval,
-                              double* swold,
-                              double ast,
-                              double* residuall,
-                              double** amat);
-    double CalcOverlandJacobiNodes(int i,
-                                   int j,
-                                   double* depth,
-                                   double* depth_keep,
-                                   double akrw,
-                                   double axx,
-                                   double ayy,
-                                   double** amatij,
-                                   double* sumjac);
-    void CalcOverlandUpwindedCoefficients(double** amat,
-                                          double* ckwr,
-                                          double axx,
-                                          double ayy);
     //
     // CB added by CB: 090507
     void UpwindAlphaMass(double* alpha);
@@ -330,8 +281,8 @@ private:
         heat_capacity, heat_conductivity, viscosity;
 
     //
-    double* edlluse;  // WW edlluse[16]
-    double* edttuse;  // WW edlluse[16]
+    // CVFEM overland flow, element geometry cached over all iterations
+    OverlandFlowGeometryCache* overland_geometry;
 
     // Local matrices
     Matrix* Mass;  // CB symMatrix *Mass; // unsymmetric in case of upwinding
@@ -429,17 +380,6 @@ protected:
     void AssembleParabolicEquation();  // OK4104
     void AssembleMixedHyperbolicParabolicEquation();
     void AssembleParabolicEquationNewton();
-    // JOD
-    void AssembleParabolicEquationNewtonJacobian(double** jacob,
-                                                 double* Haa,
-                                                 double* HaaOld,
-                                                 double axx,
-                                                 double ayy,
-                                                 double** amat,
-                                                 double ast,
-                                                 double* swold,
-                                                 double* residuall,
-                                                 int* iups);
     void Assemble_strainCPL(
         const int phase = 0);  // Assembly of strain coupling
     void Assemble_strainCPL_Matrix(const double fac, const int phase = 0);
@@ -522,6 +462,8 @@ public:
     // SB 09/2010
     void getIPvalue_vec_phase(const int IP, int phase, double* vec);
     void GetEleVelocity(double* vec);
+    /// Registers the Gauss point values changed by a time step.
+    void RegisterStepState(StepSnapshot& snapshot);
     Matrix Velocity;
 
     // HS Thermal Storage parameters---------------
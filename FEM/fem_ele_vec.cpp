@@ -21,6 +21,7 @@
 #include "matrix_class.h"
 #include "matrix_routines.h"
 #include "pcs_dm.h"
+#include "StepSnapshot.h"
 
 #include "PhysicalConstant.h"
 
@@ -3944,6 +3945,22 @@ void ElementValue_DM::ResetStress(bool cpl_loop)
     }
 }
 
+void ElementValue_DM::RegisterStepState(StepSnapshot& snapshot)
+{
+    Matrix* const values[] = {Stress_i,    Stress_j,   pStrain,    y_surface,
+                              prep0,       e_i,        xi,         Strain_Kel,
+                              Strain_Max,  Strain_pl,  Strain_t_ip, e_pl,
+                              ev_loc_nr_res, lambda_pl, Strain};
+    for (std::size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+        if (values[i])
+            snapshot.add(values[i]->getEntryArray(), values[i]->Size());
+    // Stress points to Stress_i or Stress_j
+    snapshot.add(&Stress, 1);
+    snapshot.add(&disp_j, 1);
+    snapshot.add(&tract_j, 1);
+    snapshot.add(&Localized, 1);
+}
+
 ElementValue_DM::~ElementValue_DM()
 {
     delete Stress0;
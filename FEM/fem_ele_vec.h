@@ -46,6 +46,7 @@ class CElem;
 namespace FiniteElement
 {
 enum ProcessType;
+class StepSnapshot;
 
 // Vector for storing element values
 class ElementValue_DM
@@ -59,6 +60,8 @@ public:
     void Read_BIN(std::fstream& is);
     void ReadElementStressASCI(std::fstream& is);
     double MeanStress(const int gp);
+    /// Registers the stresses and internal variables changed by a time step.
+    void RegisterStepState(StepSnapshot& snapshot);
 
 private:
     // Friend class
@@ -1552,6 +1552,68 @@ void CSparseMatrix::multiVec(double* vec_s, double* vec_r)
     }
 }
 
+/*\!
+ ********************************************************************
+   Perform A*x for the rows of the nodes first_row,...,last_row-1, i.e.
+   the entries i + k * rows, first_row <= i < last_row, k < DOF, of
+   vec_r. The other entries of vec_r are not touched. With symmetric
+   storage a row is not complete, so the product has to be computed
+   with multiVec(vec_s, vec_r).
+ ********************************************************************/
+void CSparseMatrix::multiVec(double* vec_s, double* vec_r, const long first_row,
+                             const long last_row)
+{
+    long i, j, k, ii, jj, kk, ll, idof, jdof, counter;
+    for (idof = 0; idof < DOF; idof++)
+        for (ii = first_row; ii < last_row; ii++)
+            vec_r[idof * rows + ii] = 0.0;
+    //
+    if (storage_type == CRS)
+    {
+        for (ii = first_row; ii < last_row; ii++)
+            for (j = num_column_entries[ii]; j < num_column_entries[ii + 1];
+                 j++)
+            {
+                jj = entry_column[j];
+                for (idof = 0; idof < DOF; idof++)
+                {
+                    kk = idof * rows + ii;
+                    for (jdof = 0; jdof < DOF; jdof++)
+                    {
+                        ll = jdof * rows + jj;
+                        k = (idof * DOF + jdof) * size_entry_column + j;
+                        vec_r[kk] += entry[k] * vec_s[ll];
+                    }
+                }
+            }
+    }
+    else if (storage_type == JDS)
+    {
+        for (ii = first_row; ii < last_row; ii++)
+        {
+            // Entries of the row are in the jagged diagonals k with more
+            // than i entries, at i after the start of the diagonal.
+            i = row_index_mapping_o2n[ii];
+            counter = i;
+            for (k = 0; k < max_columns && i < num_column_entries[k]; k++)
+            {
+                jj = entry_column[counter];
+                for (idof = 0; idof < DOF; idof++)
+                {
+                    kk = idof * rows + ii;
+                    for (jdof = 0; jdof < DOF; jdof++)
+                    {
+                        ll = jdof * rows + jj;
+                        j = (idof * DOF + jdof) * size_entry_column + counter;
+                        vec_r[kk] += entry[j] * vec_s[ll];
+                    }
+                }
+                counter += num_column_entries[k];
+            }
+        }
+    }
+}
+
 /*\!
  ********************************************************************
    Perform A^T*x
@@ -569,6 +569,9 @@ public:
     void operator-=(const CSparseMatrix& m);
     // Vector pass through augment and bring results back.
     void multiVec(double* vec_s, double* vec_r);
+    // Rows of the nodes first_row,...,last_row-1 of the product
+    void multiVec(double* vec_s, double* vec_r, const long first_row,
+                  const long last_row);
     void Trans_MultiVec(double* vec_s, double* vec_r);
     void Diagonize(const long idiag, const double b_given, double* b);
     //
@@ -576,6 +579,7 @@ public:
     double& operator()(const long i, const long j = 0) const;
     //
     StorageType GetStorageType() const { return storage_type; }  // 05.2011. WW
+    bool IsSymmetric() const { return symmetry; }
     long Dim() const { return DOF * rows; }
     int Dof() const { return DOF; }
     void SetDOF(const int dof_n)  //_new. 02/2010. WW
@@ -38,7 +38,9 @@ double time_ele_paral;
 
 #include <math.h>
 // C++ STL
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 #include "rf_pcs.h"
 
@@ -71,6 +73,31 @@ using Math_Group::SparseTable;
 
 #if defined(USE_MPI)
 using MeshLib::CFEMesh;
+
+/*!
+   Border entries shared with the neighbouring subdomains.
+*/
+struct CPARDomain::BorderExchange
+{
+    /// Position of the local border entries in the local vectors
+    std::vector<long> local_ids;
+    /// Neighbour ranks in ascending order. The first n_lower of them are
+    /// smaller than the rank of this subdomain.
+    std::vector<int> ranks;
+    std::size_t n_lower;
+    /// Local border entries shared with ranks[k] are
+    /// entries[ptr[k]],...,entries[ptr[k+1]-1], sorted by the global border
+    /// index, so that both sides of a message agree on its layout.
+    std::vector<long> ptr;
+    std::vector<long> entries;
+    //
+    std::vector<double> send_buffer;
+    std::vector<double> recv_buffer;
+    std::vector<double> sum;
+    std::vector<MPI_Request> requests;
+    /// Whether the border entries of the current exchange are sent
+    bool sent;
+};
 #endif
 /**************************************************************************
    STRLib-Method:
@@ -368,6 +395,8 @@ CPARDomain::CPARDomain(void)
     receive_disp_i = new int[mysize];
     receive_cnt = new int[mysize];
     receive_disp = new int[mysize];
+    border_exchange = NULL;
+    border_exchanges[0] = border_exchanges[1] = NULL;
 #endif
 }
 
@@ -422,6 +451,10 @@ CPARDomain::~CPARDomain(void)
     receive_disp_i = NULL;
     receive_cnt = NULL;
     receive_disp = NULL;
+    delete border_exchanges[0];
+    delete border_exchanges[1];
+    border_exchanges[0] = border_exchanges[1] = NULL;
+    border_exchange = NULL;
 #endif
 }
 
@@ -470,6 +503,10 @@ void CPARDomain::ReleaseMemory()
     receive_disp_i = NULL;
     receive_cnt = NULL;
     receive_disp = NULL;
+    delete border_exchanges[0];
+    delete border_exchanges[1];
+    border_exchanges[0] = border_exchanges[1] = NULL;
+    border_exchange = NULL;
 }
 #endif
 /**************************************************************************
@@ -1283,6 +1320,11 @@ void CPARDomain::ConfigEQS(CNumerics* m_num, const long n, bool quad)
     }
 #endif
     //
+    // The lists of both element orders are built once, ConfigEQS switches
+    // between them for every process
+    if (!border_exchanges[quadratic ? 1 : 0])
+        SetupBorderExchange();
+    border_exchange = border_exchanges[quadratic ? 1 : 0];
     // long dim = n_loc*dof;
     // MPI_Allreduce(&dim,  &max_dimen, 1, MPI_INT,  MPI_MAX, MPI_COMM_WORLD);
 }
@@ -1697,6 +1739,152 @@ void CPARDomain::ReduceBorderV(double* local_x)
     }
 }
 #endif  // if defined(NEW_BREDUCE)
+/*!
+   Build the lists of the border entries shared with the neighbours for the
+   current element order from the global border indices of all subdomains.
+   Collective on comm_DDC.
+*/
+void CPARDomain::SetupBorderExchange()
+{
+    BorderExchange*& be_order = border_exchanges[quadratic ? 1 : 0];
+    if (!be_order)
+        be_order = new BorderExchange;
+    BorderExchange& be = *be_order;
+    be.local_ids.clear();
+    be.ranks.clear();
+    be.ptr.assign(1, 0);
+    be.entries.clear();
+
+    std::vector<long> border_ids;
+    for (int k = 0; k < nq; k++)
+        for (long i = b_start[k]; i < b_end[k]; i++)
+        {
+            be.local_ids.push_back(i + n_shift[k]);
+            border_ids.push_back(nodes_halo[i]);
+        }
+
+    int rank, size;
+    MPI_Comm_rank(comm_DDC, &rank);
+    MPI_Comm_size(comm_DDC, &size);
+    int n_border = static_cast<int>(border_ids.size());
+    std::vector<int> cnt(size);
+    std::vector<int> disp(size + 1, 0);
+    MPI_Allgather(&n_border, 1, MPI_INT, &cnt[0], 1, MPI_INT, comm_DDC);
+    for (int i = 0; i < size; i++)
+        disp[i + 1] = disp[i] + cnt[i];
+    std::vector<long> all_border_ids(std::max(disp[size], 1));
+    border_ids.push_back(0);  // Keep the send buffer valid if empty
+    MPI_Allgatherv(&border_ids[0], n_border, MPI_LONG, &all_border_ids[0],
+                   &cnt[0], &disp[0], MPI_LONG, comm_DDC);
+    border_ids.pop_back();
+
+    std::vector<long> entry_ids(n_bc, -1);
+    for (long i = 0; i < (long)border_ids.size(); i++)
+        entry_ids[border_ids[i]] = i;
+
+    be.n_lower = 0;
+    std::vector<std::pair<long, long> > shared;
+    for (int j = 0; j < size; j++)
+    {
+        if (j == rank)
+            continue;
+        shared.clear();
+        for (int i = disp[j]; i < disp[j + 1]; i++)
+        {
+            const long ig = all_border_ids[i];
+            if (entry_ids[ig] >= 0)
+                shared.push_back(std::make_pair(ig, entry_ids[ig]));
+        }
+        if (shared.empty())
+            continue;
+        std::sort(shared.begin(), shared.end());
+        be.ranks.push_back(j);
+        if (j < rank)
+            be.n_lower++;
+        for (std::size_t i = 0; i < shared.size(); i++)
+            be.entries.push_back(shared[i].second);
+        be.ptr.push_back((long)be.entries.size());
+    }
+    be.requests.resize(2 * be.ranks.size());
+}
+
+/*!
+   Post the receives of the border entries of the neighbours.
+*/
+void CPARDomain::BeginBorderExchange()
+{
+    BorderExchange& be = *border_exchange;
+    const std::size_t n_neighbors = be.ranks.size();
+    be.send_buffer.resize(be.entries.size() * dof + 1);
+    be.recv_buffer.resize(be.entries.size() * dof + 1);
+    be.sent = false;
+    for (std::size_t k = 0; k < n_neighbors; k++)
+    {
+        const long n = (be.ptr[k + 1] - be.ptr[k]) * dof;
+        MPI_Irecv(&be.recv_buffer[be.ptr[k] * dof], n, MPI_DOUBLE,
+                  be.ranks[k], 0, comm_DDC, &be.requests[k]);
+    }
+}
+
+/*!
+   Send the shared border entries of local_x to the neighbours. The border
+   entries of local_x must not change until EndBorderExchange().
+*/
+void CPARDomain::SendBorderV(const double* local_x)
+{
+    BorderExchange& be = *border_exchange;
+    const std::size_t n_neighbors = be.ranks.size();
+    for (std::size_t k = 0; k < n_neighbors; k++)
+    {
+        double* buffer = &be.send_buffer[be.ptr[k] * dof];
+        for (long i = be.ptr[k]; i < be.ptr[k + 1]; i++)
+        {
+            const long l = be.local_ids[be.entries[i]];
+            for (int ii = 0; ii < dof; ii++)
+                *buffer++ = local_x[l + n_loc * ii];
+        }
+        const long n = (be.ptr[k + 1] - be.ptr[k]) * dof;
+        MPI_Isend(&be.send_buffer[be.ptr[k] * dof], n, MPI_DOUBLE,
+                  be.ranks[k], 0, comm_DDC, &be.requests[n_neighbors + k]);
+    }
+    be.sent = true;
+}
+
+/*!
+   Replace the border entries of local_x by their sums over all subdomains.
+
+   The contributions are summed in the ascending order of the ranks, so that
+   all subdomains get identical values.
+*/
+void CPARDomain::EndBorderExchange(double* local_x)
+{
+    BorderExchange& be = *border_exchange;
+    const std::size_t n_neighbors = be.ranks.size();
+    if (!be.sent)
+        SendBorderV(local_x);
+    if (n_neighbors > 0)
+        MPI_Waitall(2 * n_neighbors, &be.requests[0], MPI_STATUSES_IGNORE);
+
+    const long n_border = (long)be.local_ids.size();
+    be.sum.assign(n_border * dof, 0.0);
+    for (std::size_t k = 0; k <= n_neighbors; k++)
+    {
+        if (k == be.n_lower)  // Own contribution
+            for (long i = 0; i < n_border; i++)
+                for (int ii = 0; ii < dof; ii++)
+                    be.sum[i * dof + ii] +=
+                        local_x[be.local_ids[i] + n_loc * ii];
+        if (k == n_neighbors)
+            break;
+        double const* buffer = &be.recv_buffer[be.ptr[k] * dof];
+        for (long i = be.ptr[k]; i < be.ptr[k + 1]; i++)
+            for (int ii = 0; ii < dof; ii++)
+                be.sum[be.entries[i] * dof + ii] += *buffer++;
+    }
+    for (long i = 0; i < n_border; i++)
+        for (int ii = 0; ii < dof; ii++)
+            local_x[be.local_ids[i] + n_loc * ii] = be.sum[i * dof + ii];
+}
 /********************************************************************
    As the title
    Programm:
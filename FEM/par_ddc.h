@@ -99,6 +99,12 @@ private:
     //
     int* receive_cnt;
     int* receive_disp;
+    // Neighbour-only exchange of the border entries, for the linear [0] and
+    // the quadratic [1] element order; border_exchange is the current one.
+    struct BorderExchange;
+    BorderExchange* border_exchanges[2];
+    BorderExchange* border_exchange;
+    void SetupBorderExchange();
 // friend class Math_Group::Linear_EQS;
 //
 #endif
@@ -209,6 +215,28 @@ public:
 #if defined(NEW_BREDUCE)
     void ReduceBorderV(double* local_x);
 #endif
+    /// Sum the border entries of local_x over the neighbouring subdomains,
+    /// which share the border nodes. Only the shared entries are sent to the
+    /// neighbours by nonblocking point to point messages.
+    /// BeginBorderExchange() posts the receives, SendBorderV() sends the
+    /// border entries, and EndBorderExchange() sends them if this was not
+    /// done yet and sums the received ones. The interior entries can be
+    /// computed while the messages are under way.
+    void BeginBorderExchange();
+    void SendBorderV(const double* local_x);
+    void EndBorderExchange(double* local_x);
+    /// Local node ranges [begin, end) of the interior and of the border
+    /// nodes. k = 0: linear nodes, k = 1: nodes of the quadratic elements.
+    int NumNodeRanges() const { return nq; }
+    long InteriorBegin(int k) const { return i_start[k]; }
+    long InteriorEnd(int k) const { return i_end[k]; }
+    long BorderBegin(int k) const { return b_start[k] + n_shift[k]; }
+    long BorderEnd(int k) const { return b_end[k] + n_shift[k]; }
+    void ExchangeBorderV(double* local_x)
+    {
+        BeginBorderExchange();
+        EndBorderExchange(local_x);
+    }
 //
 //
 #endif
@@ -9,6 +9,7 @@
 
 #include "pcs_dm.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <fstream>
@@ -1719,11 +1720,12 @@ double CRFProcessDeformation::NormOfUpdatedNewton()
    Programmaenderungen:
    10/2002   WW   Erste Version
    11/2007   WW   Change to fit the new equation class
+   11/2018        Copy whole columns of the node values
 **************************************************************************/
 
 void CRFProcessDeformation::StoreLastSolution(const int ty)
 {
-    int i, j;
+    int i;
     long number_of_nodes;
     long shift = 0;
 
@@ -1731,8 +1733,8 @@ void CRFProcessDeformation::StoreLastSolution(const int ty)
     for (i = 0; i < pcs_number_of_primary_nvals; i++)
     {
         number_of_nodes = num_nodes_p_var[i];
-        for (j = 0; j < number_of_nodes; j++)
-            ARRAY[shift + j] = GetNodeValue(j, p_var_index[i] - ty);
+        const double* values = nod_val_vector[p_var_index[i] - ty];
+        std::copy(values, values + number_of_nodes, ARRAY + shift);
         shift += number_of_nodes;
     }
 }
@@ -1750,14 +1752,14 @@ void CRFProcessDeformation::StoreLastSolution(const int ty)
    Programmaenderungen:
    10/2002   WW   Erste Version
    11/2007   WW   Change to fit the new equation class
+   11/2018        Exchange whole columns instead of value by value
 **************************************************************************/
 void CRFProcessDeformation::RecoverSolution(const int ty)
 {
-    int i, j, idx;
+    int i, idx;
     long number_of_nodes;
     int Colshift = 1;
     long shift = 0;
-    double tem = 0.0;
 
     int start, end;
 
@@ -1777,23 +1779,12 @@ void CRFProcessDeformation::RecoverSolution(const int ty)
     {
         number_of_nodes = num_nodes_p_var[i];
         idx = p_var_index[i] - Colshift;
-        for (j = 0; j < number_of_nodes; j++)
-        {
-            if (ty < 2)
-            {
-                if (ty == 1)
-                    tem = GetNodeValue(j, idx);
-                SetNodeValue(j, idx, ARRAY[shift + j]);
-                if (ty == 1)
-                    ARRAY[shift + j] = tem;
-            }
-            else if (ty == 2)
-            {
-                tem = ARRAY[shift + j];
-                ARRAY[shift + j] = GetNodeValue(j, idx);
-                SetNodeValue(j, idx, tem);
-            }
-        }
+        double* values = nod_val_vector[idx];
+        // ty = 1, 2: exchange of temp and u; ty = 0: temp --> u
+        if (ty == 1 || ty == 2)
+            std::swap_ranges(values, values + number_of_nodes, ARRAY + shift);
+        else if (ty < 2)
+            std::copy(ARRAY + shift, ARRAY + shift + number_of_nodes, values);
         shift += number_of_nodes;
     }
 }
@@ -2256,6 +2247,9 @@ void CRFProcessDeformation::Trace_Discontinuity()
     int FNodes0[8];
     std::vector<long> SeedElement;
 
+    // Face neighbors are used below, faces are constructed on demand
+    m_msh->ConstructFaces();
+
     locEleFound = 0;
     nPathNodes = 2;  // 2D element
     bFaces = 0;
@@ -2833,12 +2827,20 @@ void CRFProcessDeformation::GlobalAssembly_DM()
         if (!elem->GetMark())  // Marked for use
             continue;
 
-        elem->SetOrder(true);
-        fem_dm->ConfigElement(elem);
-        fem_dm->LocalAssembly(0);
+        ElementAssembly_DM(elem);
     }
 }
 
+/*!  \brief Assembe the element matrix and vector of an element
+      for deformation process
+ */
+void CRFProcessDeformation::ElementAssembly_DM(MeshLib::CElem* elem)
+{
+    elem->SetOrder(true);
+    fem_dm->ConfigElement(elem);
+    fem_dm->LocalAssembly(0);
+}
+
 /**************************************************************************
    FEMLib-Method:
 Task: post process for excavation
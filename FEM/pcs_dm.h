@@ -59,6 +59,7 @@ public:
     // Assemble system equation
     void GlobalAssembly();
     void GlobalAssembly_DM();
+    void ElementAssembly_DM(MeshLib::CElem* elem);
 
     // overloaded
     double Execute(int loop_process_number);
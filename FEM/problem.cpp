@@ -96,6 +96,7 @@ extern int ReadData(const char*,
 #include "rf_kinreact.h"
 
 #include "ShapeFunctionPool.h"
+#include "StepSnapshot.h"
 
 #if defined(USE_PETSC)  // || defined(other parallel libs)//03.3012. WW
 #include "PETSC/PETScLinearSolver.h"
@@ -119,6 +120,7 @@ Problem::Problem(const char* filename)
       print_result(true),
       _linear_shapefunction_pool(NULL),
       _quadr_shapefunction_pool(NULL),
+      _step_snapshot(NULL),
       _geo_obj(new GEOLIB::GEOObjects),
       _geo_name(filename),
       mrank(0),
@@ -664,6 +666,7 @@ Problem::~Problem()
     }
     if (_quadr_shapefunction_pool)
         delete _quadr_shapefunction_pool;
+    delete _step_snapshot;
 
 #if defined(USE_PETSC) || defined(USE_MPI) || defined(USE_MPI_PARPROC) || \
     defined(USE_MPI_REGSOIL) || defined(USE_MPI_GEMS)
@@ -1170,6 +1173,7 @@ void Problem::SetTimeActiveProcesses()
    07/2008 WW Implementation
    01/2009 WW Update
    03/2012 JT Many changes. Allow independent time stepping.
+   11/2018 Restore the state of a rejected step from a snapshot
 **************************************************************************/
 void Problem::Euler_TimeDiscretize()
 {
@@ -1207,6 +1211,25 @@ void Problem::Euler_TimeDiscretize()
         }
     }
 
+    // Adaptive time stepping may reject steps: keep a snapshot of the state at
+    // the beginning of each step for the rollback.
+    if (!isSteadySimulation && !_step_snapshot)
+    {
+        for (i = 0; i < (int)active_process_index.size(); i++)
+        {
+            const TimeControlType::type tc_type =
+                total_processes[active_process_index[i]]
+                    ->Tim->time_control_type;
+            if (tc_type != TimeControlType::INVALID &&
+                tc_type != TimeControlType::FIXED_STEPS)
+            {
+                _step_snapshot = new FiniteElement::StepSnapshot;
+                break;
+            }
+        }
+    }
+    double checkpoint_time = .0;
+
     //
     // ------------------------------------------
     // PERFORM TRANSIENT SIMULATION
@@ -1274,6 +1297,14 @@ void Problem::Euler_TimeDiscretize()
     defined(USE_MPI_REGSOIL) || defined(USE_MPI_GEMS)
         }
 #endif
+        if (_step_snapshot &&
+            (last_dt_accepted || !_step_snapshot->hasCheckpoint()))
+        {
+            const clock_t start = clock();
+            CheckpointStepState();
+            checkpoint_time = double(clock() - start) / CLOCKS_PER_SEC;
+        }
+        const clock_t step_start = clock();
         if (CouplingLoop())
         {
             // ---------------------------------
@@ -1325,6 +1356,20 @@ void Problem::Euler_TimeDiscretize()
             last_dt_accepted = false;
             ScreenMessage(
                 "This step is rejected: Redo, with a new time step.\n");
+            if (_step_snapshot)
+            {
+                const double step_time =
+                    double(clock() - step_start) / CLOCKS_PER_SEC;
+                const clock_t start = clock();
+                _step_snapshot->restore();
+                const double rollback_time =
+                    double(clock() - start) / CLOCKS_PER_SEC;
+                std::cout << "-> Restored "
+                          << _step_snapshot->getNumberOfBytes() / 1048576.0
+                          << " MB in " << rollback_time << " s (checkpoint "
+                          << checkpoint_time << " s, rejected step "
+                          << step_time << " s)\n";
+            }
             rejected_times++;
             current_time -= dt;
             aktuelle_zeit = current_time;
@@ -1739,6 +1784,40 @@ if(has_constrained_bc > 0)
     return accept;
 }
 
+/*-----------------------------------------------------------------------
+   GeoSys - Function: CheckpointStepState
+   Task: Save the state changed by a time step for its rollback
+   Programming:
+   11/2018 Implementation
+-------------------------------------------------------------------------*/
+void Problem::CheckpointStepState()
+{
+    // The state that the reverse copy of the node values does not restore:
+    // the Gauss point values, the stresses and internal variables of the
+    // deformation, and the particles and chemistry that keep no old time
+    // level. Registered anew for every step, arrays may have been
+    // reallocated.
+    _step_snapshot->clear();
+    for (size_t i = 0; i < ele_gp_value.size(); i++)
+        if (ele_gp_value[i])
+            ele_gp_value[i]->RegisterStepState(*_step_snapshot);
+    for (size_t i = 0; i < ele_value_dm.size(); i++)
+        ele_value_dm[i]->RegisterStepState(*_step_snapshot);
+    for (size_t i = 0; i < fem_msh_vector.size(); i++)
+        if (fem_msh_vector[i]->PT)
+            fem_msh_vector[i]->PT->RegisterStepState(*_step_snapshot);
+    // Node values of kinetic reactions not stored in processes
+    for (size_t i = 0; i < KinBlob_vector.size(); i++)
+        if (!KinBlob_vector[i]->Interfacial_area.empty())
+            _step_snapshot->add(&KinBlob_vector[i]->Interfacial_area[0],
+                                KinBlob_vector[i]->Interfacial_area.size());
+#ifdef GEM_REACT
+    if (m_vec_GEM && m_vec_GEM->initialized_flag == 1)
+        m_vec_GEM->RegisterStepState(*_step_snapshot);
+#endif
+    _step_snapshot->checkpoint();
+}
+
 /*-----------------------------------------------------------------------
    GeoSys - Function: pre Coupling loop
    Task: Process solution is beginning. Perform any pre-loop configurations
@@ -1748,30 +1827,27 @@ if(has_constrained_bc > 0)
 -------------------------------------------------------------------------*/
 void Problem::PreCouplingLoop(CRFProcess* m_pcs)
 {
-    if (!last_dt_accepted ||
-        force_post_node_copy)  // if last time step not accepted or values were
-                               // already copied.
-        return;
-    //
     /*For mass transport this routine is only called once (for the overall
-      transport process) and so we need to copy for all transport components*/
+      transport process) and so we need to predict all transport components*/
+    std::vector<CRFProcess*> step_pcs;
     if (m_pcs->getProcessType() == FiniteElement::MASS_TRANSPORT)
     {
-        CRFProcess* c_pcs = NULL;
         for (size_t i = 0; i < pcs_vector.size(); i++)
-        {
-            c_pcs = pcs_vector[i];
-            if (c_pcs->getProcessType() == FiniteElement::MASS_TRANSPORT)
-            {
-                c_pcs->CopyTimestepNODValues();
-                c_pcs->CopyTimestepELEValues();
-            }
-        }
+            if (pcs_vector[i]->getProcessType() ==
+                FiniteElement::MASS_TRANSPORT)
+                step_pcs.push_back(pcs_vector[i]);
     }
-    else
-    {  // Otherwise, just copy this process
-        m_pcs->CopyTimestepNODValues();
-        m_pcs->CopyTimestepELEValues();
+    else  // Otherwise, just this process
+        step_pcs.push_back(m_pcs);
+    //
+    for (size_t i = 0; i < step_pcs.size(); i++)
+    {
+        CRFProcess* c_pcs = step_pcs[i];
+        // Accepted solution (or initial values) at the start of the step
+        if (last_dt_accepted || aktueller_zeitschritt == 1)
+            c_pcs->StorePrimaryVariablesForPredictor(
+                current_time - c_pcs->Tim->time_step_length);
+        c_pcs->PredictPrimaryVariables(current_time);
     }
 }
 
@@ -3789,6 +3865,8 @@ inline double Problem::RandomWalker()
             m_msh = FEMGet("FLUID_MOMENTUM");
         RandomWalk* rw_pcs = NULL;  // By PCH
         rw_pcs = m_msh->PT;
+        // Edges might have been freed after the processes were created
+        m_msh->ConstructFaces();
         if (rw_pcs->getFlowPCS())
         {
             if (rw_pcs->getFlowPCS()->cal_integration_point_value)  // WW
@@ -23,6 +23,7 @@ class CRFProcess;
 namespace FiniteElement
 {
 class ShapeFunctionPool;
+class StepSnapshot;
 }
 namespace FiniteElement
 {
@@ -120,6 +121,12 @@ private:
     FiniteElement::ShapeFunctionPool* _linear_shapefunction_pool;
     FiniteElement::ShapeFunctionPool* _quadr_shapefunction_pool;
 
+    /// State of all processes at the beginning of the current time step,
+    /// restored if the step is rejected. Only created for adaptive time
+    /// stepping.
+    FiniteElement::StepSnapshot* _step_snapshot;
+    void CheckpointStepState();
+
     // Processes
     std::vector<CRFProcess*> total_processes;
     std::vector<CRFProcess*> transport_processes;
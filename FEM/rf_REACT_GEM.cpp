@@ -58,6 +58,7 @@
 #include "rf_mmp_new.h"
 #include "rf_pcs.h"
 #include "rfmat_cp.h"
+#include "StepSnapshot.h"
 // GeoSys-FEMLib for Gauss points
 #include "fem_ele_std.h"
 #include "fem_ele_vec.h"
@@ -887,6 +888,7 @@ short REACT_GEM::Init_RUN(string Project_path)
     {
         //    cout << "main waits for start barrier " << "\n";
 
+        ScheduleGEMNodes();
         gem_barrier_start->wait();  // give the workers the start signal
         //    cout << "main passed start barrier " << "\n";
 
@@ -1181,6 +1183,7 @@ short REACT_GEM::Run_MainLoop()
 #endif
     //  if ( myrank == 0 /*should be set to root*/ )
     {
+        ScheduleGEMNodes();
         gem_barrier_start->wait();
         // cout << "main "<< " passed for start barrier "<<"\n";
 
@@ -1191,6 +1194,12 @@ short REACT_GEM::Run_MainLoop()
         //  cout << "main "<< " waiting for finish barrier "<<"\n";
         gem_barrier_finish->wait();
         // cout << "main "<< " passed for finish barrier "<<"\n";
+        rwmutex.lock();
+#if defined(USE_MPI_GEMS) || defined(USE_PETSC)
+        cout << "MPI task " << myrank << " ";
+#endif
+        gem_scheduler.report(cout, GetTimeOfDayDouble());
+        rwmutex.unlock();
     }
 #ifdef USE_MPI_GEMS
     // For MPI scheme, gather the data here.
@@ -2775,9 +2784,23 @@ int REACT_GEM::ConcentrationToMass(long l /*idx of node*/, int i_timestep)
 
 void REACT_GEM::CopyCurXDCPre(void)
 {
-    long i;
-    for (i = 0; i < nNodes * nDC; i++)
-        m_xDC_pts[i] = m_xDC[i];
+    std::copy(m_xDC, m_xDC + nNodes * nDC, m_xDC_pts);
+}
+
+void REACT_GEM::RegisterStepState(FiniteElement::StepSnapshot& snapshot)
+{
+    snapshot.add(m_porosity, nNodes);
+    snapshot.add(m_fluid_volume, nNodes);
+    snapshot.add(m_gas_volume, nNodes);
+    snapshot.add(m_porosity_Elem, nElems);
+    // The previous time level (_pts) is copied from these at the beginning
+    // of the step
+    snapshot.add(m_soluteB, nNodes * nIC);
+    snapshot.add(m_bIC, nNodes * nIC);
+    snapshot.add(m_xDC, nNodes * nDC);
+    snapshot.add(m_xPH, nNodes * nPH);
+    snapshot.add(m_xPA, nNodes * nPS);
+    snapshot.add(m_bPS, nNodes * nIC * nPS);
 }
 
 void REACT_GEM::UpdateXDCChemDelta(void)
@@ -2789,12 +2812,8 @@ void REACT_GEM::UpdateXDCChemDelta(void)
 
 void REACT_GEM::CopyCurBPre(void)
 {
-    long i;
-    for (i = 0; i < nNodes * nIC; i++)
-    {
-        m_soluteB_pts[i] = m_soluteB[i];
-        m_bIC_pts[i] = m_bIC[i];
-    }
+    std::copy(m_soluteB, m_soluteB + nNodes * nIC, m_soluteB_pts);
+    std::copy(m_bIC, m_bIC + nNodes * nIC, m_bIC_pts);
 }
 
 double REACT_GEM::CalcSoluteBDelta(long in)
@@ -4593,22 +4612,9 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
     //    t_Node->GEM_print_ipm ( "ipm_for_crash_node_init_thread1.txt" );
 
     rwmutex.unlock();
-    // now we set the loop variables
-    int mycount, mystart;
-#if defined(USE_MPI_GEMS)
-    mystart = tid + (myrank * gem_nThread);
-    mycount = gem_nThread * mysize;
-
-//    rwmutex.lock();   //avoid mutual exclusion in the MPI version
-//    cout << "GEMS3K MPI Processe / Thread: " << myrank << " " << tid << "
-//    mystart,mycont: " << mystart << " " << mycount << "\n"; rwmutex.unlock();
-
-// here "myrank" is the index of the CPU Processes, and "mysize" is the number
-// of CPU Processes
-#else
-    mycount = gem_nThread;  // make sure the loop over the nodes counts only the
-                            // threads!
-    mystart = tid;
+    // the nodes are taken from gem_scheduler, which is filled by
+    // ScheduleGEMNodes before the start barrier
+#if !defined(USE_MPI_GEMS)
     int myrank = 0;
     int mysize = 1;
 #endif
@@ -4618,9 +4624,10 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
     //    cout << "thread " << tid << " passed start barrier " << "\n";
     tdummy = GetTimeOfDayDouble();
 
-    for (in = mystart; in < nNodes;
-         in += mycount)  // myrank ist defined vi USE_MPI_GEMS
+    GEMNodeScheduler::Cursor cursor;
+    while (gem_scheduler.nextNode(cursor, in))
     {
+        const double tnode = GetTimeOfDayDouble();
         //       rwmutex.lock();
         //        cout << "GEMS3K MPI Processe / Thread: " << myrank << " " <<
         //        tid << " in " << in << "\n"; rwmutex.unlock();
@@ -4849,7 +4856,9 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
 #if defined(USE_MPI_GEMS)
         REACT_GEM::CopyToMPIBuffer(in);  // copy data to MPI buffer in any case
 #endif
+        m_gem_node_time[in] = GetTimeOfDayDouble() - tnode;
     }  // end for loop for all nodes
+    gem_scheduler.setThreadTimes(tid, tdummy, GetTimeOfDayDouble());
 
     gem_barrier_finish
         ->wait();  // init run finished ...now the init routine takes over
@@ -4865,9 +4874,10 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
 
         repeated_fail = 0;  // set this to zero for each new run_main
 
-        for (in = mystart; in < nNodes;
-             in += mycount)  // myrank ist defined vi USE_MPI_GEMS
+        cursor = GEMNodeScheduler::Cursor();
+        while (gem_scheduler.nextNode(cursor, in))
         {
+            const double tnode = GetTimeOfDayDouble();
             if ((!flag_calculate_boundary_nodes && m_boundary[in]) ||
                 (CalcSoluteBDelta(in) <
                  m_diff_gems))  // do this only without calculation if  on a
@@ -5024,10 +5034,12 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
                     in);  // copy data to MPI buffer in any case
 #endif
             }  // end if check for boundary node12
-        }      // end for loop for all nodes
+            m_gem_node_time[in] = GetTimeOfDayDouble() - tnode;
+        }  // end for loop for all nodes
 
         twait = GetTimeOfDayDouble();  // this if for performance check...init
                                        // waiting time
+        gem_scheduler.setThreadTimes(tid, tdummy, twait);
 
         gem_barrier_finish->wait();  // barrier for synchonizing threads
 
@@ -5063,6 +5075,31 @@ void REACT_GEM::gems_worker(int tid, string m_Project_path)
     }  // end of for loop....
 }
 
+/** ScheduleGEMNodes:
+ * Fills the work queue of the GEMS3K worker threads for the next run. The
+ * nodes are ordered by their GEM solve time of the last run, so that the
+ * expensive nodes are calculated first. With USE_MPI_GEMS every process
+ * keeps its static share of the nodes.
+ * 11/2018
+ */
+void REACT_GEM::ScheduleGEMNodes()
+{
+    if (m_gem_node_time.size() != (size_t)nNodes)
+        m_gem_node_time.assign(nNodes, 0.0);
+
+    vector<long> nodes;
+    nodes.reserve(nNodes);
+    for (long in = 0; in < nNodes; in++)
+    {
+#if defined(USE_MPI_GEMS)
+        if ((in % (gem_nThread * mysize)) / gem_nThread != (unsigned)myrank)
+            continue;
+#endif
+        nodes.push_back(in);
+    }
+    gem_scheduler.prepare(nodes, m_gem_node_time, gem_nThread);
+}
+
 double REACT_GEM::GetTimeOfDayDouble()
 {
     double dtime;
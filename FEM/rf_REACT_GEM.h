@@ -29,6 +29,7 @@
 // #include "rfmat_cp.h"
 #include "GEM/node.h"
 #include "rf_mfp_new.h"
+#include "GEMNodeScheduler.h"
 
 #if defined(USE_PETSC)
 #include "PETSC/PETScLinearSolver.h"
@@ -217,6 +218,9 @@ public:
     void CopyCurXDCPre(void);
     void UpdateXDCChemDelta(void);
     void CopyCurBPre(void);
+    /// Registers the chemical state of all nodes for the rollback of a
+    /// rejected time step
+    void RegisterStepState(FiniteElement::StepSnapshot& snapshot);
     double CalcSoluteBDelta(long in);
     double m_diff_gems;
     void RestoreOldSolution(long in);
@@ -365,6 +369,11 @@ public:
                   // init or write dbrs or cout!
     boost::mutex getnode_mutex;  // used to lock during getnodeindex
     void gems_worker(int tid, string tinit_path);
+    // dynamic distribution of the nodes over the threads, ordered by the
+    // GEM solve time of every node in the last step
+    GEMNodeScheduler gem_scheduler;
+    vector<double> m_gem_node_time;
+    void ScheduleGEMNodes();
 };
 
 #define GEM_FILE_EXTENSION ".gem"
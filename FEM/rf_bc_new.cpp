@@ -29,6 +29,7 @@
 // FileIO
 #include "BoundaryConditionIO.h"
 #include "GeoIO.h"
+#include "NodeValuesBinaryIO.h"
 #include "ProcessIO.h"
 #include "readNonBlankLineFromInputStream.h"
 
@@ -958,6 +959,29 @@ inline void CBoundaryCondition::DirectAssign(CRFProcess* m_pcs,
     double n_val;
     CBoundaryConditionNode* m_node_value = NULL;
 
+    //========================================================================
+    // Binary companion file
+    std::vector<long> node_ids;
+    std::vector<double> values;
+    std::size_t n_columns;
+    if (FileIO::NodeValuesBinaryIO::readCompanion(
+            fname, m_pcs->m_msh->GetNodesNumber(true), 1, node_ids, values,
+            n_columns))
+    {
+        for (std::size_t i = 0; i < node_ids.size(); i++)
+        {
+            m_node_value = new CBoundaryConditionNode;
+            m_node_value->conditional = false;
+            m_node_value->msh_node_number = node_ids[i] + ShiftInNodeVector;
+            m_node_value->geo_node_number = node_ids[i];
+            m_node_value->node_value = values[i];
+            m_node_value->CurveIndex = _curve_index;
+            m_pcs->bc_node.push_back(this);
+            m_pcs->bc_node_value.push_back(m_node_value);
+        }
+        return;
+    }
+
     //========================================================================
     // File handling
     std::ifstream d_file(fname.c_str(), std::ios::in);
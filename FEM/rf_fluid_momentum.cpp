@@ -508,6 +508,7 @@ void CFluidMomentum::ConstructFractureNetworkTopology()
     m_pcs = PCSGet("FLUID_MOMENTUM");
     if (!m_msh)
         m_msh = m_pcs->m_msh;
+    m_msh->ConstructEdges();
     // Something must be done later on here.
     double tolerance = 1e-12;
 
@@ -936,6 +937,7 @@ void CFluidMomentum::SolveForEdgeVelocity(void)
     CFEMesh* m_msh =
         fem_msh_vector[0];  // Something must be done later on here.
     double tolerance = 1e-12;
+    m_msh->ConstructEdges();
 
     // Checking the edge is a joint starts here
     // Loop over all the edges
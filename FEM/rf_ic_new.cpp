@@ -40,6 +40,8 @@ using namespace std;
 #include "rfmat_cp.h"
 
 #include "InitialCondition.h"
+// FileIO
+#include "FEMIO/NodeValuesBinaryIO.h"
 
 //==========================================================================
 vector<CInitialConditionGroup*> ic_group_vector;
@@ -576,6 +578,19 @@ void CInitialCondition::SetByNodeIndex(int nidx)
     long node_index;
     double node_val;
 
+    // Binary companion file
+    std::vector<long> node_ids;
+    std::vector<double> values;
+    std::size_t n_columns;
+    if (FileIO::NodeValuesBinaryIO::readCompanion(
+            fname, this->getProcess()->m_msh->GetNodesNumber(true), 1,
+            node_ids, values, n_columns))
+    {
+        for (std::size_t i = 0; i < node_ids.size(); i++)
+            this->getProcess()->SetNodeValue(node_ids[i], nidx, values[i]);
+        return;
+    }
+
     // File handling
     ifstream d_file(fname.c_str(), ios::in);
     if (!d_file.is_open())
@@ -929,6 +944,24 @@ void CInitialCondition::SetDomain(int nidx)
             std::ifstream rfr_file;
             std::string restart_file_name = FilePath + rfr_file_name;
             //-------------------------------------------------------------------
+            // Binary companion file. As in the text file, each variable is
+            // written to nidx and the last one remains.
+            std::vector<long> node_ids;
+            std::vector<double> values;
+            std::size_t n_columns;
+            if (FileIO::NodeValuesBinaryIO::readCompanion(
+                    restart_file_name,
+                    this->getProcess()->m_msh->GetNodesNumber(true), 0,
+                    node_ids, values, n_columns))
+            {
+                double const* const last_column =
+                    &values[(n_columns - 1) * node_ids.size()];
+                for (i = 0; i < node_ids.size(); i++)
+                    this->getProcess()->SetNodeValue(node_ids[i], nidx,
+                                                     last_column[i]);
+                return;
+            }
+            //-------------------------------------------------------------------
             rfr_file.open(restart_file_name.c_str(), ios::in);
             if (!rfr_file.good())
             {
@@ -581,13 +581,13 @@ extern bool odeint(
     long, int);
 
 extern bool stifbs(double y[], double dydx[], int nv, double* xx, double htry,
-                   double eps, double yscal[], double* hdid, double* hnext,
+                   double eps, double atol[], double* hdid, double* hnext,
                    void (*derivs)(double, double[], double[], int, long,
                                   double),
                    long);
 
 extern bool rkqs(double y[], double dydx[], int n, double* x, double htry,
-                 double eps, double yscal[], double* hdid, double* hnext,
+                 double eps, double atol[], double* hdid, double* hnext,
                  void (*derivs)(double, double[], double[], int, long, double),
                  long);
 
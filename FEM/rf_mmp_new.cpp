@@ -44,6 +44,8 @@ extern double gravity_constant;
 // MSHLib
 //#include "msh_lib.h"
 #include "pcs_dm.h"  //WX
+// GEOLib
+#include "KdTree.h"
 
 #include "PhysicalConstant.h"
 
@@ -5711,13 +5713,14 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
     string mmp_property_mesh;
     MeshLib::CElem* m_ele_geo = NULL;
     bool element_area = false;
-    long i, j, ihet;
+    long i, j;
     double mmp_property_value;
     int mat_vector_size = 0;                 // Init WW
     double ddummy, conversion_factor = 1.0;  // init WW
     vector<double> xvals, yvals, zvals, mmpvals;
     vector<double> temp_store;
     int c_vals;
+    int n_neighbours = 8;
     double x, y, z, mmpv;
     std::stringstream in;
     // CB
@@ -5792,6 +5795,15 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
         if (line_string.find("$DIS_TYPE") != string::npos)
         {
             mmp_property_file >> mmp_property_dis_type;
+            // INVERSE_DISTANCE [number of neighbours]
+            if (mmp_property_dis_type[0] == 'I')
+            {
+                getline(mmp_property_file, line1);
+                in.str(line1);
+                if (!(in >> n_neighbours) || n_neighbours < 1)
+                    n_neighbours = 8;
+                in.clear();
+            }
             continue;
         }
         //....................................................................
@@ -5806,6 +5818,7 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
             switch (mmp_property_dis_type[0])
             {
                 case 'N':  // Next neighbour
+                case 'I':  // Inverse distance of the next neighbours
                 case 'G':  // Geometric mean
                     // Read in all values given, store in vectors for x, y, z
                     // and value
@@ -5839,17 +5852,6 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
                         for (j = 0; j < mat_vector_size; j++)
                             m_ele_geo->mat_vector(j) = garage[j];
                         garage.clear();
-                        if (mmp_property_dis_type[0] == 'N')
-                        {
-                            // Search for all elements of the mesh, which is the
-                            // nearest given value in the input file Return
-                            // value ihet is the index of the het. val in the
-                            // mmpval-vector
-                            ihet = GetNearestHetVal2(i, _mesh, xvals, yvals,
-                                                     zvals, mmpvals);
-                            m_ele_geo->mat_vector(mat_vector_size) =
-                                mmpvals[ihet];
-                        }
                         if (mmp_property_dis_type[0] == 'G')
                         {
                             mmpv = GetAverageHetVal2(i, _mesh, xvals, yvals,
@@ -5857,6 +5859,12 @@ void CMediumProperties::SetDistributedELEProperties(string file_name)
                             m_ele_geo->mat_vector(mat_vector_size) = mmpv;
                         }
                     }
+                    if (mmp_property_dis_type[0] == 'N' ||
+                        mmp_property_dis_type[0] == 'I')
+                        SetNearestHetVals(_mesh, xvals, yvals, zvals, mmpvals,
+                                          mmp_property_dis_type[0] == 'N'
+                                              ? 1
+                                              : n_neighbours);
                     break;
                 case 'E':  // Element data
                     for (i = 0; i < (long)_mesh->ele_vector.size(); i++)
@@ -6179,14 +6187,10 @@ void CMediumProperties::WriteTecplotDistributedProperties()
 **************************************************************************/
 long GetNearestHetVal2(long EleIndex,
                        CFEMesh* m_msh,
-                       vector<double>
-                           xvals,
-                       vector<double>
-                           yvals,
-                       vector<double>
-                           zvals,
-                       vector<double>
-                           mmpvals)
+                       vector<double> const& xvals,
+                       vector<double> const& yvals,
+                       vector<double> const& zvals,
+                       vector<double> const& mmpvals)
 {
     (void)mmpvals;
     long i, nextele, no_values;
@@ -6228,6 +6232,59 @@ long GetNearestHetVal2(long EleIndex,
     return nextele;
 }
 
+/**************************************************************************
+   MSHLib-Method: SetNearestHetVals
+   Task: Set the last entry of mat_vector of all elements to the value of the
+         nearest sample point to the element center (n_neighbours = 1), or
+         to the inverse distance weighted value of the n_neighbours nearest
+         sample points. The samples are searched in a k-d tree.
+**************************************************************************/
+void SetNearestHetVals(CFEMesh* m_msh,
+                       vector<double> const& xvals,
+                       vector<double> const& yvals,
+                       vector<double> const& zvals,
+                       vector<double> const& mmpvals,
+                       const int n_neighbours)
+{
+    if (mmpvals.empty())
+        return;
+    const GEOLIB::KdTree tree(xvals, yvals, zvals);
+
+    const long n_elements = static_cast<long>(m_msh->ele_vector.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < n_elements; i++)
+    {
+        MeshLib::CElem* m_ele = m_msh->ele_vector[i];
+        double const* center(m_ele->GetGravityCenter());
+        double value;
+        if (n_neighbours == 1)
+            value = mmpvals[tree.getNearestPoint(center)];
+        else
+        {
+            std::vector<std::size_t> ids;
+            std::vector<double> sqr_dists;
+            tree.getNearestPoints(center, n_neighbours, ids, sqr_dists);
+            // weights 1/d^2, a sample at the center gives its value
+            double sum_w = 0.0, sum_wv = 0.0;
+            for (std::size_t k = 0; k < ids.size(); k++)
+            {
+                if (sqr_dists[k] < DBL_MIN)
+                {
+                    sum_w = 1.0;
+                    sum_wv = mmpvals[ids[k]];
+                    break;
+                }
+                sum_w += 1.0 / sqr_dists[k];
+                sum_wv += mmpvals[ids[k]] / sqr_dists[k];
+            }
+            value = sum_wv / sum_w;
+        }
+        m_ele->mat_vector(m_ele->mat_vector.Size() - 1) = value;
+    }
+}
+
 /**************************************************************************
    MSHLib-Method: GetAverageHetVal2
    Task:
@@ -389,14 +389,16 @@ extern void MMP2PCSRelation(CRFProcess*);
 extern void GetHeterogeneousFields();  // SB
 extern long GetNearestHetVal2(long EleIndex,
                               CFEMesh* m_msh,
-                              std::vector<double>
-                                  xvals,
-                              std::vector<double>
-                                  yvals,
-                              std::vector<double>
-                                  zvals,
-                              std::vector<double>
-                                  mmpvals);
+                              std::vector<double> const& xvals,
+                              std::vector<double> const& yvals,
+                              std::vector<double> const& zvals,
+                              std::vector<double> const& mmpvals);
+extern void SetNearestHetVals(CFEMesh* m_msh,
+                              std::vector<double> const& xvals,
+                              std::vector<double> const& yvals,
+                              std::vector<double> const& zvals,
+                              std::vector<double> const& mmpvals,
+                              const int n_neighbours);
 double GetAverageHetVal2(long EleIndex,
                          CFEMesh* m_msh,
                          std::vector<double>
@@ -128,6 +128,8 @@ CNumerics::CNumerics(string name)
     ele_supg_method_length = 0;       // NW
     ele_supg_method_diffusivity = 0;  // NW
     fct_method = -1;                  // NW
+    ele_assembly_skip_tolerance = -1.0;
+    predictor_order = 0;
     fct_prelimiter_type = 0;          // NW
     fct_const_alpha = -1.0;           // NW
     newton_damping_factor = 1.0;
@@ -164,6 +166,7 @@ CNumerics::CNumerics(string name)
 #ifdef USE_PETSC
     lsover_name = "bcgs";
     pres_name = "bjacobi";
+    petsc_batch_assembly = false;
 #endif
 }
 
@@ -547,6 +550,18 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
             line.clear();
             continue;
         }
+#ifdef USE_PETSC
+        // subkeyword found
+        if (line_string.find("$PETSC_BATCH_ASSEMBLY") != string::npos)
+        {
+            line.str(GetLineFromFile1(num_file));
+            int flag = 0;
+            line >> flag;
+            petsc_batch_assembly = (flag != 0);
+            line.clear();
+            continue;
+        }
+#endif
         //....................................................................
         // JT subkeyword found
         if (line_string.find("$COUPLING_ITERATIONS") != string::npos)
@@ -757,6 +772,22 @@ ios::pos_type CNumerics::Read(ifstream* num_file)
                  << "\n";
             continue;
         }
+        // subkeyword found
+        if (line_string.find("$ELE_ASSEMBLY_SKIPPING") != string::npos)
+        {
+            line.str(GetLineFromFile1(num_file));
+            line >> ele_assembly_skip_tolerance;
+            line.clear();
+            continue;
+        }
+        // Predictor for the first nonlinear iterate of a time step
+        if (line_string.find("$PREDICTOR") != string::npos)
+        {
+            line.str(GetLineFromFile1(num_file));
+            line >> predictor_order;  // 1: linear, 2: quadratic
+            line.clear();
+            continue;
+        }
         // Automatic damping of Newton scheme
         if (line_string.find("$NEWTON_DAMPING") != string::npos)
         {
@@ -1348,6 +1379,13 @@ void SetLinearSolverType(LINEAR_SOLVER* ls, CNumerics* m_num)
         case 12:
             ls->LinearSolver = SpUMF;
             break;
+        // Pipelined CG and BiCGStab are only available in Linear_EQS.
+        case 14:
+            ls->LinearSolver = SpCG;
+            break;
+        case 15:
+            ls->LinearSolver = SpBICGSTAB;
+            break;
         default:
             cout << "***ERROR in SetLinearSolverType(): Specified linear "
                     "solver type ("
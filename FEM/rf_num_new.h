@@ -105,6 +105,10 @@ public:
     int fct_method;                    // NW
     unsigned int fct_prelimiter_type;  // NW
     double fct_const_alpha;            // NW
+    // Reuse of element contributions, negative: off
+    double ele_assembly_skip_tolerance;
+    // Extrapolated first iterate of a time step: 0 off, 1 linear, 2 quadratic
+    int predictor_order;
     // Deformation
     int GravityProfile;
     // LAGRANGE method //OK
@@ -140,6 +144,9 @@ public:
 #ifdef USE_PETSC
     const char* getLinearSolverName() const { return lsover_name.c_str(); }
     const char* getPreconditionerName() const { return pres_name.c_str(); }
+    /// Collect the element matrices in a rank local buffer before they are
+    /// added to the PETSc matrix.
+    bool usePETScBatchAssembly() const { return petsc_batch_assembly; }
 #endif
 
 private:
@@ -153,6 +160,7 @@ private:
 #ifdef USE_PETSC
     std::string lsover_name;  // WW
     std::string pres_name;
+    bool petsc_batch_assembly;
 #endif
 };
 
@@ -67,6 +67,13 @@ matrix solver
 //#include "rf_bc_new.h" // ST
 //#include "rf_mmp_new.h" // MAT
 #include "fem_ele_std.h"  // ELE
+#include "ElementAssemblyCache.h"
+#if defined(NEW_EQS) && defined(JFNK_H2M)
+#include "ElementResidualJFNK.h"
+#endif
+#include "FCTFluxCRS.h"
+#include "ReactionRateIntegrator.h"
+#include "SolutionPredictor.h"
 #include "rf_ic_new.h"    // IC
 //#include "msh_lib.h" // ELE
 //#include "rf_tim_new.h"
@@ -120,9 +127,9 @@ REACT_BRNS* m_vec_BRNS;
 #include "rf_react_int.h"
 #include "VLE.h"
 #include "Density.h"
+#include "ClimateStationInterpolation.h"
 
 // MathLib
-#include "InterpolationAlgorithms/InverseDistanceInterpolation.h"
 #include "InterpolationAlgorithms/PiecewiseLinearInterpolation.h"
 
 #include "FileTools.h"
@@ -260,6 +267,10 @@ CRFProcess::CRFProcess(void)
       norm_u_JFNK(NULL),
       array_u_JFNK(NULL),
       array_Fu_JFNK(NULL),
+#ifdef NEW_EQS
+      ele_residual_std_JFNK(NULL),
+      ele_residual_DM_JFNK(NULL),
+#endif
 #endif
       number_of_steady_st_nodes(0),
       ele_val_name_vector(std::vector<std::string>())
@@ -398,6 +409,8 @@ CRFProcess::CRFProcess(void)
     this->Gl_Vec = NULL;     // NW
     this->Gl_Vec1 = NULL;    // NW
     this->FCT_AFlux = NULL;  // NW
+    ele_assembly_cache = NULL;
+    solution_predictor = NULL;
 #ifdef USE_PETSC
     this->FCT_K = NULL;
     this->FCT_d = NULL;
@@ -406,6 +419,7 @@ CRFProcess::CRFProcess(void)
     PCS_ExcavState = -1;       // WX
     Neglect_H_ini = -1;        // WX
     m_conversion_rate = NULL;  // WW
+    m_reaction_integrator = NULL;
     isRSM = false;             // WW
     eqs_x = NULL;
     _hasConstrainedBC = false;
@@ -465,6 +479,10 @@ CRFProcess::~CRFProcess(void)
         }
         Ele_Matrices.clear();
     }
+    delete ele_assembly_cache;
+    ele_assembly_cache = NULL;
+    delete solution_predictor;
+    solution_predictor = NULL;
     //----------------------------------------------------------------------
     // ELE: Element Gauss point values
     if (ele_gp_value.size() > 0)
@@ -539,6 +557,10 @@ CRFProcess::~CRFProcess(void)
     DeleteArray(array_u_JFNK);   // 13.08.2010. WW
     DeleteArray(array_Fu_JFNK);  // 31.08.2010. WW
     DeleteArray(norm_u_JFNK);    // 24.11.2010. WW
+#ifdef NEW_EQS
+    delete ele_residual_std_JFNK;
+    delete ele_residual_DM_JFNK;
+#endif
 #endif
     //----------------------------------------------------------------------
     if (this->m_num && this->m_num->fct_method > 0)  // NW
@@ -560,6 +582,7 @@ CRFProcess::~CRFProcess(void)
     }
 
     // HS, 11.2011
+    delete m_reaction_integrator;
     if (m_conversion_rate)
         delete m_conversion_rate;
 
@@ -712,7 +735,7 @@ void CRFProcess::Create()
 #else
         long gl_size = m_msh->GetNodesNumber(false);
 #endif
-        this->FCT_AFlux = new SparseMatrixDOK(gl_size, gl_size);
+        this->FCT_AFlux = new FiniteElement::FCTFluxCRS(*m_msh);
         this->Gl_ML = new Math_Group::Vec(gl_size);
         this->Gl_Vec = new Math_Group::Vec(gl_size);
         this->Gl_Vec1 = new Math_Group::Vec(gl_size);
@@ -976,6 +999,9 @@ void CRFProcess::Create()
             fem = new CFiniteElementStd(this,
                                         Axisymm * m_msh->GetCoordinateFlag());
             fem->SetGaussPointNumber(m_num->ele_gauss_points);
+            // The SUPG element length is measured along the element edges
+            if (m_num->ele_supg_method > 0)
+                m_msh->ConstructEdges();
         }
     }
 
@@ -3957,7 +3983,11 @@ void CRFProcess::ConfigRandomWalk()
 
     // NOD values
     pcs_number_of_primary_nvals = 0;
-    pcs_number_of_secondary_nvals = 0;
+    // particle concentration smoothed onto the nodes
+    pcs_number_of_secondary_nvals = 1;
+    pcs_secondary_function_name[0] = "PARTICLE_CONCENTRATION";
+    pcs_secondary_function_unit[0] = "-";
+    pcs_secondary_function_timelevel[0] = 1;
 
     // 2 ELE values
     pcs_number_of_evals = 1;
@@ -4437,6 +4467,8 @@ void CRFProcess::ConfigTNEQ()
                             1.0 - poro,  // solid volume fraction
                             1.0,         // delta_t
                             react_syst);
+    m_reaction_integrator =
+        new FiniteElement::ReactionRateIntegrator(*m_conversion_rate);
 }
 
 /**************************************************************************
@@ -4537,6 +4569,8 @@ void CRFProcess::ConfigTES()
                             1.0 - poro,  // solid volume fraction
                             1.0,         // delta_t
                             react_syst);
+    m_reaction_integrator =
+        new FiniteElement::ReactionRateIntegrator(*m_conversion_rate);
 }
 
 /**************************************************************************
@@ -5238,10 +5272,8 @@ void CRFProcess::AddFCT_CorrectionVector()
     int idx1 = idx0 + 1;
     const double theta = this->m_num->ls_theta;
     const size_t node_size = m_msh->GetNodesNumber(false);
-    SparseMatrixDOK::mat_t& fct_f = this->FCT_AFlux->GetRawData();
-    SparseMatrixDOK::col_t* col;
-    SparseMatrixDOK::mat_t::const_iterator ii;
-    SparseMatrixDOK::col_t::const_iterator jj;
+    // antidiffusive fluxes f_ij, stored along the matrix pattern
+    FiniteElement::FCTFluxCRS& fct_f = *this->FCT_AFlux;
     Math_Group::Vec* ML = this->Gl_ML;
 #if defined(NEW_EQS)
     CSparseMatrix* A = NULL;  // WW
@@ -5284,20 +5316,18 @@ void CRFProcess::AddFCT_CorrectionVector()
     // f_ij*=1/dt*(DeltaU_ij^H-DeltaU_ij^n)  for i!=j
     for (size_t i = 0; i < node_size; i++)
     {
-        col = &fct_f[i];
-        for (jj = col->begin(); jj != col->end(); jj++)
+        for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
         {
-            const size_t j = (*jj).first;
-            if (i > j)
+            const size_t j = fct_f.getColumn(k);
+            if (i > j || !fct_f.isActive(k))
                 continue;  // symmetric part, off-diagonal
             double diff_uH =
                 this->GetNodeValue(i, idx1) - this->GetNodeValue(j, idx1);
             double diff_u0 =
                 this->GetNodeValue(i, idx0) - this->GetNodeValue(j, idx0);
             double v = 1.0 / dt * (diff_uH - diff_u0);
-            (*FCT_AFlux)(i, j) *=
-                v;  // MC is already done in local ele assembly
-            (*FCT_AFlux)(j, i) *=
+            fct_f[k] *= v;  // MC is already done in local ele assembly
+            fct_f[fct_f.getTransposed(k)] *=
                 -v;  // MC is already done in local ele assembly
         }
     }
@@ -5310,11 +5340,10 @@ void CRFProcess::AddFCT_CorrectionVector()
 #ifdef USE_PETSC
         const size_t i_global = FCT_GLOB_ADDRESS(i);
 #endif
-        col = &fct_f[i];
-        for (jj = col->begin(); jj != col->end(); jj++)
+        for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
         {
-            const size_t j = (*jj).first;
-            if (i > j || i == j)
+            const size_t j = fct_f.getColumn(k);
+            if (i > j || i == j || !fct_f.isActive(k))
                 continue;  // do below only for upper triangle due to symmetric
 
 // Get artificial diffusion operator D
@@ -5349,10 +5378,10 @@ void CRFProcess::AddFCT_CorrectionVector()
             double diff_u0 =
                 this->GetNodeValue(i, idx0) - this->GetNodeValue(j, idx0);
             double v = -(theta * d1 * diff_uH + (1.0 - theta) * d0 * diff_u0);
-            (*FCT_AFlux)(i, j) += v;
+            fct_f[k] += v;
 
             // prelimiting f
-            v = (*FCT_AFlux)(i, j);
+            v = fct_f[k];
             if (this->m_num->fct_prelimiter_type == 0)
             {
                 if (v * (-diff_uH) > 0.0)
@@ -5362,11 +5391,11 @@ void CRFProcess::AddFCT_CorrectionVector()
                 v = MinMod(v, -d1 * diff_uH);
             else if (this->m_num->fct_prelimiter_type == 2)
                 v = SuperBee(v, -d1 * diff_uH);
-            (*FCT_AFlux)(i, j) = v;
+            fct_f[k] = v;
 #ifdef USE_PETSC
-            (*FCT_AFlux)(j, i) = -v;
+            fct_f[fct_f.getTransposed(k)] = -v;
 #else
-            (*FCT_AFlux)(j, i) = v;
+            fct_f[fct_f.getTransposed(k)] = v;
 #endif
 
 #ifdef USE_PETSC
@@ -5426,21 +5455,24 @@ void CRFProcess::AddFCT_CorrectionVector()
         {
 #ifdef USE_PETSC
             const size_t i_global = FCT_GLOB_ADDRESS(i);
-#endif
             for (size_t j = 0; j < node_size; j++)
             {
-#ifdef USE_PETSC
                 const size_t j_global = FCT_GLOB_ADDRESS(j);
                 // b+=-(1-theta)*D*u^n
                 (*V)(i) += (*FCT_d)(i_global, j_global) * (*V1)(j);
+            }
 #else
+            // L has no entries outside of the pattern
+            for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
+            {
+                const size_t j = fct_f.getColumn(k);
 #ifdef NEW_EQS
                 (*V)(i) += (*A)(i, j) * (*V1)(j);
 #else
                 (*V)(i) += MXGet(i, j) * (*V1)(j);
-#endif
 #endif
             }
+#endif
         }
         for (size_t i = 0; i < node_size; i++)
         {
@@ -5469,8 +5501,8 @@ void CRFProcess::AddFCT_CorrectionVector()
         (*A) = 0.0;
 #else
         for (size_t i = 0; i < node_size; i++)
-            for (size_t j = 0; j < node_size; j++)
-                MXSet(i, j, 0.0);
+            for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
+                MXSet(i, fct_f.getColumn(k), 0.0);
 
 #endif
     }
@@ -5484,8 +5516,8 @@ void CRFProcess::AddFCT_CorrectionVector()
         (*A) *= theta;
 #else
         for (size_t i = 0; i < node_size; i++)
-            for (size_t j = 0; j < node_size; j++)
-                MXMul(i, j, theta);
+            for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
+                MXMul(i, fct_f.getColumn(k), theta);
 
 #endif
     }
@@ -5516,13 +5548,12 @@ void CRFProcess::AddFCT_CorrectionVector()
         double Q_plus, Q_min;
         P_plus = P_min = 0.0;
         Q_plus = Q_min = 0.0;
-        col = &fct_f[i];
-        for (jj = col->begin(); jj != col->end(); jj++)
+        for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
         {
-            const size_t j = (*jj).first;
-            if (i == j)
+            const size_t j = fct_f.getColumn(k);
+            if (i == j || !fct_f.isActive(k))
                 continue;
-            double f = (*jj).second;  // double f = (*FCT_AFlux)(i,j);
+            double f = fct_f[k];
 #ifndef USE_PETSC
             if (i > j)
                 f *= -1.0;
@@ -5565,15 +5596,14 @@ void CRFProcess::AddFCT_CorrectionVector()
     for (size_t i = 0; i < node_size; i++)
     {
         const size_t i_global = FCT_GLOB_ADDRESS(i);
-        col = &fct_f[i];
-        for (jj = col->begin(); jj != col->end(); jj++)
+        for (size_t k = fct_f.getRowBegin(i); k < fct_f.getRowEnd(i); k++)
         {
-            const size_t j = (*jj).first;
+            const size_t j = fct_f.getColumn(k);
             const size_t j_global = FCT_GLOB_ADDRESS(j);
-            if (i == j)
+            if (i == j || !fct_f.isActive(k))
                 continue;
 
-            double f = (*jj).second;  // double f = (*FCT_AFlux)(i,j);
+            double f = fct_f[k];
 #ifndef USE_PETSC
             if (i > j)
                 f *= -1;  // symmetric
@@ -5656,7 +5686,7 @@ void CRFProcess::GlobalAssembly()
         Check2D3D = true;
     if (this->femFCTmode)  // NW
     {
-        (*this->FCT_AFlux) = 0.0;
+        this->FCT_AFlux->setZero();
         (*this->Gl_ML) = 0.0;
         (*this->Gl_Vec) = 0.0;
         (*this->Gl_Vec1) = 0.0;
@@ -5728,6 +5758,9 @@ else
 #endif  //#if !defined(USE_PETSC) // && !defined(other parallel libs)//03.3012.
         // WW
 {       // STD
+#if !defined(USE_PETSC)
+    const bool use_cache = UpdateElementAssemblyCache();
+#endif
     // YDTEST. Changed to DOF 15.02.2007 WW
     for (size_t ii = 0; ii < continuum_vector.size(); ii++)
     {
@@ -5739,8 +5772,15 @@ else
             if (elem->GetMark() && elem->GetExcavState() == -1)
             {
                 elem->SetOrder(false);
-                fem->ConfigElement(elem, Check2D3D);
-                fem->Assembly();
+#if !defined(USE_PETSC)
+                if (use_cache)
+                    AssembleElementCached(elem, Check2D3D);
+                else
+#endif
+                {
+                    fem->ConfigElement(elem, Check2D3D);
+                    fem->Assembly();
+                }
                 // NEUMANN CONTROL---------
                 if (Tim->time_control_type == TimeControlType::NEUMANN)
                 {
@@ -5756,6 +5796,24 @@ else
         }
     }
 
+#if !defined(USE_PETSC)
+    if (use_cache)
+    {
+        const std::size_t n_assembled =
+            ele_assembly_cache->getNumberOfAssembled();
+        const std::size_t n_reused = ele_assembly_cache->getNumberOfReused();
+        char message[128];
+        sprintf(message,
+                "      Element assembly: %lu assembled, %lu reused (%.1f%% "
+                "saved)\n",
+                static_cast<unsigned long>(n_assembled),
+                static_cast<unsigned long>(n_reused),
+                100.0 * n_reused /
+                    std::max<std::size_t>(n_assembled + n_reused, 1));
+        ScreenMessage(message);
+    }
+#endif
+
     if (femFCTmode)  // NW
         AddFCT_CorrectionVector();
 
@@ -5855,6 +5913,139 @@ void CRFProcess::GlobalAssembly_std(const bool is_mixed_order, bool Check2D3D)
     }
 }
 
+#if !defined(USE_PETSC)
+/*! \brief Prepare the reuse of element contributions for a global assembly.
+
+    The cache is only used where the element contribution depends on nothing
+    but the node values and the time step size: single DOF liquid and
+    groundwater flow without deformation coupling, Gauss point and time
+    dependent media properties, domain decomposition, FCT, JFNK and the
+    Neumann time control. The node values compared are those of all
+    processes on the same mesh, so flow coupled to heat or mass transport
+    through the fluid properties is covered. Other processes, in particular
+    Richards and multiphase flow and the deformation processes, keep Gauss
+    point state that the cache cannot compare and are always assembled.
+    Returns true if the cache is used in this assembly.
+ */
+bool CRFProcess::UpdateElementAssemblyCache()
+{
+    bool use_cache =
+        m_num->ele_assembly_skip_tolerance >= 0.0 && dof == 1 &&
+        continuum_vector.size() == 1 && !femFCTmode && !Write_Matrix &&
+        m_num->nls_method != 2 &&
+        Tim->time_control_type != TimeControlType::NEUMANN &&
+        (getProcessType() == FiniteElement::LIQUID_FLOW ||
+         getProcessType() == FiniteElement::GROUNDWATER_FLOW);
+    for (std::size_t k = 0; use_cache && k < pcs_vector.size(); k++)
+    {
+        if (isDeformationProcess(pcs_vector[k]->getProcessType()))
+            use_cache = false;
+    }
+    // Media properties must not change with time or chemistry; the stress
+    // dependence is excluded with the deformation processes above.
+    for (std::size_t k = 0; use_cache && k < mmp_vector.size(); k++)
+    {
+        CMediumProperties const* const mmp = mmp_vector[k];
+        if (mmp->porosity_model > 1 || mmp->storage_model > 1 ||
+            mmp->permeability_model == 0 || mmp->permeability_model > 1 ||
+            mmp->unconfined_flow_group > 0)
+            use_cache = false;
+    }
+    if (!use_cache)
+    {
+        delete ele_assembly_cache;
+        ele_assembly_cache = NULL;
+        return false;
+    }
+    if (!ele_assembly_cache)
+        ele_assembly_cache = new FiniteElement::ElementAssemblyCache(
+            m_num->ele_assembly_skip_tolerance);
+
+    std::vector<double const*> node_values;
+    for (std::size_t k = 0; k < pcs_vector.size(); k++)
+    {
+        if (pcs_vector[k]->m_msh != m_msh)
+            continue;
+        std::vector<double*> const& values = pcs_vector[k]->nod_val_vector;
+        node_values.insert(node_values.end(), values.begin(), values.end());
+    }
+    ele_assembly_cache->setInputs(node_values, Tim->time_step_length);
+    ele_assembly_cache->resetCounters();
+    return true;
+}
+
+/*! \brief Assemble an element with the element contribution cache.
+
+    The matrix contribution of an assembled element is its local stiffness
+    matrix, which is all that liquid and groundwater flow add to the global
+    matrix. The RHS contribution is the change of the RHS entries of the
+    element nodes, which also holds the gravity and source terms.
+ */
+void CRFProcess::AssembleElementCached(CElem* elem, bool Check2D3D)
+{
+    const std::size_t n = elem->GetNodesNumber(false);
+    if (n > 20)
+    {
+        fem->ConfigElement(elem, Check2D3D);
+        fem->Assembly();
+        ele_assembly_cache->countAssembled();
+        return;
+    }
+    long nodes[20] = {};
+    long idx[20] = {};
+    for (std::size_t i = 0; i < n; i++)
+    {
+        nodes[i] = elem->GetNodeIndex(i);
+        idx[i] = m_msh->nod_vector[nodes[i]]->GetEquationIndex();
+    }
+#if defined(NEW_EQS)
+    CSparseMatrix* A = eqs_new->A;
+    double* b = eqs_new->b;
+#else
+    double* b = eqs->b;
+#endif
+    const std::size_t e = elem->GetIndex();
+
+    if (ele_assembly_cache->isValid(e, nodes, n))
+    {
+        double const* const a_e = ele_assembly_cache->getMatrix(e);
+        double const* const b_e = ele_assembly_cache->getRHS(e);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            for (std::size_t j = 0; j < n; j++)
+            {
+#if defined(NEW_EQS)
+                (*A)(idx[i], idx[j]) += a_e[i * n + j];
+#else
+                MXInc(idx[i], idx[j], a_e[i * n + j]);
+#endif
+            }
+            b[idx[i]] += b_e[i];
+        }
+        ele_assembly_cache->countReused();
+        return;
+    }
+
+    double a_e[400];
+    double b_e[20];
+    for (std::size_t i = 0; i < n; i++)
+        b_e[i] = b[idx[i]];
+
+    fem->ConfigElement(elem, Check2D3D);
+    fem->Assembly();
+
+    Math_Group::Matrix const& stiff = *fem->StiffMatrix;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        for (std::size_t j = 0; j < n; j++)
+            a_e[i * n + j] = stiff(i, j);
+        b_e[i] = b[idx[i]] - b_e[i];
+    }
+    ele_assembly_cache->store(e, nodes, n, n, a_e, b_e);
+    ele_assembly_cache->countAssembled();
+}
+#endif
+
 /*************************************************************************
    GeoSys-Function:
    Task: Integration
@@ -5956,32 +6147,46 @@ void CRFProcess::CalIntegrationPointValue()
     if (isLinearFlow)
     {
         const size_t mesh_ele_vector_size(m_msh->ele_vector.size());
-        for (size_t i = 0; i < mesh_ele_vector_size; i++)
+        // The element loop runs on one thread. The reactive Gauss points of
+        // TES/TNEQ are integrated in batches by the other threads meanwhile.
+#ifdef _OPENMP
+#pragma omp parallel if (m_reaction_integrator != NULL)
+#pragma omp single
+#endif
         {
-            elem = m_msh->ele_vector[i];
-            if (elem->GetMark())  // Marked for use
+            for (size_t i = 0; i < mesh_ele_vector_size; i++)
             {
-                if ((getProcessType() == FiniteElement::HEAT_TRANSPORT ||
-                     getProcessType() == FiniteElement::MASS_TRANSPORT) &&
-                    !elem->selected)
-                    continue;  // not selected for TOTAL_FLUX calculation JOD
-                               // 2014-11-10
-                fem->ConfigElement(elem);
-                fem->Config();  // OK4709
-                // fem->m_dom = NULL; // To be used for parallization
-                if (getProcessType() == FiniteElement::MULTI_COMPONENTIAL_FLOW)
-                    fem->Cal_VelocityMCF();
-                else
-                    fem->Cal_Velocity();
-
-                // moved here from additional lower loop
-                if (getProcessType() == FiniteElement::TNEQ ||
-                    getProcessType() == FiniteElement::TES)
+                elem = m_msh->ele_vector[i];
+                if (elem->GetMark())  // Marked for use
                 {
-                    fem->CalcSolidDensityRate();  // HS, thermal storage
-                                                  // reactions
+                    if ((getProcessType() == FiniteElement::HEAT_TRANSPORT ||
+                         getProcessType() == FiniteElement::MASS_TRANSPORT) &&
+                        !elem->selected)
+                        continue;  // not selected for TOTAL_FLUX calculation
+                                   // JOD 2014-11-10
+                    fem->ConfigElement(elem);
+                    fem->Config();  // OK4709
+                    // fem->m_dom = NULL; // To be used for parallization
+                    if (getProcessType() ==
+                        FiniteElement::MULTI_COMPONENTIAL_FLOW)
+                        fem->Cal_VelocityMCF();
+                    else
+                        fem->Cal_Velocity();
+
+                    // moved here from additional lower loop
+                    if (getProcessType() == FiniteElement::TNEQ ||
+                        getProcessType() == FiniteElement::TES)
+                    {
+                        fem->CalcSolidDensityRate();  // HS, thermal storage
+                                                      // reactions
+                        if (m_reaction_integrator)
+                            m_reaction_integrator->submit(
+                                Tim->time_step_length);
+                    }
                 }
             }
+            if (m_reaction_integrator)
+                m_reaction_integrator->integrate(Tim->time_step_length);
         }
     }
     else
@@ -8099,24 +8304,15 @@ void CRFProcess::IncorporateSourceTerms(const int rank)
             FiniteElement::CLIMATE)
         {
             m_st = st_vector[i];
-            const MathLib::InverseDistanceInterpolation<GEOLIB::PointWithID*,
-                                                        GEOLIB::Station*>*
-                distances(m_st->getClimateStationDistanceInterpolation());
-
-            // Interpolate each ST to every surface node;
-            const std::vector<GEOLIB::Station*>& weather_stations(
-                m_st->getClimateStations());
-            const size_t nStations = weather_stations.size();
-            vector<double> vec_etr(nStations);
-            for (size_t j = 0; j < nStations; j++)
-                vec_etr[j] = static_cast<GEOLIB::Station*>(weather_stations[j])
-                                 ->getSensorData()
-                                 ->getData(SensorDataType::RECHARGE,
-                                           aktuelle_zeit, true);
-
-            // Interpolate the point data onto the Mesh surface
+            FiniteElement::ClimateStationInterpolation* interpolation(
+                m_st->getClimateStationInterpolation());
+
+            // Interpolate the station data onto the Mesh surface
+            vector<double> recharge;
+            interpolation->interpolate(aktuelle_zeit, recharge);
+
             const size_t nSTNodeValues(st_node_value.size());
-            const size_t nDistances(distances->getNDomainPoints());
+            const size_t nPoints(interpolation->getNumberOfPoints());
             for (size_t j = 0; j < nSTNodeValues; j++)
             {
                 // search the first node value index not set (this should be the
@@ -8124,23 +8320,11 @@ void CRFProcess::IncorporateSourceTerms(const int rank)
                 if (st_node_value[j]->node_value ==
                     std::numeric_limits<double>::min())
                 {
-                    // Interpolate for each surface node
-                    for (size_t w = 0; w < nDistances; w++)
+                    for (size_t w = 0; w < nPoints; w++)
                     {
-                        // for each ST_node, the distance to all weather
-                        // stations has been determined before
-                        // (InverseDistranceInterpolation)
-                        // Value ETR(n) at node n by inverse distance weighting
-                        // of ETR(WS) for each weather station WS
-                        double st_value(0);
-                        for (size_t q = 0; q < nStations; q++)
-                            st_value += vec_etr[q] *
-                                        distances->getDistance(w, q) /
-                                        distances->getSumOfDistances(w);
-
-                        const size_t n(distances->getDomainPoint(w)->getID());
+                        const size_t n(interpolation->getPointID(w));
                         st_node_value[j + w]->node_value =
-                            st_value * m_msh->nod_vector[n]->patch_area;
+                            recharge[w] * m_msh->nod_vector[n]->patch_area;
                     }
                     break;
                 }
@@ -8343,6 +8527,8 @@ void CRFProcess::IncorporateSourceTerms(const int rank)
             if (cnodev->getProcessDistributionType() ==
                 FiniteElement::SYSTEM_DEPENDENT)
             {
+                // faces are constructed on demand
+                m_msh->ConstructFaces();
                 long no_st_ele = (long)m_st->element_st_vector.size();
                 for (long i_st = 0; i_st < no_st_ele; i_st++)
                 {
@@ -10398,15 +10584,16 @@ void CRFProcess::CopyCouplingNODValues()
 {
     // Carefull if cpl_variable = primary variable -> need extra column in
     // NodeValueTable !
+    const size_t n_nodes = m_msh->GetNodesNumber(false);
     int nidx0 = GetNodeValueIndex(m_num->cpl_variable_JOD);
-    for (size_t l = 0; l < m_msh->GetNodesNumber(false); l++)
-        SetNodeValue(l, nidx0, GetNodeValue(l, nidx0 + 1));
+    std::copy(nod_val_vector[nidx0 + 1], nod_val_vector[nidx0 + 1] + n_nodes,
+              nod_val_vector[nidx0]);
     //	if (_pcs_type_name.find("RICHARDS") != string::npos) { //WW
     if (this->getProcessType() == FiniteElement::RICHARDS_FLOW)  // WW
     {
         nidx0 = GetNodeValueIndex("SATURATION1");
-        for (size_t l = 0; l < m_msh->GetNodesNumber(false); l++)
-            SetNodeValue(l, nidx0, GetNodeValue(l, nidx0 + 1));
+        std::copy(nod_val_vector[nidx0 + 1],
+                  nod_val_vector[nidx0 + 1] + n_nodes, nod_val_vector[nidx0]);
     }
 }
 
@@ -10417,12 +10604,17 @@ void CRFProcess::CopyCouplingNODValues()
    11/2005 MB implementation
    02/2006 WW Modified for the cases of high order element and saturation
    08/2008 WW Make it twofold copy: forward and backward
+   11/2018 Copy whole columns of nod_val_vector. Both time levels stay in
+           use after the copy (new is the start of the next iteration), so
+           the columns cannot simply be swapped.
 **************************************************************************/
 void CRFProcess::CopyTimestepNODValues(bool forward)
 {
     bool Quadr = false;  // WW
     if (type == 4 || type == 41)
         Quadr = true;
+    const size_t n_nodes = m_msh->GetNodesNumber(Quadr);
+    const size_t n_nodes_linear = m_msh->GetNodesNumber(false);
 
     for (int j = 0; j < pcs_number_of_primary_nvals; j++)
     {
@@ -10433,8 +10625,8 @@ void CRFProcess::CopyTimestepNODValues(bool forward)
             nidx0++;
             nidx1--;
         }
-        for (size_t l = 0; l < m_msh->GetNodesNumber(Quadr); l++)
-            SetNodeValue(l, nidx0, GetNodeValue(l, nidx1));
+        std::copy(nod_val_vector[nidx1], nod_val_vector[nidx1] + n_nodes,
+                  nod_val_vector[nidx0]);
         // WW
         //		if (_pcs_type_name.find("RICHARDS") != string::npos || type ==
         // 1212) { //Multiphase. WW
@@ -10455,17 +10647,78 @@ void CRFProcess::CopyTimestepNODValues(bool forward)
                 nidx1--;
             }
             //
-            for (size_t l = 0; l < m_msh->GetNodesNumber(false); l++)
-                SetNodeValue(l, nidx0, GetNodeValue(l, nidx1));
+            std::copy(nod_val_vector[nidx1],
+                      nod_val_vector[nidx1] + n_nodes_linear,
+                      nod_val_vector[nidx0]);
         }
     }
 }
 
+/**************************************************************************
+   FEMLib-Method:
+   Task: Keep the accepted primary variables for the predictor
+   Programing:
+   11/2018 Implementation
+**************************************************************************/
+void CRFProcess::StorePrimaryVariablesForPredictor(double time)
+{
+    if (m_num->predictor_order < 1 || isDeformationProcess(getProcessType()))
+        return;
+    const size_t n_nodes = m_msh->GetNodesNumber(type == 4 || type == 41);
+    if (!solution_predictor)
+        solution_predictor = new FiniteElement::SolutionPredictor(
+            m_num->predictor_order, n_nodes);
+
+    std::vector<double*> variables(pcs_number_of_primary_nvals);
+    for (int j = 0; j < pcs_number_of_primary_nvals; j++)
+        variables[j] =
+            nod_val_vector[GetNodeValueIndex(pcs_primary_function_name[j]) + 1];
+    solution_predictor->store(time, variables);
+}
+
+/**************************************************************************
+   FEMLib-Method:
+   Task: First iterate of a time step by extrapolation of the accepted
+         primary variables. Predicted saturations outside [0,1] and negative
+         concentrations are replaced by the last solution of the node.
+   Programing:
+   11/2018 Implementation
+**************************************************************************/
+void CRFProcess::PredictPrimaryVariables(double time)
+{
+    if (!solution_predictor)
+        return;
+
+    std::vector<double*> variables(pcs_number_of_primary_nvals);
+    std::vector<double> lower(pcs_number_of_primary_nvals, -DBL_MAX);
+    std::vector<double> upper(pcs_number_of_primary_nvals, DBL_MAX);
+    for (int j = 0; j < pcs_number_of_primary_nvals; j++)
+    {
+        const std::string& name = pcs_primary_function_name[j];
+        variables[j] = nod_val_vector[GetNodeValueIndex(name) + 1];
+        if (name.find("SATURATION") != std::string::npos)
+        {
+            lower[j] = 0.0;
+            upper[j] = 1.0;
+        }
+        else if (getProcessType() == FiniteElement::MASS_TRANSPORT ||
+                 name.find("CONCENTRATION") != std::string::npos)
+            lower[j] = 0.0;
+    }
+    if (solution_predictor->predict(time, variables, lower, upper) &&
+        solution_predictor->getNumberOfBoundedValues() > 0)
+        std::cout << "-> Predictor: "
+                  << solution_predictor->getNumberOfBoundedValues()
+                  << " values out of bounds kept at the last solution"
+                  << "\n";
+}
+
 /**************************************************************************
    FEMLib-Method:
    Task:
    Programing:
    3/2012 JT. Based on the nodal version
+   11/2018 All time level pairs in one sweep over the elements
 **************************************************************************/
 void CRFProcess::CopyTimestepELEValues(bool forward)
 {
@@ -10483,6 +10736,9 @@ void CRFProcess::CopyTimestepELEValues(bool forward)
     copy_porosity = false;
 #endif
     //
+    // The values of an element are stored together, so all pairs of time
+    // levels are copied in a single pass over the elements
+    std::vector<size_t> copy_to, copy_from;
     for (j = 0; j < nvals - 1; j++)
     {
         if (ele_val_name_vector[j].compare(ele_val_name_vector[j + 1]) !=
@@ -10499,10 +10755,17 @@ void CRFProcess::CopyTimestepELEValues(bool forward)
             nidx0++;
             nidx1--;
         }
-        for (iel = 0; iel < num_ele; iel++)
-        {
-            SetElementValue(iel, nidx0, GetElementValue(iel, nidx1));
-        }
+        copy_to.push_back(nidx0);
+        copy_from.push_back(nidx1);
+    }
+    const size_t n_copies = copy_to.size();
+    if (n_copies == 0)
+        return;
+    for (iel = 0; iel < num_ele; iel++)
+    {
+        double* const values = ele_val_vector[iel];
+        for (j = 0; j < n_copies; j++)
+            values[copy_to[j]] = values[copy_from[j]];
     }
 }
 
@@ -11685,6 +11948,7 @@ void CRFProcess::CalcELEFluxes(const GEOLIB::Polyline* const ply,
 
     result[0] = result[1] = 0;
     FiniteElement::ProcessType pcs_type(getProcessType());
+    m_msh->ConstructEdges();
 
     CRFProcess* m_pcs_flow = NULL;
     //	if (_pcs_type_name.find("FLOW") != string::npos) {
@@ -11988,6 +12252,7 @@ void CRFProcess::CalcELEMassFluxes(const GEOLIB::Polyline* const ply,
     //	double totalmassflux; // 2012-08 TF / unused
     double* ConcentrationGradient(new double[3]);
     int numberPolyline = 0;
+    m_msh->ConstructEdges();
 
     if (this->Tim->step_current == 0)
     {
@@ -12634,6 +12899,7 @@ void CRFProcess::AssembleParabolicEquationRHSVector(CNode* m_nod)
     int j;
     double aux_vector[3];
     double check_sign;
+    m_msh->ConstructEdges();
     //----------------------------------------------------------------------
     // Element velocity
     int v_eidx[3];
@@ -14104,6 +14370,7 @@ void CRFProcess::UpdateTransientBC()
             of_primary << "cellsize" << setw(16) << g_para[4] << "\n";
             of_primary << "NODATA_value" << setw(11) << g_para[5] << "\n";
 
+            m_msh->ConstructFaces();
             for (std::size_t i = 0; i < m_msh->face_vector.size(); i++)
             {
                 CElem* elem = m_msh->face_vector[i];
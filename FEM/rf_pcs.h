@@ -54,6 +54,11 @@ class CFiniteElementStd;
 class CFiniteElementVec;
 class ElementMatrix;
 class ElementValue;
+class ElementAssemblyCache;
+class ElementResidualJFNK;
+class FCTFluxCRS;
+class ReactionRateIntegrator;
+class SolutionPredictor;
 }  // namespace FiniteElement
 
 namespace MeshLib
@@ -256,11 +261,15 @@ protected:  // WW
     long orig_size;  // Size of source term nodes
     // ELE
     std::vector<FiniteElement::ElementMatrix*> Ele_Matrices;
+    /// Reused element contributions, see $ELE_ASSEMBLY_SKIPPING
+    FiniteElement::ElementAssemblyCache* ele_assembly_cache;
+    /// Accepted solutions for the first iterate of a step, see $PREDICTOR
+    FiniteElement::SolutionPredictor* solution_predictor;
     // Global matrix
     Math_Group::Vec* Gl_Vec;                 // NW
     Math_Group::Vec* Gl_Vec1;                // NW
     Math_Group::Vec* Gl_ML;                  // NW
-    Math_Group::SparseMatrixDOK* FCT_AFlux;  // NW
+    FiniteElement::FCTFluxCRS* FCT_AFlux;    // NW
 #ifdef USE_PETSC
     Math_Group::SparseMatrixDOK* FCT_K;
     Math_Group::SparseMatrixDOK* FCT_d;
@@ -344,6 +353,13 @@ public:
     double* array_u_JFNK;
     double* array_Fu_JFNK;
     std::vector<bc_JFNK> BC_JFNK;
+#ifdef NEW_EQS
+    /// Element residuals of F(u) of the PDEs excluding deformation and of
+    /// the deformation, and the source terms of F(u).
+    FiniteElement::ElementResidualJFNK* ele_residual_std_JFNK;
+    FiniteElement::ElementResidualJFNK* ele_residual_DM_JFNK;
+    std::vector<double> st_rhs_JFNK;
+#endif
 #endif
 public:
     // BG, DL Calculate phase transition of CO2
@@ -661,6 +677,12 @@ public:
     // Add bool forward = true. WW
     void CopyTimestepNODValues(bool forward = true);
     void CopyTimestepELEValues(bool forward = true);
+    /// Stores the primary variables of the accepted step ending at time
+    /// for the predictor ($PREDICTOR).
+    void StorePrimaryVariablesForPredictor(double time);
+    /// Sets the primary variables of the new time level to the predicted
+    /// values at time ($PREDICTOR).
+    void PredictPrimaryVariables(double time);
     // Coupling
     // WW double CalcCouplingNODError(); //MB
     void CopyCouplingNODValues();
@@ -685,12 +707,32 @@ public:
     GlobalAssembly();  // Make as a virtual function. //10.09.201l. WW
     /// For all PDEs excluding that for deformation. 24.11.2010l. WW
     void GlobalAssembly_std(const bool is_mixed_order, bool Check2D3D = false);
+#if !defined(USE_PETSC)
+    /// Compare the nodal values with those of the cached element
+    /// contributions before a global assembly. Only single DOF liquid and
+    /// groundwater flow use the cache.
+    bool UpdateElementAssemblyCache();
+    /// Assemble an element, or add its cached contribution if the nodal
+    /// values of the element did not change.
+    void AssembleElementCached(MeshLib::CElem* elem, bool Check2D3D);
+#endif
     /// Assemble EQS for deformation process.
     virtual void GlobalAssembly_DM(){};
+    /// Assemble an element of the deformation process.
+    virtual void ElementAssembly_DM(MeshLib::CElem* /*elem*/){};
 #if defined(NEW_EQS) && defined(JFNK_H2M)
     /// Jacobian free method to calculate J*v.
     // 11.08.2010.
     void Jacobian_Multi_Vector_JFNK(double* v = NULL, double* Jv = NULL);
+    /// Store the element residuals and source terms of F(u).
+    void StoreElementResiduals_JFNK();
+    /// Assemble F(u+epsilon*v)-F(u) element by element for the elements
+    /// with perturbed nodes.
+    void AssembleResidualDifference_JFNK(const std::vector<char>& perturbed,
+                                         const bool deformation);
+    /// Equation indices of the primary variables at the element nodes.
+    void GetElementEquationIndices_JFNK(MeshLib::CElem* elem,
+                                        std::vector<long>& rows) const;
     /// Recovery du from the temporary vector.
     void Recovery_du_JFNK();  // 02.11.2010.
     /// Line search for Newton method.
@@ -900,6 +942,8 @@ public:
     // HS 10.2011
     double m_rho_s_0;
     conversion_rate* m_conversion_rate;
+    /// Reactive Gauss points of TES/TNEQ, integrated after the element loop
+    FiniteElement::ReactionRateIntegrator* m_reaction_integrator;
 
 #if defined(USE_PETSC)  // 03.3012. WW
     /// Initialize the RHS array of the system of equations with the previous
@@ -16,7 +16,9 @@
 
 #if defined(NEW_EQS) && defined(JFNK_H2M)
 
+#include "ElementResidualJFNK.h"
 #include "equation_class.h"
+#include "fem_ele_std.h"
 #include "pcs_dm.h"
 #include "rf_pcs.h"
 #include <algorithm>
@@ -178,6 +180,10 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
             norm_u_JFNK[1] = sqrt(norm_u_JFNK[1]);
         }
         norm_u_JFNK[0] = sqrt(norm_u_JFNK[0]);
+
+        /// Element residuals of F(u) for J*v.
+        if (HM)
+            StoreElementResiduals_JFNK();
         return;
     }
 
@@ -306,6 +312,25 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
         // TEST
         perturbation[0] = sqrt(DBL_EPSILON);
 
+        /// Nodes with a non-zero component of v. Only the elements with
+        /// such nodes or with Dirichlet nodes contribute to J*v.
+        std::vector<char> perturbed;
+        if (HM)
+        {
+            perturbed.assign(m_msh->GetNodesNumber(true), 0);
+            j = 0;
+            for (k = 0; k < pcs_number_of_primary_nvals; k++)
+            {
+                for (i = 0; i < num_nodes_p_var[k]; i++)
+                {
+                    if (v[j] != 0.0)
+                        perturbed[i] = 1;
+                    j++;
+                }
+            }
+        }
+        std::vector<char> perturbed_bc;
+
         /// 1. For PDEs excluding that of deformation. 24.22.2010
         j = 0;
         for (k = 0; k < pcs_number_of_primary_nvals; k++)
@@ -332,7 +357,18 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
             SetNodeValue(bc_entry.bc_node, bc_entry.var_idx,
                          bc_entry.bc_value0);
         }
-        GlobalAssembly_std(true);
+        if (HM)
+        {
+            perturbed_bc = perturbed;
+            for (i = 0; i < (long)BC_JFNK.size(); i++)
+            {
+                if (BC_JFNK[i].incremental)
+                    perturbed_bc[BC_JFNK[i].bc_node] = 1;
+            }
+            AssembleResidualDifference_JFNK(perturbed_bc, false);
+        }
+        else
+            GlobalAssembly_std(true);
 
         /// 2. For the PDE of deformation
         if (HM)
@@ -362,10 +398,22 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
                 SetNodeValue(bc_entry.bc_node, bc_entry.var_idx,
                              bc_entry.bc_value);
             }
-            GlobalAssembly_DM();
+            perturbed_bc = perturbed;
+            for (i = 0; i < (long)BC_JFNK.size(); i++)
+            {
+                if (!BC_JFNK[i].incremental)
+                    perturbed_bc[BC_JFNK[i].bc_node] = 1;
+            }
+            AssembleResidualDifference_JFNK(perturbed_bc, true);
         }
 
         IncorporateSourceTerms();
+        /// F(u+epsilon*v)-F(u) for the element by element assembly
+        if (HM)
+        {
+            for (i = 0; i < eqs_new->size_global; i++)
+                eqs_new->b[i] -= st_rhs_JFNK[i];
+        }
 
         /*
            /// 24.11.2010. WW
@@ -388,7 +436,10 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
             for (i = 0; i < num_nodes_p_var[k]; i++)
             {
                 /// Jv
-                Jv[j] = (-eqs_new->b[j] - array_Fu_JFNK[j]) / pert;
+                if (HM)
+                    Jv[j] = -eqs_new->b[j] / pert;
+                else
+                    Jv[j] = (-eqs_new->b[j] - array_Fu_JFNK[j]) / pert;
                 j++;
             }
         }
@@ -414,6 +465,141 @@ void CRFProcess::Jacobian_Multi_Vector_JFNK(double* v, double* Jv)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+///
+///
+///  Equation indices of all primary variables at the nodes of an element
+///
+///////////////////////////////////////////////////////////////////////////////////
+void CRFProcess::GetElementEquationIndices_JFNK(MeshLib::CElem* elem,
+                                                std::vector<long>& rows) const
+{
+    const int nn = static_cast<int>(elem->GetNodesNumber(m_msh->getOrder()));
+    long shift = 0;
+    rows.clear();
+    for (int k = 0; k < pcs_number_of_primary_nvals; k++)
+    {
+        for (int n = 0; n < nn; n++)
+        {
+            const long eq_idx = elem->GetNode(n)->GetEquationIndex();
+            if (eq_idx < num_nodes_p_var[k])
+                rows.push_back(shift + eq_idx);
+        }
+        shift += num_nodes_p_var[k];
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+///
+///
+///  Store the element contributions to F(u) and the source terms of F(u)
+///
+///  The elements are assembled as in GlobalAssembly_std() and
+///  GlobalAssembly_DM(). The RHS entries of the element nodes are moved to
+///  the storage after each element. The RHS of the system is kept.
+///////////////////////////////////////////////////////////////////////////////////
+void CRFProcess::StoreElementResiduals_JFNK()
+{
+    const long size = eqs_new->size_global;
+    double* b = eqs_new->b;
+    std::vector<double> b_u(b, b + size);
+
+    /// The Jacobi preconditioner is assembled with F(u) only
+    const bool precond = JFNK_precond;
+    JFNK_precond = false;
+
+    if (!ele_residual_std_JFNK)
+        ele_residual_std_JFNK = new FiniteElement::ElementResidualJFNK();
+    if (!ele_residual_DM_JFNK)
+        ele_residual_DM_JFNK = new FiniteElement::ElementResidualJFNK();
+    const std::size_t n_elements = m_msh->ele_vector.size();
+    ele_residual_std_JFNK->reset(n_elements);
+    ele_residual_DM_JFNK->reset(n_elements);
+
+    for (long i = 0; i < size; i++)
+        b[i] = 0.;
+
+    std::vector<long> rows;
+    std::vector<double> b_e;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const bool deformation = (pass == 1);
+        FiniteElement::ElementResidualJFNK* residuals =
+            deformation ? ele_residual_DM_JFNK : ele_residual_std_JFNK;
+        for (std::size_t e = 0; e < n_elements; e++)
+        {
+            MeshLib::CElem* elem = m_msh->ele_vector[e];
+            if (!elem->GetMark())
+                continue;
+
+            if (deformation)
+                ElementAssembly_DM(elem);
+            else
+            {
+                elem->SetOrder(m_msh->getOrder());
+                fem->setMixedOrderFlag(true);
+                fem->ConfigElement(elem);
+                fem->Assembly();
+            }
+
+            GetElementEquationIndices_JFNK(elem, rows);
+            b_e.resize(rows.size());
+            for (std::size_t k = 0; k < rows.size(); k++)
+            {
+                b_e[k] = b[rows[k]];
+                b[rows[k]] = 0.;
+            }
+            if (!rows.empty())
+                residuals->store(e, &rows[0], &b_e[0], rows.size());
+        }
+    }
+
+    IncorporateSourceTerms();
+    st_rhs_JFNK.assign(b, b + size);
+
+    std::copy(b_u.begin(), b_u.end(), b);
+    JFNK_precond = precond;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+///
+///
+///  Add F_e(u+epsilon*v)-F_e(u) of the elements with perturbed nodes to the
+///  RHS. The other elements have the same residual as for F(u).
+///
+///////////////////////////////////////////////////////////////////////////////////
+void CRFProcess::AssembleResidualDifference_JFNK(
+    const std::vector<char>& perturbed, const bool deformation)
+{
+    FiniteElement::ElementResidualJFNK const& residuals =
+        deformation ? *ele_residual_DM_JFNK : *ele_residual_std_JFNK;
+    const bool quadratic = m_msh->getOrder();
+    for (std::size_t e = 0; e < m_msh->ele_vector.size(); e++)
+    {
+        MeshLib::CElem* elem = m_msh->ele_vector[e];
+        if (!elem->GetMark())
+            continue;
+
+        bool is_perturbed = false;
+        const std::size_t nn = elem->GetNodesNumber(quadratic);
+        for (std::size_t n = 0; n < nn && !is_perturbed; n++)
+            is_perturbed = perturbed[elem->GetNodeIndex(n)] != 0;
+        if (!is_perturbed)
+            continue;
+
+        if (deformation)
+            ElementAssembly_DM(elem);
+        else
+        {
+            elem->SetOrder(quadratic);
+            fem->setMixedOrderFlag(true);
+            fem->ConfigElement(elem);
+            fem->Assembly();
+        }
+        residuals.subtract(e, eqs_new->b);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////
 ///
 ///
@@ -707,6 +893,7 @@ void CRFProcess::setSolver(petsc_group::PETScLinearSolver* petsc_solver)
                     m_num->getLinearSolverName(),
                     m_num->getPreconditionerName(),
                     convertProcessTypeToString(this->getProcessType()) + "_");
+    eqs_new->setBatchAssembly(m_num->usePETScBatchAssembly());
 }
 //------------------------------------------------------------
 /*!
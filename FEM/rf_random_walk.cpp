@@ -18,6 +18,8 @@
 
 #include "FileTools.h"
 #include "Output.h"
+#include "ParticleConcentration.h"
+#include "StepSnapshot.h"
 #include "matrix_class.h"
 #include "rf_fluid_momentum.h"
 #include "rf_tim_new.h"
@@ -70,6 +72,7 @@ RandomWalk::RandomWalk(int srand_seed)
     FDMIndexSwitch = 0;
     GridOption = 0;
     ChanceOfIrreversed = NULL;  // YS: judgement for decay
+    concentration = NULL;
 
     // To produce a different pseudo-random series each time your program is
     // run.
@@ -135,6 +138,7 @@ RandomWalk::~RandomWalk(void)
     if (ChanceOfIrreversed)
         delete[] ChanceOfIrreversed;
     ChanceOfIrreversed = NULL;
+    delete concentration;
 }
 
 /**************************************************************************
@@ -3045,51 +3049,34 @@ void RandomWalk::RandomWalkOutput(double dbl_time, int current_time_step)
 
     //  OUTPUT PARTICLES AS ELEMENTAL CONCENTRATION
     //  ---------------------------------------------------
-    /*
-       m_out = OUTGetRWPT("PARTICLE_CONCENTRATION");
-       outputornot=false;
-       m_out->time = CurrentTime;
-       no_times = (int)m_out->time_vector.size();
-       if(current_time_step%m_out->nSteps==0)
-       outputornot = true;
-       if(current_time_step<2)
-       outputornot = true;
-
-       if(outputornot)
-       DATWriteParticleFile(current_time_step);
-       else
-       {
-       for(j=0;j<no_times;j++)
-       {
-       if(CurrentTime>=m_out->time_vector[j])
-       DATWriteParticleFile(current_time_step);
-       }
-       }
-
-       double UnitConcentration = 0.0;
-
-       // Here's definition for unit concentration
-       UnitConcentration = (double)numOfParticles / (double)
-       m_msh->ele_vector.size();
-
-       for(int i=0; i< (int)m_msh->ele_vector.size(); ++i)
-       {
-       // Now count the number of particles in each element.
-       int CountInThisElement = 0;
-       for(int j=0; j< numOfParticles; ++j)
-       {
-       if(X[j].Now.elementIndex == i)
-       ++CountInThisElement;
-       }
-
-       // Store the normalized concentration
-       double NormConcentrationOfTheElement = (double)CountInThisElement /
-       UnitConcentration;
-       //		double NormConcentrationOfTheElement =
-       (double)CountInThisElement/numOfParticles; SetElementValue(i,
-       GetElementValueIndex("CONCENTRATION0")+1, NormConcentrationOfTheElement);
-       }
-     */
+    // One pass over the particles; the element values are written by the
+    // regular output ($ELE_VALUES CONCENTRATION0). The nodal values
+    // ($NOD_VALUES PARTICLE_CONCENTRATION) are computed only if
+    // PARTICLE_CONCENTRATION is given in $RWPT_VALUES.
+    CRFProcess* rw_pcs = PCSGet(FiniteElement::RANDOM_WALK);
+    if (rw_pcs)
+    {
+        if (!concentration)
+            concentration =
+                new FiniteElement::ParticleConcentration(*rw_pcs->m_msh);
+        concentration->countParticles(X);
+
+        const int idx_c = rw_pcs->GetElementValueIndex("CONCENTRATION0") + 1;
+        const long n_elements = (long)rw_pcs->m_msh->ele_vector.size();
+        for (long e = 0; e < n_elements; ++e)
+            rw_pcs->SetElementValue(e, idx_c,
+                                    concentration->getElementConcentration(e));
+
+        if (OUTGetRWPT("PARTICLE_CONCENTRATION"))
+        {
+            std::vector<double> node_values;
+            concentration->getNodalConcentration(node_values);
+            const int idx_n =
+                rw_pcs->GetNodeValueIndex("PARTICLE_CONCENTRATION");
+            for (size_t n = 0; n < node_values.size(); ++n)
+                rw_pcs->SetNodeValue(n, idx_n, node_values[n]);
+        }
+    }
 
     /*
        if( ((int)(X[0].Now.t*1000))== 5)
@@ -3101,6 +3088,16 @@ void RandomWalk::RandomWalkOutput(double dbl_time, int current_time_step)
      */
 }
 
+void RandomWalk::RegisterStepState(FiniteElement::StepSnapshot& snapshot)
+{
+    // The particles are plain data. Particles must not be added or removed
+    // between the checkpoint and the restore of a step, which the snapshot
+    // checks for registered vectors.
+    snapshot.add(X);
+    snapshot.add(&leavingParticles, 1);
+    snapshot.add(&CurrentTime, 1);
+}
+
 void RandomWalk::ConcPTFile(const char* file_name)
 {
     FILE* pct_file = NULL;
@@ -3145,22 +3142,22 @@ void RandomWalk::ConcPTFile(const char* file_name)
     fprintf(pct_file, "ZONE T=\"%fs\", I=%d, F=POINT, C=BLACK\n", X[0].Now.t,
             gridDensity);
 
-    for (int i = 0; i < gridDensity; ++i)
+    // Count the particles of all 1 m segments in one pass
+    std::vector<long> count(gridDensity > 0 ? gridDensity : 0, 0);
+    for (int j = 0; j < numOfParticles; ++j)
     {
-        int count = 0;
-        double seg_start = 0.0, seg_end = 0.0;
-        for (int j = 0; j < numOfParticles; ++j)
-        {
-            seg_start = MinX + i;
-            seg_end = MinX + i + 1.0;
+        const double offset = X[j].Now.x - MinX;
+        if (offset >= 0.0 && offset < gridDensity)
+            ++count[(int)offset];
+    }
 
-            if ((X[j].Now.x >= seg_start) && (X[j].Now.x < seg_end))
-                ++count;
-        }
+    for (int i = 0; i < gridDensity; ++i)
+    {
+        const double seg_start = MinX + i, seg_end = MinX + i + 1.0;
         //	fprintf(pct_file, "%f 0.0 0.0 %f\n", (seg_start+seg_end)/2.0, count
         /// numOfParticles);
         fprintf(pct_file, "%f 0.0 0.0 %f\n", (seg_start + seg_end) / 2.0,
-                (double)count);
+                (double)count[i]);
     }
 
     // Let's close it, now
@@ -6269,6 +6266,8 @@ void PCTRead(string file_base_name)
     RandomWalk* RW = NULL;
     m_msh->PT = new RandomWalk(srand_seed);  // PCH
     RW = m_msh->PT;
+    // Particles are traced through the element edges and surface faces
+    m_msh->ConstructFaces();
 
     // Create pathline
     RandomWalk::Pathline path;
@@ -21,6 +21,12 @@
 
 #define ALLOW_PARTICLES_GO_OUTSIDE
 
+namespace FiniteElement
+{
+class ParticleConcentration;
+class StepSnapshot;
+}
+
 class Particle
 {
 public:
@@ -181,6 +187,8 @@ public:
     int RandomWalkDrift(double* Z, int type);
     void SolveDispersionCoefficient(Particle* A);
     void RandomWalkOutput(double, int);  // JT 2010
+    /// Registers the particles for the rollback of a rejected time step.
+    void RegisterStepState(FiniteElement::StepSnapshot& snapshot);
 
     int SolveForNextPosition(Particle* A, Particle* B);
 
@@ -245,6 +253,9 @@ private:
     double yrw_range;
     double zrw_range;
 
+    /// Particle counts per element for the concentration output
+    FiniteElement::ParticleConcentration* concentration;
+
     double ComputeVolume(Particle* A, MeshLib::CElem* m_ele);
     double ComputeVolume(Particle* A, Particle* element, MeshLib::CElem* m_ele);
     void CopyParticleCoordToArray(Particle* A, double* x1buff, double* x2buff,
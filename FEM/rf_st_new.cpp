@@ -62,6 +62,8 @@ last modified
 #include "pcs_dm.h"
 
 // FEM
+#include "ClimateStationInterpolation.h"
+#include "MatrixDiffusionSourceTerm.h"
 //#include "problem.h"
 // For analytical source terms
 #include "rf_mfp_new.h"
@@ -72,11 +74,11 @@ last modified
 #include "quicksort.h"
 
 // MathLib
-#include "InterpolationAlgorithms/InverseDistanceInterpolation.h"
 #include "InterpolationAlgorithms/PiecewiseLinearInterpolation.h"
 
 // FileIO
 #include "FEMIO/GeoIO.h"
+#include "FEMIO/NodeValuesBinaryIO.h"
 #include "FEMIO/ProcessIO.h"
 #include "readNonBlankLineFromInputStream.h"
 #include "XmlIO/RapidXMLInterface.h"
@@ -97,7 +99,6 @@ std::vector<CSourceTerm*> st_vector;
 std::list<CSourceTermGroup*> st_group_list;
 std::vector<std::string> analytical_processes;
 std::vector<std::string> analytical_processes_polylines;
-std::vector<NODE_HISTORY*> node_history_vector;  // CMCD
 /**************************************************************************
  FEMLib-Method:
  Task: ST constructor
@@ -112,7 +113,9 @@ CSourceTerm::CSourceTerm()
       fct_method(0),
       dis_linear_f(NULL),
       GIS_shape_head(NULL),
-      _distances(NULL)
+      _climate_interpolation(NULL),
+      _climate_n_nearest(0),
+      _matrix_diffusion(NULL)
 // 07.06.2010, 03.2010. WW
 {
     CurveIndex = -1;
@@ -133,7 +136,9 @@ CSourceTerm::CSourceTerm(const SourceTerm* st)
     : ProcessInfo(st->getProcessType(), st->getProcessPrimaryVariable(), NULL),
       GeoInfo(st->getGeoType(), st->getGeoObj()),
       DistributionInfo(st->getProcessDistributionType()),
-      _distances(NULL)
+      _climate_interpolation(NULL),
+      _climate_n_nearest(0),
+      _matrix_diffusion(NULL)
 {
     setProcess(PCSGet(this->getProcessType()));
     this->geo_name = st->getGeoName();
@@ -176,12 +181,12 @@ CSourceTerm::CSourceTerm(const SourceTerm* st)
  **************************************************************************/
 CSourceTerm::~CSourceTerm()
 {
-    delete _distances;
+    delete _climate_interpolation;
+    delete _matrix_diffusion;
     for (size_t i = 0; i < this->_weather_stations.size();
          i++)  // KR / NB clear climate data information
         delete this->_weather_stations[i];
 
-    DeleteHistoryNodeMemory();
     //    dis_file_name.clear();
     node_number_vector.clear();
     node_value_vector.clear();
@@ -610,6 +615,8 @@ void CSourceTerm::ReadDistributionType(std::ifstream* st_file)
         in >> number_of_terms;  // no timesteps to consider in solution
         in >> resolution;       // every nth term will be considered
         in >> factor;           // to convert temperature to energy
+        analytical_tolerance = 0.0;  // optional, truncation of the series
+        in >> analytical_tolerance;
         analytical = true;
         analytical_processes.push_back(
             convertPrimaryVariableToString(getProcessPrimaryVariable()));
@@ -733,6 +740,10 @@ void CSourceTerm::ReadDistributionType(std::ifstream* st_file)
     {
         dis_type_name = "CLIMATE";
         in >> fname;  // base filename for climate input
+        // optional: number of nearest stations interpolated to each node
+        long n_nearest(0);
+        if (in >> n_nearest && n_nearest > 0)
+            _climate_n_nearest = static_cast<std::size_t>(n_nearest);
         in.clear();
 
         std::vector<GEOLIB::Point*>* stations(
@@ -827,10 +838,7 @@ bool STRead(const std::string& file_base_name,
             if (no_an_sol > 0)
             {
                 for (size_t i = 0; i < no_source_terms; i++)
-                {
-                    st_vector[i]->setNumberOfAnalyticalSolutions(no_an_sol);
                     st_vector[i]->setMaxNumberOfTerms(number_of_terms);
-                }
             }
 
             std::cout << "done, read " << st_vector.size() << " source terms"
@@ -1519,6 +1527,8 @@ void CSourceTerm::EdgeIntegration(CFEMesh* msh,
         this->getProcessDistributionType() == FiniteElement::CONSTANT_NEUMANN)
         Const = true;
 
+    msh->ConstructEdges();
+
     // CFEMesh* msh = m_pcs->m_msh;
     // CFEMesh* msh;  // JOD
     // msh = FEMGet(pcs_type_name);
@@ -1797,6 +1807,8 @@ void CSourceTerm::FaceIntegration(CRFProcess* pcs,
                      "function doesn't function";
         return;
     }
+    // The element neighbours on the surface are the surface faces
+    msh->ConstructFaces();
 
     long i, j, k, l;
     long this_number_of_nodes;
@@ -4507,10 +4519,10 @@ void CSourceTerm::DirectAssign(CRFProcess* m_pcs, long ShiftInNodeVector)
                 node_area_vec[node_id];
         }
 
-        this->_distances =
-            new MathLib::InverseDistanceInterpolation<GEOLIB::PointWithID*,
-                                                      GEOLIB::Station*>(
-                points, this->_weather_stations);
+        delete this->_climate_interpolation;
+        this->_climate_interpolation =
+            new FiniteElement::ClimateStationInterpolation(
+                points, this->_weather_stations, _climate_n_nearest);
     }
     else  // NB this is the old version, where nodes were read from an separate
           // input file
@@ -4521,6 +4533,30 @@ void CSourceTerm::DirectAssign(CRFProcess* m_pcs, long ShiftInNodeVector)
         long n_index;
         double n_val;
 
+        //========================================================================
+        // Binary companion file
+        std::vector<long> node_ids;
+        std::vector<double> values;
+        std::size_t n_columns;
+        if (FileIO::NodeValuesBinaryIO::readCompanion(
+                fname, m_pcs->m_msh->GetNodesNumber(true), 1, node_ids,
+                values, n_columns))
+        {
+            for (std::size_t i = 0; i < node_ids.size(); i++)
+            {
+                CNodeValue* m_nod_val(new CNodeValue());
+                m_nod_val->msh_node_number = node_ids[i] + ShiftInNodeVector;
+                m_nod_val->geo_node_number = node_ids[i];
+                m_nod_val->setProcessDistributionType(
+                    getProcessDistributionType());
+                m_nod_val->node_value = values[i];
+                m_nod_val->CurveIndex = CurveIndex;
+                m_pcs->st_node_value.push_back(m_nod_val);
+                m_pcs->st_node.push_back(this);
+            }
+            return;
+        }
+
         //========================================================================
         // File handling
         std::ifstream d_file(fname.c_str(), std::ios::in);
@@ -4724,320 +4760,63 @@ std::string CSourceTerm::assignPrecipitationDirectlyOnTopSurfaceNodes(
  04/2006 Moved from CSourceTermGroup and changed the arguments
  last modification:
  04/2006 CMCD Updated
+ 11/2018 Sources of all nodes of the ST evaluated at once
  **************************************************************************/
-// , CSourceTerm *m_st)
 double CSourceTerm::GetAnalyticalSolution(long location)
 {
-    int idx, n;
-    int size, process_no;
-    long i;
-    long step, no_terms_included;
-    double value, source, gradient, ref_value = 0.0;
-    double timevalue;
-    double fac = 1.0;
-    double temp_time, temp_value;
-    double pi = 3.1415926;
-    double D = this->analytical_diffusion;
-    double ne = this->analytical_porosity;
-    double tort = this->analytical_tortousity;
-    double Kd = this->analytical_linear_sorption_Kd;
-    double rho = this->analytical_matrix_density;
-    double Dtrans = (D * ne) / ((ne + Kd * rho) * tort);
-    double Dsteady = D * ne / tort;
-    double t0, tn, tnn, val1, val2, node_area;
-    double tvol, vol, flux_area, tflux_area;
-    double mass_solute_present, mass_to_remove;
-    // WW  bool out = false;
-    // WW  int dimension = this->analytical_material_group;
-    std::string process;
-    CRFProcess* m_pcs = NULL;
-    m_pcs = PCSGet(
+    CRFProcess* m_pcs = PCSGet(
         convertProcessTypeToString(this->getProcessType()),
         convertPrimaryVariableToString(this->getProcessPrimaryVariable()));
-    CFEMesh* m_msh = m_pcs->m_msh;  // WW
-    MeshLib::CElem* Ele = NULL;
-    long node_number =
-        location;  // WW m_pcs->st_node_value[location]->msh_node_number;
-    CNode* Node = m_msh->nod_vector[node_number];
-    double area = m_pcs->st_node_value[location]->node_area;
-    std::vector<double> time_history;
-    std::vector<double> value_history;
-    // Initialise
-    time_history.clear();
-    value_history.clear();
-    t0 = tn = tnn = source = gradient = val1 = val2 = node_area = flux_area =
-        0.0;
-    idx = m_pcs->GetNodeValueIndex(
-        convertPrimaryVariableToString(this->getProcessPrimaryVariable()));
-    value = m_pcs->GetNodeValue(node_number, idx);
-    if (value < MKleinsteZahl)
-        value = 0.0;
-    timevalue = aktuelle_zeit;
-    step = aktueller_zeitschritt;
-    if (step < 10)
-        step = 10;
-    size = (int)analytical_processes.size();
-    process_no = 0;
-    // Domain or Polyline
-    for (i = 0; i < size; i++)
-    {
-        if (analytical_processes[i] ==
-            convertPrimaryVariableToString(this->getProcessPrimaryVariable()))
-        {
-            if (this->getGeoType() == GEOLIB::POLYLINE)
-            {
-                if (this->getGeoName().compare(
-                        analytical_processes_polylines[i]) == 0)
-                    process_no = i;
-            }
-            //			if (this->geo_type_name.compare("DOMAIN") == 0)
-            if (this->getGeoType() == GEOLIB::GEODOMAIN)
-                process_no = i;
-        }
-    }
-    // Identify process
-    if (process_no == 1)
-    {
-        process_no = process_no;
-    }
-    process_no *= 2;  // first column time, second column value, hence two
-                      // columns per process;
+    if (!_matrix_diffusion)
+        CreateMatrixDiffusionSourceTerm(m_pcs);
 
     // If time step require new calculation of source term then start
-    if ((aktueller_zeitschritt - 1) % this->resolution == 0)
+    if ((aktueller_zeitschritt - 1) % this->resolution == 0 &&
+        _matrix_diffusion->getTime() != aktuelle_zeit)
     {
-        // Save data in a vector attached to the nodes
-        this->SetNodePastValue(node_number, process_no, 0, timevalue);
-        this->SetNodePastValue(node_number, process_no + 1, 0, value);
-
-        // Recall historical data
-        ref_value =
-            this->GetNodePastValueReference(node_number, (process_no / 2));
-        if ((size_t)step > this->number_of_terms)
-            no_terms_included = this->number_of_terms;
-        else
-            no_terms_included = step;
-        for (i = 0; i < no_terms_included; i++)
+        const int idx = m_pcs->GetNodeValueIndex(
+            convertPrimaryVariableToString(this->getProcessPrimaryVariable()));
+        const std::size_t n_nodes(_matrix_diffusion->getNumberOfNodes());
+        std::vector<double> values(n_nodes);
+        for (std::size_t k = 0; k < n_nodes; k++)
         {
-            temp_time = this->GetNodePastValue(node_number, process_no, i);
-            temp_value =
-                (this->GetNodePastValue(node_number, process_no + 1, i) -
-                 ref_value);
-            time_history.push_back(temp_time);
-            value_history.push_back(temp_value);
+            values[k] =
+                m_pcs->GetNodeValue(_matrix_diffusion->getNodeID(k), idx);
+            if (values[k] < MKleinsteZahl)
+                values[k] = 0.0;
         }
-
-        // Calculate individual terms and sum for gradient
-        for (i = no_terms_included - 1; i > 0; i--)
-        {
-            t0 = time_history[0];
-            if (i == no_terms_included - 1)
-                tn = (t0 - time_history[i]) +
-                     (time_history[i - 1] - time_history[i]);
-            else
-                tn = t0 - time_history[i + 1];
-            tnn = t0 - time_history[i];
-            val1 = 1 / (sqrt(pi * Dtrans * tn));
-            val2 = 1 / (sqrt(pi * Dtrans * tnn));
-            gradient += ((val2 - val1) * value_history[i]);
-        }
-        tn = t0 - time_history[1];
-        tnn = 0;
-        val1 = 1 / (sqrt(pi * Dtrans * tn));
-        gradient -= (val1 * value_history[0]);
-
-        // Area calculations
-        mass_solute_present = 1.e99;  // Initially set value very high
-
-        // Area for lines, triangles and quads in domain.
-        //  if (area < 0) {//set in set source terms function, domain area = -1
-        //  to start with
-        if (area < DBL_MIN)
-        {  // HS 04.2008
-            tvol = 0.0;
-            tflux_area = 0.0;
-            for (i = 0; i < (int)Node->getConnectedElementIDs().size(); i++)
-            {
-                Ele = m_msh->ele_vector[Node->getConnectedElementIDs()[i]];
-                vol = Ele->GetVolume();  // Assuming 1m thickness
-                flux_area =
-                    Ele->GetFluxArea();  // Real thickness for a fracture
-                n = Ele->GetVertexNumber();
-                tvol += (vol / n);
-                tflux_area += (flux_area / n);
-            }
-            node_area = tvol * 2.;  //* 2 because the diffusion is in two
-                                    // direction perpendicular to the fracture
-            mass_solute_present = tflux_area * tvol * value;
-        }
-        // Area for polylines
-        else
-            node_area = area;
-
-        // factor for conversion to energy for temperature if necessary
-        fac = this->factor;
-        source = gradient * Dsteady * fac * node_area;
-        mass_to_remove = fabs(source) * dt;
-        if (mass_to_remove > mass_solute_present)
-        {
-            source *= (mass_solute_present / mass_to_remove);
-        }
-        this->SetNodeLastValue(node_number, (process_no / 2), source);
-
-    }  // If new source term calculation not required
-    else
-        source = this->GetNodeLastValue(node_number, (process_no / 2));
-    return source;
+        _matrix_diffusion->update(static_cast<long>(aktueller_zeitschritt),
+                                  aktuelle_zeit, dt, values);
+    }
+    return _matrix_diffusion->getSource(location);
 }
 
 /**************************************************************************
  FEMLib-Method:
- Task: master write function
+ Task: Set up the analytical matrix diffusion for the nodes of this ST
  Programing:
- 11/2005 CMCD Implementation, functions to access and write the time history
- data of nodes last modification:
+ 11/2018 Implementation
  **************************************************************************/
-void CSourceTerm::SetNodePastValue(long n, int idx, int pos, double value)
-{
-    bool endstepreached = false;
-    pos = pos;  // WW
-
-    // Check whether this is the first call
-    CRFProcess* m_pcs = NULL;
-    m_pcs = PCSGet(convertProcessTypeToString(getProcessType()),
-                   convertPrimaryVariableToString(getProcessPrimaryVariable()));
-    if (!m_pcs)  // OK
-    {
-        std::cout << "Warning in SetNodePastValue - no PCS data" << '\n';
-        return;
-    }
-
-    size_t size1(m_pcs->nod_val_vector.size());
-
-    // Create memory for the values
-    if (node_history_vector.empty())
-    {
-        // WW     int number_of_terms = max_no_terms;
-        for (size_t k = 0; k < size1; k++)
-        {
-            NODE_HISTORY* nh = new NODE_HISTORY;
-            CreateHistoryNodeMemory(nh);
-            node_history_vector.push_back(nh);
-        }
-        for (size_t k = 0; k < size1; k++)
-        {
-            for (size_t j = 0; j < _no_an_sol; j++)
-                node_history_vector[k]->value_reference.push_back(-1.0);
-        }
-    }
-
-    // Store the first set of values as reference values
-    int flipflop = idx % 2;
-    if (aktueller_zeitschritt == 1)
-    {
-        // if (size2 == idx)
-        if (flipflop == 1)
-            node_history_vector[n]->value_reference[(idx - 1) / 2] = value;
-    }
-    //  size2 = (int) node_history_vector[n]->value_reference.size();
-    size_t steps = 10;
-    if (aktueller_zeitschritt > steps)
-        steps = aktueller_zeitschritt;
-    if (_max_no_terms >= steps)
-        steps = aktueller_zeitschritt;
-    else
-    {
-        steps = _max_no_terms;
-        endstepreached = true;
-    }
-    // Enter the value and push the other values back
-    if (!endstepreached)
-    {
-        for (size_t k = steps - 1; k > 0; k--)
-            node_history_vector[n]->value_store[idx][k] =
-                node_history_vector[n]->value_store[idx][k - 1];
-        node_history_vector[n]->value_store[idx][0] = value;
-    }
-    double cutvalue = 0.0;
-    double nextvalue = 0.0;
-    long no_steps_past_cutof = 0;
-    if (endstepreached)
-    {
-        no_steps_past_cutof = aktueller_zeitschritt - _max_no_terms;
-        cutvalue = node_history_vector[n]->value_store[idx][steps - 1];
-        nextvalue = node_history_vector[n]->value_store[idx][steps - 2];
-        node_history_vector[n]->value_store[idx][steps - 1] =
-            (cutvalue * (double)(no_steps_past_cutof) + nextvalue) /
-            ((double)no_steps_past_cutof + 1);
-        for (size_t k = steps - 2; k > 0; k--)
-            node_history_vector[n]->value_store[idx][k] =
-                node_history_vector[n]->value_store[idx][k - 1];
-        node_history_vector[n]->value_store[idx][0] = value;
-    }
-}
-
-void CSourceTerm::SetNodeLastValue(long n, int idx, double value)
+void CSourceTerm::CreateMatrixDiffusionSourceTerm(CRFProcess* m_pcs)
 {
-    size_t size(node_history_vector[n]->last_source_value.size());
-    if (size == 0)
+    const double D = this->analytical_diffusion;
+    const double ne = this->analytical_porosity;
+    const double tort = this->analytical_tortousity;
+    const double Kd = this->analytical_linear_sorption_Kd;
+    const double rho = this->analytical_matrix_density;
+    const double Dtrans = (D * ne) / ((ne + Kd * rho) * tort);
+    const double Dsteady = D * ne / tort;
+    _matrix_diffusion = new FiniteElement::MatrixDiffusionSourceTerm(
+        Dtrans, Dsteady, this->factor, this->number_of_terms,
+        this->_max_no_terms, this->analytical_tolerance);
+
+    for (std::size_t i = 0; i < m_pcs->st_node_value.size(); i++)
     {
-        for (size_t i = 0; i < _no_an_sol; i++)
-            node_history_vector[n]->last_source_value.push_back(0);
-    }
-    node_history_vector[n]->last_source_value[idx] = value;
-}
-
-double CSourceTerm::GetNodeLastValue(long n, int idx)
-{
-    double value = 0.0;
-    value = node_history_vector[n]->last_source_value[idx];
-    return value;
-}
-
-double CSourceTerm::GetNodePastValue(long n, int idx, int pos)
-{
-    double value;
-    value = node_history_vector[n]->value_store[idx][pos];
-    return value;
-}
-
-double CSourceTerm::GetNodePastValueReference(long n, int idx)
-{
-    double value;
-    value = node_history_vector[n]->value_reference[idx];
-    return value;
-}
-
-void CSourceTerm::CreateHistoryNodeMemory(NODE_HISTORY* nh)
-{
-    size_t s_col = _no_an_sol * 2;
-    size_t s_row = number_of_terms;
-
-    nh->value_store = new double*[s_col];
-    for (size_t i = 0; i < s_col; i++)
-        nh->value_store[i] = new double[s_row];
-
-    for (size_t k = 0; k < s_col; k++)
-    {
-        for (size_t j = 0; j < s_row; j++)
-            nh->value_store[k][j] = 0.0;
-    }
-}
-
-void CSourceTerm::DeleteHistoryNodeMemory()
-{
-    size_t size(node_history_vector.size());
-    size_t s_row = _no_an_sol * 2;
-
-    if (size > 0)
-    {
-        for (size_t j = 0; j < size; j++)
-        {
-            for (size_t i = 0; i < s_row; i++)
-                delete node_history_vector[j]->value_store[i];
-            delete node_history_vector[j]->value_store;
-        }
-        node_history_vector.clear();
+        if (m_pcs->st_node[i] != this)
+            continue;
+        const CNodeValue* cnodev = m_pcs->st_node_value[i];
+        _matrix_diffusion->addNode(cnodev->msh_node_number, cnodev->node_area,
+                                   *m_pcs->m_msh, cnodev->geo_node_number);
     }
 }
 
@@ -35,10 +35,10 @@ namespace process  // WW
 class CRFProcessDeformation;
 };
 
-namespace MathLib
+namespace FiniteElement
 {
-template <class T1, class T2>
-class InverseDistanceInterpolation;
+class ClimateStationInterpolation;
+class MatrixDiffusionSourceTerm;
 }
 
 namespace MeshLib
@@ -49,15 +49,6 @@ class MeshNodesAlongPolyline;
 
 class SourceTerm;
 
-typedef struct
-{
-    std::vector<double> value_reference;
-    std::vector<double> last_source_value;
-    // double value_store[10][5000];
-    double** value_store;  //[PCS_NUMBER_MAX*2]First ref no processes(two fields
-                           // per process..time, value), second ref no
-                           // values
-} NODE_HISTORY;
 
 class CSourceTerm : public ProcessInfo, public GeoInfo, public DistributionInfo
 {
@@ -93,16 +84,6 @@ public:
     void SetNOD2MSHNOD(const std::vector<size_t>& nodes,
                        std::vector<size_t>& conditional_nodes) const;
 
-    double GetNodeLastValue(
-        long n, int idx);  // used only once in a global in rf_st_new
-    // used only once in a global in rf_st_new
-    void SetNodePastValue(long n, int idx, int pos, double value);
-    // used only once in a global in rf_st_new
-    void SetNodeLastValue(long n, int idx, double value);
-    double GetNodePastValue(long, int,
-                            int);  // used only once in a global in rf_st_new
-    // used only once in a global in rf_st_new
-    double GetNodePastValueReference(long n, int idx);
     // used only in sourcetermgroup
     void SetSurfaceNodeVectorConditional(
         std::vector<long>& sfc_nod_vector,
@@ -129,11 +110,10 @@ public:
     // KR / NB
 
     // including climate data into source terms
-    const MathLib::InverseDistanceInterpolation<GEOLIB::PointWithID*,
-                                                GEOLIB::Station*>*
-    getClimateStationDistanceInterpolation() const
+    FiniteElement::ClimateStationInterpolation*
+    getClimateStationInterpolation() const
     {
-        return this->_distances;
+        return this->_climate_interpolation;
     };
     const std::vector<GEOLIB::Station*>& getClimateStations() const
     {
@@ -239,10 +219,6 @@ public:
     {
         _max_no_terms = max_no_terms;
     }
-    void setNumberOfAnalyticalSolutions(size_t no_an_sol)
-    {
-        _no_an_sol = no_an_sol;
-    }
     double GetRelativeInterfacePermeability(CRFProcess* m_pcs,  // JOD
                                             double head,
                                             long msh_node);
@@ -279,8 +255,7 @@ private:  // TF, KR
     void ReadGeoType(std::ifstream* st_file, const GEOLIB::GEOObjects& geo_obj,
                      const std::string& unique_name);
 
-    void CreateHistoryNodeMemory(NODE_HISTORY* nh);
-    void DeleteHistoryNodeMemory();
+    void CreateMatrixDiffusionSourceTerm(CRFProcess* m_pcs);
 
     double geo_node_value;
     double epsilon;
@@ -306,7 +281,6 @@ private:  // TF, KR
 
     size_t number_of_terms;
     size_t _max_no_terms;  // used only once in a global in rf_st_new
-    size_t _no_an_sol;
     int analytical_material_group;  // used only once in a global in rf_st_new
     int resolution;                 // used only once in a global in rf_st_new
     double analytical_diffusion;    // used only once in a global in rf_st_new
@@ -317,6 +291,8 @@ private:  // TF, KR
     double
         analytical_matrix_density;  // used only once in a global in rf_st_new
     double factor;
+    /// relative weight below which the series of ANALYTICAL is truncated
+    double analytical_tolerance;
 
     double transfer_coefficient;  // TN - for DIS_TYPE TRANSFER_SURROUNDING
     double value_surrounding;     // TN - for DIS_TYPE TRANSFER_SURROUNDING
@@ -342,9 +318,13 @@ private:  // TF, KR
     double _coup_leakance;
 
     // including climate data into source terms
-    MathLib::InverseDistanceInterpolation<GEOLIB::PointWithID*,
-                                          GEOLIB::Station*>* _distances;  // NB
-    std::vector<GEOLIB::Station*> _weather_stations;                      // NB
+    FiniteElement::ClimateStationInterpolation* _climate_interpolation;
+    std::vector<GEOLIB::Station*> _weather_stations;  // NB
+    /// Number of stations interpolated to each surface node, 0 for all
+    std::size_t _climate_n_nearest;
+
+    /// Matrix diffusion of DIS_TYPE ANALYTICAL, set up on first use
+    FiniteElement::MatrixDiffusionSourceTerm* _matrix_diffusion;
 
     bool _isConstrainedST;
     std::vector<Constrained> _constrainedST;
@@ -33,6 +33,7 @@
 #include "rf_mmp_new.h"
 // kg44 not found #include "elements.h"
 #include "rfmat_cp.h"
+#include "StabilityAnalysis.h"
 #include "tools.h"
 #include <cctype>
 // WW #include "elements.h" //set functions for stability criteria
@@ -1954,63 +1955,32 @@ double CTimeDiscretization::SelfAdaptiveTimeControl(void)
 
 /**************************************************************************
    FEMLib-Method:
-   Task:
+   Task: Courant time step control. Returns the recommended advective time
+   step, the diffusion and grid Peclet limits are reported as well.
    Programing:CMCD 03/2006
+   11/2018 Fused parallel scan in FiniteElement::StabilityAnalysis
 **************************************************************************/
 double CTimeDiscretization::CheckCourant(void)
 {
-    long index;
-    long group;
-    double velocity[3] = {0., 0., 0.};
-    double porosity, vg, advective_velocity, length, courant;
-    CRFProcess* m_pcs = NULL;
-    m_pcs = PCSGetFluxProcess();
+    CRFProcess* m_pcs = PCSGetFluxProcess();
     if (!m_pcs)
     {
         return 0.0;
     }
-    int pcs_no = m_pcs->pcs_number;
-    CMediumProperties* m_mmp = NULL;
-    MeshLib::CElem* elem = NULL;
-    ElementValue* gp_ele;
-    long critical_element_no = -1;
-    double recommended_time_step = 0.0;
-    double stable_time_step = 0.0;
-    //  int edx;
+    const FiniteElement::StabilityLimits limits =
+        FiniteElement::StabilityAnalysis(
+            m_pcs, PCSGet(FiniteElement::MASS_TRANSPORT))
+            .evaluate(dt);
 
-    for (index = 0; index < (long)m_pcs->m_msh->ele_vector.size(); index++)
-    {
-        elem = m_pcs->m_msh->ele_vector[index];
-        length = elem->GetRepLength();
-        group = elem->GetPatchIndex();
-        m_mmp = mmp_vector[group];
-        m_mmp->m_pcs = m_pcs;
-        porosity = m_mmp->Porosity(m_mmp->Fem_Ele_Std);
-        gp_ele = ele_gp_value[index];  // to get gp velocities
-        gp_ele->getIPvalue_vec(pcs_no, velocity);
-        vg = MBtrgVec(velocity, 3);
-        advective_velocity = vg / porosity;
-        // kg44 avoid zero velocity..otherwise stable_time_step is a problem
-        if (advective_velocity < DBL_EPSILON)
-            advective_velocity = DBL_EPSILON;
-        courant = dt * advective_velocity / length;
-        elem->SetCourant(courant);
-        //    edx = m_pcs->GetElementValueIndex("COURANT"); //kg44 does this
-        //    work? m_pcs->SetElementValue(index,edx,courant);    // kg44 seems
-        //    not to work
-        stable_time_step = (1. / courant) * dt;
-        if (index == 0)
-            recommended_time_step = stable_time_step;
-        if (stable_time_step < recommended_time_step)
-        {
-            recommended_time_step = stable_time_step;
-            critical_element_no = index;
-        }
-    }
     std::cout << "Courant time step control, critical element = "
-              << critical_element_no << " Recomended time step "
-              << recommended_time_step << "\n";
-    return recommended_time_step;
+              << limits.courant_element << " Recomended time step "
+              << limits.courant_time_step << "\n";
+    if (limits.diffusion_element >= 0)
+        std::cout << "Diffusion number time step " << limits.diffusion_time_step
+                  << " (element " << limits.diffusion_element
+                  << "), max. grid Peclet number " << limits.max_peclet
+                  << " (element " << limits.peclet_element << ")\n";
+    return limits.courant_time_step;
 }
 
 /**************************************************************************
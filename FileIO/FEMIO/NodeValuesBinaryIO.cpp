@@ -0,0 +1,325 @@
+/*
+ * NodeValuesBinaryIO.cpp
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include "NodeValuesBinaryIO.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <sys/stat.h>
+
+namespace
+{
+const char magic[8] = {'O', 'G', 'S', 'N', 'O', 'D', 'V', '1'};
+
+bool isLittleEndian()
+{
+    const uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char*>(&one) == 1;
+}
+
+/// Reads the whole file into a zero terminated buffer
+bool readFile(std::string const& fname, std::vector<char>& buffer)
+{
+    std::ifstream in(fname.c_str(), std::ios::in | std::ios::binary);
+    if (!in.good())
+        return false;
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    buffer.resize(static_cast<std::size_t>(size) + 1);
+    in.read(&buffer[0], size);
+    buffer[static_cast<std::size_t>(size)] = '\0';
+    return true;
+}
+
+const std::size_t header_size = 8 + 2 * 4 + 2 * 8;
+
+/// Opens a binary node value file and reads its header. Checks that the
+/// size of the file matches the number of nodes and columns.
+bool readHeader(std::string const& fname, std::ifstream& in,
+                std::size_t& n_columns, uint64_t& n_nodes,
+                uint64_t& source_size)
+{
+    in.open(fname.c_str(), std::ios::in | std::ios::binary);
+    if (!in.good())
+        return false;
+    if (!isLittleEndian())
+    {
+        std::cout << "Error: binary node values " << fname
+                  << " are not read on a big-endian system"
+                  << "\n";
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    const uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    char file_magic[8];
+    uint32_t header[2];
+    in.read(file_magic, sizeof(file_magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    in.read(reinterpret_cast<char*>(&n_nodes), sizeof(n_nodes));
+    in.read(reinterpret_cast<char*>(&source_size), sizeof(source_size));
+    if (!in.good() || std::memcmp(file_magic, magic, sizeof(magic)) != 0)
+    {
+        std::cout << "Error: " << fname << " is not a binary node value file"
+                  << "\n";
+        return false;
+    }
+    n_columns = header[0];
+
+    // Compared per node, so that corrupt counts cannot overflow
+    const uint64_t node_size = sizeof(int64_t) + n_columns * sizeof(double);
+    if ((file_size - header_size) % node_size != 0 ||
+        (file_size - header_size) / node_size != n_nodes)
+    {
+        std::cout << "Error: binary node value file " << fname << " has "
+                  << file_size << " bytes, which does not match the header ("
+                  << n_nodes << " nodes, " << n_columns << " columns)"
+                  << "\n";
+        return false;
+    }
+    return true;
+}
+
+/// Skips the rest of the current line
+char const* nextLine(char const* p)
+{
+    while (*p != '\0' && *p != '\n')
+        ++p;
+    return (*p == '\n') ? p + 1 : p;
+}
+}  // namespace
+
+namespace FileIO
+{
+bool NodeValuesBinaryIO::read(std::string const& fname,
+                              std::vector<long>& node_ids,
+                              std::vector<double>& values,
+                              std::size_t& n_columns)
+{
+    uint64_t n_nodes, source_size;
+    std::ifstream in;
+    if (!readHeader(fname, in, n_columns, n_nodes, source_size))
+        return false;
+
+    std::vector<int64_t> ids(n_nodes);
+    values.resize(n_columns * n_nodes);
+    if (n_nodes > 0)
+    {
+        in.read(reinterpret_cast<char*>(&ids[0]), n_nodes * sizeof(int64_t));
+        if (n_columns > 0)
+            in.read(reinterpret_cast<char*>(&values[0]),
+                    values.size() * sizeof(double));
+    }
+    if (!in.good())
+    {
+        std::cout << "Error: could not read binary node value file " << fname
+                  << "\n";
+        return false;
+    }
+    node_ids.assign(ids.begin(), ids.end());
+    return true;
+}
+
+bool NodeValuesBinaryIO::readCompanion(std::string const& text_fname,
+                                       std::size_t n_mesh_nodes,
+                                       std::size_t n_expected_columns,
+                                       std::vector<long>& node_ids,
+                                       std::vector<double>& values,
+                                       std::size_t& n_columns)
+{
+    const std::string fname(getBinaryFileName(text_fname));
+    struct stat bin_info;
+    if (stat(fname.c_str(), &bin_info) != 0)
+        return false;
+    struct stat text_info;
+    const bool has_text(stat(text_fname.c_str(), &text_info) == 0);
+    if (has_text && bin_info.st_mtime < text_info.st_mtime)
+    {
+        std::cout << "Warning: " << fname << " is older than " << text_fname
+                  << ", reading the text file"
+                  << "\n";
+        return false;
+    }
+
+    uint64_t n_nodes, source_size;
+    {
+        std::ifstream in;
+        if (!readHeader(fname, in, n_columns, n_nodes, source_size))
+            std::exit(1);
+    }
+    if (has_text && source_size != static_cast<uint64_t>(text_info.st_size))
+    {
+        std::cout << "Warning: " << fname << " was not written from the "
+                  << "current " << text_fname << ", reading the text file"
+                  << "\n";
+        return false;
+    }
+    if (n_columns == 0 ||
+        (n_expected_columns > 0 && n_columns != n_expected_columns))
+    {
+        std::cout << "Error: " << fname << " has " << n_columns
+                  << " value columns instead of " << n_expected_columns
+                  << "\n";
+        std::exit(1);
+    }
+    if (n_nodes > n_mesh_nodes)
+    {
+        std::cout << "Error: " << fname << " has values of " << n_nodes
+                  << " nodes, the mesh has " << n_mesh_nodes << " nodes"
+                  << "\n";
+        std::exit(1);
+    }
+
+    if (!read(fname, node_ids, values, n_columns))
+        std::exit(1);
+    for (std::size_t i = 0; i < node_ids.size(); i++)
+    {
+        if (node_ids[i] < 0 ||
+            static_cast<std::size_t>(node_ids[i]) >= n_mesh_nodes)
+        {
+            std::cout << "Error: " << fname << " has a value of node "
+                      << node_ids[i] << ", the mesh has " << n_mesh_nodes
+                      << " nodes"
+                      << "\n";
+            std::exit(1);
+        }
+    }
+    std::cout << "-> Read node values from " << fname << "\n";
+    return true;
+}
+
+bool NodeValuesBinaryIO::write(std::string const& fname,
+                               std::vector<long> const& node_ids,
+                               std::vector<double> const& values,
+                               std::size_t n_columns,
+                               uint64_t source_size)
+{
+    if (!isLittleEndian() || values.size() != n_columns * node_ids.size())
+        return false;
+    std::ofstream out(fname.c_str(), std::ios::out | std::ios::binary);
+    if (!out.good())
+        return false;
+
+    const uint32_t header[2] = {static_cast<uint32_t>(n_columns), 0};
+    const uint64_t n_nodes = node_ids.size();
+    const std::vector<int64_t> ids(node_ids.begin(), node_ids.end());
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<char const*>(header), sizeof(header));
+    out.write(reinterpret_cast<char const*>(&n_nodes), sizeof(n_nodes));
+    out.write(reinterpret_cast<char const*>(&source_size),
+              sizeof(source_size));
+    if (n_nodes > 0)
+    {
+        out.write(reinterpret_cast<char const*>(&ids[0]),
+                  n_nodes * sizeof(int64_t));
+        if (n_columns > 0)
+            out.write(reinterpret_cast<char const*>(&values[0]),
+                      values.size() * sizeof(double));
+    }
+    return out.good();
+}
+
+bool NodeValuesBinaryIO::readDirectText(std::string const& fname,
+                                        std::vector<long>& node_ids,
+                                        std::vector<double>& values)
+{
+    std::vector<char> buffer;
+    if (!readFile(fname, buffer))
+        return false;
+
+    node_ids.clear();
+    values.clear();
+    char const* p = &buffer[0];
+    while (*p != '\0')
+    {
+        char const* const line = p;
+        p = nextLine(p);
+        if (std::strncmp(line, "#STOP", 5) == 0)
+            break;
+        char* end;
+        const long id = std::strtol(line, &end, 10);
+        if (end == line)  // blank line
+            continue;
+        char const* const value_begin = end;
+        const double value = std::strtod(value_begin, &end);
+        if (end == value_begin)
+            continue;
+        node_ids.push_back(id);
+        values.push_back(value);
+    }
+    return true;
+}
+
+bool NodeValuesBinaryIO::readRestartText(std::string const& fname,
+                                         std::vector<long>& node_ids,
+                                         std::vector<double>& values,
+                                         std::size_t& n_columns)
+{
+    std::vector<char> buffer;
+    if (!readFile(fname, buffer))
+        return false;
+
+    // two header lines, number of variables, their component numbers and
+    // names "NAME, unit"
+    char const* p = nextLine(nextLine(&buffer[0]));
+    char* end;
+    n_columns = std::strtol(p, &end, 10);
+    p = end;
+    for (std::size_t i = 0; i < n_columns; i++)
+    {
+        std::strtol(p, &end, 10);
+        p = end;
+    }
+    for (std::size_t i = 0; i < 2 * n_columns; i++)
+    {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+            ++p;
+        while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\n' &&
+               *p != '\r')
+            ++p;
+    }
+
+    // rows "node_id value_1 ... value_n"
+    std::vector<double> row(n_columns);
+    std::vector<std::vector<double> > columns(n_columns);
+    node_ids.clear();
+    while (true)
+    {
+        const double id = std::strtod(p, &end);
+        if (end == p)
+            break;
+        p = end;
+        std::size_t i = 0;
+        for (; i < n_columns; i++)
+        {
+            row[i] = std::strtod(p, &end);
+            if (end == p)
+                break;
+            p = end;
+        }
+        if (i < n_columns)
+            break;
+        node_ids.push_back(static_cast<long>(id));
+        for (i = 0; i < n_columns; i++)
+            columns[i].push_back(row[i]);
+    }
+
+    values.clear();
+    values.reserve(n_columns * node_ids.size());
+    for (std::size_t i = 0; i < n_columns; i++)
+        values.insert(values.end(), columns[i].begin(), columns[i].end());
+    return true;
+}
+}  // namespace FileIO
@@ -0,0 +1,92 @@
+/*
+ * NodeValuesBinaryIO.h
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef NODEVALUESBINARYIO_H_
+#define NODEVALUESBINARYIO_H_
+
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace FileIO
+{
+/**
+ * Binary companion format of the node value files of DIRECT initial and
+ * boundary conditions and source terms and of RESTART (.rfr) files. The
+ * binary file has the name of the text file with the extension ".bin"
+ * appended. It is used instead of the text file if it is not older than
+ * the text file and the text file still has the size recorded in the
+ * header.
+ *
+ * Layout (little-endian):
+ * - 8 bytes magic "OGSNODV1"
+ * - uint32 number of value columns, uint32 reserved (0)
+ * - uint64 number of nodes n
+ * - uint64 size of the text file in bytes
+ * - int64 node ids [n]
+ * - double values [n_columns][n], column by column
+ */
+class NodeValuesBinaryIO
+{
+public:
+    /// Name of the binary companion of the text file fname
+    static std::string getBinaryFileName(std::string const& fname)
+    {
+        return fname + ".bin";
+    }
+
+    /**
+     * Reads a binary node value file. values holds the columns one after
+     * another, i.e. values[c * node_ids.size() + i] is the value of column c
+     * at node node_ids[i].
+     * @return false if the file does not exist or its size does not match
+     * the header
+     */
+    static bool read(std::string const& fname, std::vector<long>& node_ids,
+                     std::vector<double>& values, std::size_t& n_columns);
+
+    /**
+     * Reads the binary companion of the text file text_fname, if it is up
+     * to date, and reports which of the two files is read. Exits with an
+     * error if the companion is up to date but invalid: its size does not
+     * match the header, it has more nodes than the mesh or node ids outside
+     * the mesh, or not n_expected_columns columns (0: any number).
+     * @return false if the text file has to be read
+     */
+    static bool readCompanion(std::string const& text_fname,
+                              std::size_t n_mesh_nodes,
+                              std::size_t n_expected_columns,
+                              std::vector<long>& node_ids,
+                              std::vector<double>& values,
+                              std::size_t& n_columns);
+
+    /// Writes a binary node value file, values as in read(). source_size is
+    /// the size of the text file the values are read from.
+    static bool write(std::string const& fname,
+                      std::vector<long> const& node_ids,
+                      std::vector<double> const& values,
+                      std::size_t n_columns,
+                      uint64_t source_size);
+
+    /// Reads a text file with lines "node_id value" terminated by #STOP
+    static bool readDirectText(std::string const& fname,
+                               std::vector<long>& node_ids,
+                               std::vector<double>& values);
+
+    /// Reads the node values of all variables of a RESTART (.rfr) file
+    static bool readRestartText(std::string const& fname,
+                                std::vector<long>& node_ids,
+                                std::vector<double>& values,
+                                std::size_t& n_columns);
+};
+}  // namespace FileIO
+
+#endif /* NODEVALUESBINARYIO_H_ */
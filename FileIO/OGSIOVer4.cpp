@@ -29,7 +29,6 @@
 #include "Surface.h"
 #include "Triangle.h"
 
-// for tests only
 #include "PointVec.h"
 
 // MathLib
@@ -114,9 +113,21 @@ std::string readPoints(std::istream& in, std::vector<Point*>* pnt_vec,
     return line;
 }
 
+/** adds a point, which has no id in the file, to the point vector and returns
+ * its id - an identical point already in the point vector is reused */
+std::size_t insertPoint(Point* pnt, std::vector<Point*>& pnt_vec,
+                        PointVec* pnt_vec_obj)
+{
+    if (pnt_vec_obj)
+        return pnt_vec_obj->uniqueInsert(pnt);
+    pnt_vec.push_back(pnt);
+    return pnt_vec.size() - 1;
+}
+
 /** reads points from a vector */
 void readPolylinePointVector(const std::string& fname,
-                             std::vector<Point*>& pnt_vec, Polyline* ply,
+                             std::vector<Point*>& pnt_vec,
+                             PointVec* pnt_vec_obj, Polyline* ply,
                              const std::string& path,
                              std::vector<std::string>& errors)
 {
@@ -134,9 +145,14 @@ void readPolylinePointVector(const std::string& fname,
     while (in)
     {
         in >> x >> y >> z;
-        size_t pnt_id(pnt_vec.size());
-        pnt_vec.push_back(new Point(x, y, z));
-        ply->addPoint(pnt_id);
+        std::size_t id(insertPoint(new Point(x, y, z), pnt_vec, pnt_vec_obj));
+        // A point repeating the first point of the polyline keeps a point of
+        // its own, so that the polyline is not closed by making the points
+        // unique.
+        if (pnt_vec_obj && ply->getNumberOfPoints() > 0 &&
+            id == ply->getPointID(0))
+            id = pnt_vec_obj->insert(new Point(x, y, z));
+        ply->addPoint(id);
     }
 }
 
@@ -156,6 +172,7 @@ std::string readPolyline(std::istream& in,
                          std::vector<Polyline*>* ply_vec,
                          std::map<std::string, size_t>& ply_vec_names,
                          std::vector<Point*>& pnt_vec,
+                         PointVec* pnt_vec_obj,
                          bool zero_based_indexing,
                          const std::vector<size_t>& pnt_id_map,
                          const std::string& path,
@@ -229,7 +246,8 @@ std::string readPolyline(std::istream& in,
         {
             in >> line;  // read file name
             line = path + line;
-            readPolylinePointVector(line, pnt_vec, ply, path, errors);
+            readPolylinePointVector(line, pnt_vec, pnt_vec_obj, ply, path,
+                                    errors);
         }  // subkeyword found
     } while (line.find("#") == std::string::npos && line.size() != 0 && in);
 
@@ -257,6 +275,7 @@ polyline 08/2005 CC parameter 01/2010 TF changed signature of function
 std::string readPolylines(std::istream& in, std::vector<Polyline*>* ply_vec,
                           std::map<std::string, size_t>& ply_vec_names,
                           std::vector<Point*>& pnt_vec,
+                          PointVec* pnt_vec_obj,
                           bool zero_based_indexing,
                           const std::vector<size_t>& pnt_id_map,
                           const std::string& path,
@@ -271,14 +290,15 @@ std::string readPolylines(std::istream& in, std::vector<Polyline*>* ply_vec,
     std::string tag("#POLYLINE");
 
     while (!in.eof() && tag.find("#POLYLINE") != std::string::npos)
-        tag = readPolyline(in, ply_vec, ply_vec_names, pnt_vec,
+        tag = readPolyline(in, ply_vec, ply_vec_names, pnt_vec, pnt_vec_obj,
                            zero_based_indexing, pnt_id_map, path, errors);
 
     return tag;
 }
 
 void readTINFile(const std::string& fname, Surface* sfc,
-                 std::vector<Point*>& pnt_vec, std::vector<std::string>& errors)
+                 std::vector<Point*>& pnt_vec, PointVec* pnt_vec_obj,
+                 std::vector<std::string>& errors)
 {
     // open file
     std::ifstream in(fname.c_str());
@@ -363,13 +383,15 @@ void readTINFile(const std::string& fname, Surface* sfc,
             return;
         }
 
-        // determine size pnt_vec to insert the correct ids
-        std::size_t const pnt_pos(pnt_vec.size());
-        pnt_vec.push_back(new GEOLIB::Point(p0));
-        pnt_vec.push_back(new GEOLIB::Point(p1));
-        pnt_vec.push_back(new GEOLIB::Point(p2));
+        // the points are shared by the adjacent triangles
+        std::size_t const id0(
+            insertPoint(new GEOLIB::Point(p0), pnt_vec, pnt_vec_obj));
+        std::size_t const id1(
+            insertPoint(new GEOLIB::Point(p1), pnt_vec, pnt_vec_obj));
+        std::size_t const id2(
+            insertPoint(new GEOLIB::Point(p2), pnt_vec, pnt_vec_obj));
         // create new Triangle
-        sfc->addTriangle(pnt_pos, pnt_pos + 1, pnt_pos + 2);
+        sfc->addTriangle(id0, id1, id2);
     }
 
     if (sfc->getNTriangles() == 0)
@@ -397,7 +419,8 @@ std::string readSurface(std::istream& in, std::vector<Polygon*>& polygon_vec,
                         std::map<std::string, size_t>& sfc_names,
                         const std::vector<Polyline*>& ply_vec,
                         const std::map<std::string, size_t>& ply_vec_names,
-                        std::vector<Point*>& pnt_vec, std::string const& path,
+                        std::vector<Point*>& pnt_vec, PointVec* pnt_vec_obj,
+                        std::string const& path,
                         std::vector<std::string>& errors)
 {
     std::string line;
@@ -435,7 +458,7 @@ std::string readSurface(std::istream& in, std::vector<Polygon*>& polygon_vec,
             line = path + line;
             sfc = new Surface(pnt_vec);
 
-            readTINFile(line, sfc, pnt_vec, errors);
+            readTINFile(line, sfc, pnt_vec, pnt_vec_obj, errors);
             if (sfc->getNTriangles() == 0)
             {
                 delete sfc;
@@ -539,7 +562,8 @@ std::string readSurfaces(std::istream& in, std::vector<Surface*>& sfc_vec,
                          std::map<std::string, size_t>& sfc_names,
                          const std::vector<Polyline*>& ply_vec,
                          const std::map<std::string, size_t>& ply_vec_names,
-                         std::vector<Point*>& pnt_vec, const std::string& path,
+                         std::vector<Point*>& pnt_vec, PointVec* pnt_vec_obj,
+                         const std::string& path,
                          std::vector<std::string>& errors)
 {
     if (!in.good())
@@ -556,7 +580,7 @@ std::string readSurfaces(std::istream& in, std::vector<Surface*>& sfc_vec,
     {
         size_t n_polygons(polygon_vec.size());
         tag = readSurface(in, polygon_vec, sfc_vec, sfc_names, ply_vec,
-                          ply_vec_names, pnt_vec, path, errors);
+                          ply_vec_names, pnt_vec, pnt_vec_obj, path, errors);
         if (n_polygons < polygon_vec.size())
         {
             // subdivide polygon in simple polygons
@@ -680,10 +704,17 @@ bool readGLIFileV4(const std::string& fname, GEOObjects* geo,
               << "\n";
 
     unique_name = BaseLib::getFileNameFromPath(fname, true);
+    // points of polylines and surfaces read from external files are added
+    // to the point vector without duplicates
+    PointVec* pnt_vec_obj(NULL);
     if (!pnt_vec->empty())
+    {
         geo->addPointVec(
             pnt_vec, unique_name,
             pnt_id_names_map);  // KR: insert into GEOObjects if not empty
+        pnt_vec_obj =
+            const_cast<PointVec*>(geo->getPointVecObj(unique_name));
+    }
 
     // extract path for reading external files
     std::string path;
@@ -695,7 +726,8 @@ bool readGLIFileV4(const std::string& fname, GEOObjects* geo,
     if (tag.find("#POLYLINE") != std::string::npos && in)
     {
         std::cout << "read polylines from stream ... " << std::flush;
-        tag = readPolylines(in, ply_vec, *ply_names, *pnt_vec, zero_based_idx,
+        tag = readPolylines(in, ply_vec, *ply_names, *pnt_vec, pnt_vec_obj,
+                            zero_based_idx,
                             geo->getPointVecObj(unique_name)->getIDMap(), path,
                             errors);
         std::cout << " ok, " << ply_vec->size() << " polylines read"
@@ -712,7 +744,7 @@ bool readGLIFileV4(const std::string& fname, GEOObjects* geo,
     {
         std::cout << "read surfaces from stream ... " << std::flush;
         tag = readSurfaces(in, *sfc_vec, *sfc_names, *ply_vec, *ply_names,
-                           *pnt_vec, path, errors);
+                           *pnt_vec, pnt_vec_obj, path, errors);
         std::cout << " ok, " << sfc_vec->size() << " surfaces read"
                   << "\n";
     }
@@ -10,7 +10,9 @@
 
 // RapidXML
 #include "RapidXMLInterface.h"
+#include <fstream>
 #include <iostream>
+#include <string>
 
 #include "StringTools.h"
 #include "Station.h"
@@ -20,7 +22,6 @@ namespace FileIO
 std::vector<GEOLIB::Point*>* RapidXMLInterface::readStationFile(
     const std::string& fileName)
 {
-    std::vector<GEOLIB::Point*>* stations = new std::vector<GEOLIB::Point*>;
     std::ifstream in(fileName.c_str());
     if (in.fail())
     {
@@ -29,53 +30,177 @@ std::vector<GEOLIB::Point*>* RapidXMLInterface::readStationFile(
         return NULL;
     }
 
-    // buffer file
-    in.seekg(0, std::ios::end);
-    size_t length = in.tellg();
-    in.seekg(0, std::ios::beg);
-    char* buffer = new char[length + 1];
-    in.read(buffer, length);
-    buffer[in.gcount()] = '\0';
-    in.close();
+    // The file is read in chunks and each station is parsed on its own, i.e.
+    // only the current part of the file and the DOM tree of a single station
+    // are kept in memory.
+    std::vector<GEOLIB::Point*>* stations = new std::vector<GEOLIB::Point*>;
+    std::string buffer;
+    std::size_t pos(0);
+    bool root_found(false);
+    // names of the elements enclosing the current markup
+    std::vector<std::string> open_elements;
+    for (;;)
+    {
+        // next markup or, for stations and boreholes, the complete element
+        std::string name;
+        std::size_t const begin(buffer.find('<', pos));
+        std::size_t end(std::string::npos);
+        if (begin != std::string::npos)
+        {
+            end = findMarkupEnd(buffer, begin);
+            if (end != std::string::npos)
+            {
+                name = buffer.substr(
+                    begin + 1,
+                    buffer.find_first_of(" \t\r\n/>", begin + 1) - begin - 1);
+                if ((name == "station" || name == "borehole") &&
+                    buffer[end - 2] != '/')
+                    end = findElementEnd(buffer, end);
+            }
+        }
+        if (end == std::string::npos)
+        {
+            // keep the incomplete part and read more data
+            buffer.erase(0, begin == std::string::npos ? buffer.size() : begin);
+            pos = 0;
+            if (!readChunk(in, buffer))
+                break;
+            continue;
+        }
+        pos = end;
 
-    // build DOM tree
-    rapidxml::xml_document<> doc;
-    doc.parse<0>(buffer);
+        if (name.empty() || name[0] == '?' || name[0] == '!')
+            continue;
+        if (name[0] == '/')
+        {
+            if (!open_elements.empty())
+                open_elements.pop_back();
+            continue;
+        }
+        bool const empty_element(buffer[end - 2] == '/');
+        if (!root_found)
+        {
+            if (name.compare("OpenGeoSysSTN"))
+            {
+                std::cout << "XmlStnInterface::readFile() - Unexpected XML "
+                             "root."
+                          << "\n";
+                delete stations;
+                return NULL;
+            }
+            root_found = true;
+            if (!empty_element)
+                open_elements.push_back(name);
+            continue;
+        }
+        if (name == "station" || name == "borehole")
+        {
+            // stations outside of the station and borehole lists are
+            // skipped together with their content
+            if (open_elements.empty() ||
+                (open_elements.back() != "stations" &&
+                 open_elements.back() != "boreholes"))
+                continue;
 
-    // parse content
-    if (std::string(doc.first_node()->name()).compare("OpenGeoSysSTN"))
+            // build DOM tree of the station
+            std::vector<char> element(buffer.begin() + begin,
+                                      buffer.begin() + end);
+            element.push_back('\0');
+            rapidxml::xml_document<> doc;
+            doc.parse<0>(&element[0]);
+            RapidXMLInterface::readStation(doc.first_node(), stations,
+                                           fileName);
+            continue;
+        }
+        if (!empty_element)
+            open_elements.push_back(name);
+    }
+    in.close();
+
+    if (!root_found)
     {
         std::cout << "XmlStnInterface::readFile() - Unexpected XML root."
                   << "\n";
         delete stations;
         return NULL;
     }
+    return stations;
+}
 
-    // iterate over all station lists
-    for (rapidxml::xml_node<>* station_list = doc.first_node()->first_node();
-         station_list;
-         station_list = station_list->next_sibling())
+std::size_t RapidXMLInterface::findMarkupEnd(std::string const& buffer,
+                                             std::size_t begin)
+{
+    std::size_t end(std::string::npos);
+    if (buffer.compare(begin, 4, "<!--") == 0)
     {
-        std::string stnName("[NN]");
+        end = buffer.find("-->", begin + 4);
+        return (end == std::string::npos) ? end : end + 3;
+    }
+    if (buffer.compare(begin, 9, "<![CDATA[") == 0)
+    {
+        end = buffer.find("]]>", begin + 9);
+        return (end == std::string::npos) ? end : end + 3;
+    }
+    if (buffer.compare(begin, 2, "<?") == 0)
+    {
+        end = buffer.find("?>", begin + 2);
+        return (end == std::string::npos) ? end : end + 2;
+    }
 
-        stnName = station_list->first_node("name")->value();
-        for (rapidxml::xml_node<>* list_item = station_list->first_node();
-             list_item;
-             list_item = list_item->next_sibling())
+    // tags and declarations: '>' in quoted attribute values and in the
+    // internal subset of a DOCTYPE declaration does not end the markup
+    bool const declaration(buffer.compare(begin, 2, "<!") == 0);
+    char quote(0);
+    int brackets(0);
+    for (std::size_t i = begin + 1; i < buffer.size(); i++)
+    {
+        char const c(buffer[i]);
+        if (quote)
         {
-            std::string b(list_item->name());
-            if (std::string(list_item->name()).compare("stations") == 0)
-                RapidXMLInterface::readStations(list_item, stations, fileName);
-            if (std::string(list_item->name()).compare("boreholes") == 0)
-                RapidXMLInterface::readStations(list_item, stations, fileName);
+            if (c == quote)
+                quote = 0;
         }
+        else if (c == '"' || c == '\'')
+            quote = c;
+        else if (declaration && c == '[')
+            brackets++;
+        else if (declaration && c == ']')
+            brackets--;
+        else if (c == '>' && brackets <= 0)
+            return i + 1;
     }
+    return std::string::npos;
+}
 
-    doc.clear();
-    delete[] buffer;
+std::size_t RapidXMLInterface::findElementEnd(std::string const& buffer,
+                                              std::size_t pos)
+{
+    int depth(1);
+    while (depth > 0)
+    {
+        std::size_t const begin(buffer.find('<', pos));
+        if (begin == std::string::npos)
+            return begin;
+        pos = findMarkupEnd(buffer, begin);
+        if (pos == std::string::npos)
+            return pos;
+        char const c(buffer[begin + 1]);
+        if (c == '/')
+            depth--;
+        else if (c != '!' && c != '?' && buffer[pos - 2] != '/')
+            depth++;
+    }
+    return pos;
+}
 
-    return stations;
+bool RapidXMLInterface::readChunk(std::istream& in, std::string& buffer)
+{
+    char chunk[65536];
+    in.read(chunk, sizeof(chunk));
+    buffer.append(chunk, static_cast<std::size_t>(in.gcount()));
+    return in.gcount() > 0;
 }
+
 /*
 int RapidXMLInterface::rapidReadFile(const std::string &fileName)
 {
@@ -139,79 +264,74 @@ fileName);
     return 1;
 }
 */
-void RapidXMLInterface::readStations(const rapidxml::xml_node<>* station_root,
-                                     std::vector<GEOLIB::Point*>* stations,
-                                     const std::string& file_name)
+void RapidXMLInterface::readStation(const rapidxml::xml_node<>* station_node,
+                                    std::vector<GEOLIB::Point*>* stations,
+                                    const std::string& file_name)
 {
-    for (rapidxml::xml_node<>* station_node = station_root->first_node();
-         station_node;
-         station_node = station_node->next_sibling())
+    if (station_node->first_attribute("id") &&
+        station_node->first_attribute("x") &&
+        station_node->first_attribute("y"))
     {
-        if (station_node->first_attribute("id") &&
-            station_node->first_attribute("x") &&
-            station_node->first_attribute("y"))
-        {
-            double zVal(0.0);
-            if (station_node->first_attribute("z"))
-                zVal = strtod(station_node->first_attribute("z")->value(), 0);
+        double zVal(0.0);
+        if (station_node->first_attribute("z"))
+            zVal = strtod(station_node->first_attribute("z")->value(), 0);
 
-            std::string station_name(""), sensor_data_file_name(""),
-                bdate_str("0000-00-00");
-            double station_value(0.0), borehole_depth(0.0);
-            if (station_node->first_node("name"))
-                station_name = station_node->first_node("name")->value();
-            if (station_node->first_node("sensordata"))
-                sensor_data_file_name =
-                    station_node->first_node("sensordata")->value();
-            if (station_node->first_node("value"))
-                station_value =
-                    strtod(station_node->first_node("value")->value(), 0);
-            /* add other station features here */
+        std::string station_name(""), sensor_data_file_name(""),
+            bdate_str("0000-00-00");
+        double station_value(0.0), borehole_depth(0.0);
+        if (station_node->first_node("name"))
+            station_name = station_node->first_node("name")->value();
+        if (station_node->first_node("sensordata"))
+            sensor_data_file_name =
+                station_node->first_node("sensordata")->value();
+        if (station_node->first_node("value"))
+            station_value =
+                strtod(station_node->first_node("value")->value(), 0);
+        /* add other station features here */
 
-            if (std::string(station_node->name()).compare("station") == 0)
-            {
-                GEOLIB::Station* s = new GEOLIB::Station(
+        if (std::string(station_node->name()).compare("station") == 0)
+        {
+            GEOLIB::Station* s = new GEOLIB::Station(
+                strtod(station_node->first_attribute("x")->value(), 0),
+                strtod(station_node->first_attribute("y")->value(), 0),
+                zVal,
+                station_name);
+            s->setStationValue(station_value);
+            if (!sensor_data_file_name.empty())
+                s->addSensorDataFromCSV(BaseLib::copyPathToFileName(
+                    sensor_data_file_name, file_name));
+            stations->push_back(s);
+        }
+        else if (std::string(station_node->name()).compare("borehole") == 0)
+        {
+            if (station_node->first_node("bdepth"))
+                borehole_depth =
+                    strtod(station_node->first_node("bdepth")->value(), 0);
+            if (station_node->first_node("bdate"))
+                bdate_str = station_node->first_node("bdate")->value();
+            /* add other borehole features here */
+
+            GEOLIB::StationBorehole* s =
+                GEOLIB::StationBorehole::createStation(
+                    station_name,
                     strtod(station_node->first_attribute("x")->value(), 0),
                     strtod(station_node->first_attribute("y")->value(), 0),
                     zVal,
-                    station_name);
-                s->setStationValue(station_value);
-                if (!sensor_data_file_name.empty())
-                    s->addSensorDataFromCSV(BaseLib::copyPathToFileName(
-                        sensor_data_file_name, file_name));
-                stations->push_back(s);
-            }
-            else if (std::string(station_node->name()).compare("borehole") == 0)
-            {
-                if (station_node->first_node("bdepth"))
-                    borehole_depth =
-                        strtod(station_node->first_node("bdepth")->value(), 0);
-                if (station_node->first_node("bdate"))
-                    bdate_str = station_node->first_node("bdate")->value();
-                /* add other borehole features here */
-
-                GEOLIB::StationBorehole* s =
-                    GEOLIB::StationBorehole::createStation(
-                        station_name,
-                        strtod(station_node->first_attribute("x")->value(), 0),
-                        strtod(station_node->first_attribute("y")->value(), 0),
-                        zVal,
-                        borehole_depth,
-                        bdate_str);
-                s->setStationValue(station_value);
+                    borehole_depth,
+                    bdate_str);
+            s->setStationValue(station_value);
 
-                if (station_node->first_node("strat"))
-                    RapidXMLInterface::readStratigraphy(
-                        station_node->first_node("strat"), s);
+            if (station_node->first_node("strat"))
+                RapidXMLInterface::readStratigraphy(
+                    station_node->first_node("strat"), s);
 
-                stations->push_back(s);
-            }
+            stations->push_back(s);
         }
-        else
-            std::cout << "XmlStnInterface::rapidReadStations() - Attribute "
-                         "missing in <station> tag ..."
-                      << "\n";
     }
+    else
+        std::cout << "XmlStnInterface::rapidReadStations() - Attribute "
+                     "missing in <station> tag ..."
+                  << "\n";
 }
 
 void RapidXMLInterface::readStratigraphy(const rapidxml::xml_node<>* strat_root,
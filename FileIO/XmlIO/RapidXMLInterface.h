@@ -12,6 +12,8 @@
 #define RAPIDXMLINTERFACE_H
 
 #include "RapidXML/rapidxml.hpp"
+#include <istream>
+#include <string>
 #include <vector>
 
 #include "Point.h"
@@ -36,11 +38,26 @@ public:
         const std::string& fileName);
 
 private:
-    /// Reads GEOLIB::Station- or StationBorehole-objects from an xml-file using
-    /// the RapidXML parser
-    static void readStations(const rapidxml::xml_node<>* station_root,
-                             std::vector<GEOLIB::Point*>* stations,
-                             const std::string& file_name);
+    /// Reads a GEOLIB::Station- or StationBorehole-object from the DOM tree of
+    /// a single station using the RapidXML parser
+    static void readStation(const rapidxml::xml_node<>* station_node,
+                            std::vector<GEOLIB::Point*>* stations,
+                            const std::string& file_name);
+
+    /// Appends the next part of the file to the buffer, returns false at the
+    /// end of the file
+    static bool readChunk(std::istream& in, std::string& buffer);
+
+    /// Returns the position after the markup (tag, comment, CDATA section,
+    /// processing instruction or declaration) that starts with the '<' at
+    /// begin, or npos if the markup is not complete in the buffer
+    static std::size_t findMarkupEnd(std::string const& buffer,
+                                     std::size_t begin);
+
+    /// Returns the position after the end tag of the element whose start tag
+    /// ends before pos, or npos if the element is not complete in the buffer
+    static std::size_t findElementEnd(std::string const& buffer,
+                                      std::size_t pos);
 
     /// Reads the stratigraphy of a borehole from an xml-file using the RapidXML
     /// parser
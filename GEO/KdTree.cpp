@@ -0,0 +1,188 @@
+/**
+ * \file KdTree.cpp
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include "KdTree.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+/// Orders point indices by one coordinate, ties by the index
+class CoordinateLess
+{
+public:
+    explicit CoordinateLess(std::vector<double> const& coord) : _coord(coord)
+    {
+    }
+    bool operator()(std::size_t a, std::size_t b) const
+    {
+        if (_coord[a] != _coord[b])
+            return _coord[a] < _coord[b];
+        return a < b;
+    }
+
+private:
+    std::vector<double> const& _coord;
+};
+}  // namespace
+
+namespace GEOLIB
+{
+KdTree::KdTree(std::vector<double> const& x, std::vector<double> const& y,
+               std::vector<double> const& z)
+    : _ids(x.size()), _coords(3 * x.size()), _split_dim(x.size(), 0)
+{
+    for (std::size_t i = 0; i < _ids.size(); i++)
+        _ids[i] = i;
+
+    std::vector<double> const* const coords[3] = {&x, &y, &z};
+    build(0, _ids.size(), coords);
+
+    for (std::size_t i = 0; i < _ids.size(); i++)
+    {
+        _coords[3 * i] = x[_ids[i]];
+        _coords[3 * i + 1] = y[_ids[i]];
+        _coords[3 * i + 2] = z[_ids[i]];
+    }
+}
+
+void KdTree::build(std::size_t begin, std::size_t end,
+                   std::vector<double> const* const* coords)
+{
+    while (end - begin > 1)
+    {
+        // split along the largest extent of the range
+        double extent = -1.0;
+        unsigned char dim = 0;
+        for (unsigned char d = 0; d < 3; d++)
+        {
+            std::vector<double> const& c = *coords[d];
+            double c_min = c[_ids[begin]], c_max = c_min;
+            for (std::size_t i = begin + 1; i < end; i++)
+            {
+                c_min = std::min(c_min, c[_ids[i]]);
+                c_max = std::max(c_max, c[_ids[i]]);
+            }
+            if (c_max - c_min > extent)
+            {
+                extent = c_max - c_min;
+                dim = d;
+            }
+        }
+
+        const std::size_t mid = begin + (end - begin) / 2;
+        std::nth_element(_ids.begin() + begin, _ids.begin() + mid,
+                         _ids.begin() + end, CoordinateLess(*coords[dim]));
+        _split_dim[mid] = dim;
+
+        build(begin, mid, coords);
+        begin = mid + 1;
+    }
+}
+
+double KdTree::sqrDist(double const* const pnt, std::size_t k) const
+{
+    double const* const c = &_coords[3 * k];
+    return (c[0] - pnt[0]) * (c[0] - pnt[0]) +
+           (c[1] - pnt[1]) * (c[1] - pnt[1]) +
+           (c[2] - pnt[2]) * (c[2] - pnt[2]);
+}
+
+std::size_t KdTree::getNearestPoint(double const* const pnt) const
+{
+    Neighbour best(std::numeric_limits<double>::max(),
+                   std::numeric_limits<std::size_t>::max());
+    searchNearest(pnt, 0, _ids.size(), best);
+    return best.second;
+}
+
+void KdTree::searchNearest(double const* const pnt, std::size_t begin,
+                           std::size_t end, Neighbour& best) const
+{
+    while (begin < end)
+    {
+        const std::size_t mid = begin + (end - begin) / 2;
+        const Neighbour candidate(sqrDist(pnt, mid), _ids[mid]);
+        if (candidate < best)
+            best = candidate;
+
+        const unsigned char dim = _split_dim[mid];
+        const double diff = pnt[dim] - _coords[3 * mid + dim];
+        if (diff < 0.0)
+        {
+            searchNearest(pnt, begin, mid, best);
+            begin = mid + 1;
+        }
+        else
+        {
+            searchNearest(pnt, mid + 1, end, best);
+            end = mid;
+        }
+        // points with the same distance are visited for the smaller index
+        if (diff * diff > best.first)
+            return;
+    }
+}
+
+void KdTree::getNearestPoints(double const* const pnt, std::size_t k,
+                              std::vector<std::size_t>& ids,
+                              std::vector<double>& sqr_dists) const
+{
+    std::vector<Neighbour> heap;
+    heap.reserve(k + 1);
+    if (k > 0)
+        searchNearest(pnt, 0, _ids.size(), k, heap);
+
+    std::sort_heap(heap.begin(), heap.end());
+    ids.resize(heap.size());
+    sqr_dists.resize(heap.size());
+    for (std::size_t i = 0; i < heap.size(); i++)
+    {
+        sqr_dists[i] = heap[i].first;
+        ids[i] = heap[i].second;
+    }
+}
+
+void KdTree::searchNearest(double const* const pnt, std::size_t begin,
+                           std::size_t end, std::size_t k,
+                           std::vector<Neighbour>& heap) const
+{
+    while (begin < end)
+    {
+        const std::size_t mid = begin + (end - begin) / 2;
+        const Neighbour candidate(sqrDist(pnt, mid), _ids[mid]);
+        if (heap.size() < k)
+        {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (candidate < heap.front())
+        {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+
+        const unsigned char dim = _split_dim[mid];
+        const double diff = pnt[dim] - _coords[3 * mid + dim];
+        const std::size_t near_begin = (diff < 0.0) ? begin : mid + 1;
+        const std::size_t near_end = (diff < 0.0) ? mid : end;
+        const std::size_t far_begin = (diff < 0.0) ? mid + 1 : begin;
+        const std::size_t far_end = (diff < 0.0) ? end : mid;
+
+        searchNearest(pnt, near_begin, near_end, k, heap);
+        if (heap.size() == k && diff * diff > heap.front().first)
+            return;
+        begin = far_begin;
+        end = far_end;
+    }
+}
+}  // end namespace GEOLIB
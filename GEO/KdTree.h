@@ -0,0 +1,79 @@
+/**
+ * \file KdTree.h
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#ifndef KDTREE_H_
+#define KDTREE_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace GEOLIB
+{
+/**
+ * \ingroup GEOLIB
+ *
+ * \brief Static k-d tree for nearest neighbour queries on a point set.
+ *
+ * The tree is balanced and stored implicitly: the point at the middle of a
+ * range splits the range along the coordinate with the largest extent. The
+ * coordinates are copied in tree order, so the tree does not refer to the
+ * input after construction. Queries are const and can be run in parallel.
+ */
+class KdTree
+{
+public:
+    /**
+     * Builds the tree of the points (x[i], y[i], z[i]). The vectors must
+     * have the same size.
+     */
+    KdTree(std::vector<double> const& x, std::vector<double> const& y,
+           std::vector<double> const& z);
+
+    std::size_t size() const { return _ids.size(); }
+    /**
+     * Returns the index of the point with the smallest distance to pnt. If
+     * several points have the smallest distance the one with the smallest
+     * index is returned. The tree must not be empty.
+     */
+    std::size_t getNearestPoint(double const* const pnt) const;
+
+    /**
+     * Searches the k points with the smallest distances to pnt. On return
+     * ids and sqr_dists hold the indices and the squared distances of the
+     * points, sorted by increasing distance. Less than k points are returned
+     * if the tree is smaller.
+     */
+    void getNearestPoints(double const* const pnt, std::size_t k,
+                          std::vector<std::size_t>& ids,
+                          std::vector<double>& sqr_dists) const;
+
+private:
+    typedef std::pair<double, std::size_t> Neighbour;
+
+    void build(std::size_t begin, std::size_t end,
+               std::vector<double> const* const* coords);
+    double sqrDist(double const* const pnt, std::size_t k) const;
+    void searchNearest(double const* const pnt, std::size_t begin,
+                       std::size_t end, Neighbour& best) const;
+    void searchNearest(double const* const pnt, std::size_t begin,
+                       std::size_t end, std::size_t k,
+                       std::vector<Neighbour>& heap) const;
+
+    /// Index of the input point at each tree position
+    std::vector<std::size_t> _ids;
+    /// Coordinates in tree order
+    std::vector<double> _coords;
+    /// Split coordinate at each tree position
+    std::vector<unsigned char> _split_dim;
+};
+}  // end namespace GEOLIB
+
+#endif /* KDTREE_H_ */
@@ -10,6 +10,9 @@
  *              http://www.opengeosys.org/project/license
  */
 
+#include <algorithm>
+#include <cmath>
+
 // GEOLIB
 #include "BruteForceClosestPair.h"
 #include "PointVec.h"
@@ -25,15 +28,17 @@ PointVec::PointVec(const std::string& name, std::vector<Point*>* points,
                    double rel_eps)
     : TemplateVec<Point>(name, points, name_id_map),
       _type(type),
-      _sqr_shortest_dist(std::numeric_limits<double>::max())
+      _sqr_shortest_dist(std::numeric_limits<double>::max()),
+      _hash_cell_size(1.0)
 {
     assert(_data_vec);
     size_t number_of_all_input_pnts(_data_vec->size());
 
     calculateAxisAlignedBoundingBox();
-    rel_eps *=
-        sqrt(MathLib::sqrDist(&(_aabb.getMinPoint()), &(_aabb.getMaxPoint())));
-    makePntsUnique(_data_vec, _pnt_id_map, rel_eps);
+    if (number_of_all_input_pnts > 0)
+        rel_eps *= sqrt(
+            MathLib::sqrDist(&(_aabb.getMinPoint()), &(_aabb.getMaxPoint())));
+    makePntsUnique(rel_eps);
 
     if (number_of_all_input_pnts - _data_vec->size() > 0)
         std::cerr << "WARNING: there are "
@@ -74,32 +79,27 @@ void PointVec::push_back(Point* pnt, std::string const* const name)
 
 size_t PointVec::uniqueInsert(Point* pnt)
 {
-    size_t n(_data_vec->size()), k;
-    const double eps(std::numeric_limits<double>::epsilon());
-    for (k = 0; k < n; k++)
-        if (fabs((*((*_data_vec)[k]))[0] - (*pnt)[0]) < eps &&
-            fabs((*((*_data_vec)[k]))[1] - (*pnt)[1]) < eps &&
-            fabs((*((*_data_vec)[k]))[2] - (*pnt)[2]) < eps)
-            break;
-
-    if (k == n)
+    const size_t n(_data_vec->size());
+    const size_t k(findPoint(*pnt, std::numeric_limits<double>::epsilon()));
+    if (k < n)
     {
-        _data_vec->push_back(pnt);
-        // update bounding box
-        _aabb.update(*((*_data_vec)[n]));
-        // update shortest distance
-        for (size_t i(0); i < n; i++)
-        {
-            double sqr_dist(MathLib::sqrDist((*_data_vec)[i], (*_data_vec)[n]));
-            if (sqr_dist < _sqr_shortest_dist)
-                _sqr_shortest_dist = sqr_dist;
-        }
-        return n;
+        delete pnt;
+        pnt = NULL;
+        return k;
     }
+    return insert(pnt);
+}
 
-    delete pnt;
-    pnt = NULL;
-    return k;
+size_t PointVec::insert(Point* pnt)
+{
+    const size_t n(_data_vec->size());
+    _data_vec->push_back(pnt);
+    // update bounding box
+    _aabb.update(*pnt);
+    insertIntoHash(n);
+    // the shortest distance is recalculated on demand
+    _sqr_shortest_dist = std::numeric_limits<double>::max();
+    return n;
 }
 
 std::vector<Point*>* PointVec::filterStations(
@@ -115,128 +115,164 @@ std::vector<Point*>* PointVec::filterStations(
 
 double PointVec::getShortestPointDistance() const
 {
+    if (_sqr_shortest_dist == std::numeric_limits<double>::max() &&
+        _data_vec->size() > 1)
+        calculateShortestDistance();
     return sqrt(_sqr_shortest_dist);
 }
 
-void PointVec::makePntsUnique(std::vector<GEOLIB::Point*>* pnt_vec,
-                              std::vector<size_t>& pnt_id_map, double eps)
+void PointVec::makePntsUnique(double eps)
 {
-    size_t n_pnts_in_file(pnt_vec->size());
-    std::vector<size_t> perm;
-    pnt_id_map.reserve(n_pnts_in_file);
-    for (size_t k(0); k < n_pnts_in_file; k++)
-    {
-        perm.push_back(k);
-        pnt_id_map.push_back(k);
-    }
-
-    // sort the points
-    Quicksort<GEOLIB::Point*>(*pnt_vec, 0, n_pnts_in_file, perm);
+    const size_t n_pnts_in_file(_data_vec->size());
+    _pnt_id_map.resize(n_pnts_in_file);
+    rebuildHash(n_pnts_in_file, 0);
 
-    // unfortunately quicksort is not stable -
-    // sort identical points by id - to make sorting stable
-    // determine intervals with identical points to resort for stability of
-    // sorting
-    std::vector<size_t> identical_pnts_interval;
-    bool identical(false);
-    for (size_t k = 0; k < n_pnts_in_file - 1; k++)
+    // keep the first occurrence of a point, the unique points are moved to
+    // the front of the vector
+    size_t n_unique(0);
+    for (size_t k(0); k < n_pnts_in_file; k++)
     {
-        if (fabs((*((*pnt_vec)[k + 1]))[0] - (*((*pnt_vec)[k]))[0]) < eps &&
-            fabs((*((*pnt_vec)[k + 1]))[1] - (*((*pnt_vec)[k]))[1]) < eps &&
-            fabs((*((*pnt_vec)[k + 1]))[2] - (*((*pnt_vec)[k]))[2]) < eps)
-        {
-            // points are identical, sort by id
-            if (!identical)
-                identical_pnts_interval.push_back(k);
-            identical = true;
-        }
-        else
+        Point* const pnt((*_data_vec)[k]);
+        // the hash contains the unique points found so far
+        const size_t id(findPoint(*pnt, eps));
+        if (id < n_unique)
         {
-            if (identical)
-                identical_pnts_interval.push_back(k + 1);
-            identical = false;
+            delete pnt;
+            _pnt_id_map[k] = id;
+            continue;
         }
+        (*_data_vec)[n_unique] = pnt;
+        insertIntoHash(n_unique);
+        _pnt_id_map[k] = n_unique;
+        n_unique++;
     }
-    if (identical)
-        identical_pnts_interval.push_back(n_pnts_in_file);
+    _data_vec->resize(n_unique);
+}
 
-    for (size_t i(0); i < identical_pnts_interval.size() / 2; i++)
-    {
-        // bubble sort by id
-        size_t beg(identical_pnts_interval[2 * i]);
-        size_t end(identical_pnts_interval[2 * i + 1]);
-        for (size_t j(beg); j < end; j++)
-            for (size_t k(beg); k < end - 1; k++)
-                if (perm[k] > perm[k + 1])
-                    std::swap(perm[k], perm[k + 1]);
-    }
+void PointVec::calculateShortestDistance() const
+{
+    size_t i, j;
+    BruteForceClosestPair(*_data_vec, i, j);
+    _sqr_shortest_dist = MathLib::sqrDist((*_data_vec)[i], (*_data_vec)[j]);
+}
 
-    // check if there are identical points
-    for (size_t k = 0; k < n_pnts_in_file - 1; k++)
-        if (fabs((*((*pnt_vec)[k + 1]))[0] - (*((*pnt_vec)[k]))[0]) < eps &&
-            fabs((*((*pnt_vec)[k + 1]))[1] - (*((*pnt_vec)[k]))[1]) < eps &&
-            fabs((*((*pnt_vec)[k + 1]))[2] - (*((*pnt_vec)[k]))[2]) < eps)
-            pnt_id_map[perm[k + 1]] = pnt_id_map[perm[k]];
+void PointVec::calculateAxisAlignedBoundingBox()
+{
+    const size_t n_pnts(_data_vec->size());
+    for (size_t i(0); i < n_pnts; i++)
+        _aabb.update(*(*_data_vec)[i]);
+}
 
-    // reverse permutation
-    Quicksort<GEOLIB::Point*>(perm, 0, n_pnts_in_file, *pnt_vec);
+size_t PointVec::findPoint(Point const& pnt, double eps) const
+{
+    const size_t n(_data_vec->size());
+    if (_hash_head.empty())
+        return n;
 
-    // remove the second, third, ... occurrence from vector
-    for (size_t k(0); k < n_pnts_in_file; k++)
-        if (pnt_id_map[k] < k)
-        {
-            delete (*pnt_vec)[k];
-            (*pnt_vec)[k] = NULL;
-        }
-    // remove NULL-ptr from vector
-    for (std::vector<GEOLIB::Point*>::iterator it(pnt_vec->begin());
-         it != pnt_vec->end();)
+    // all cells touched by the box of size eps around the point
+    double x[3];
+    long lower[3], upper[3];
+    for (size_t d(0); d < 3; d++)
+        x[d] = pnt[d] - eps;
+    getCell(x, lower);
+    for (size_t d(0); d < 3; d++)
+        x[d] = pnt[d] + eps;
+    getCell(x, upper);
+
+    // the first one of several identical points added by insert() is found
+    size_t found(n);
+    for (long i(lower[0]); i <= upper[0]; i++)
+        for (long j(lower[1]); j <= upper[1]; j++)
+            for (long k(lower[2]); k <= upper[2]; k++)
+            {
+                // buckets are shared by several cells
+                for (size_t id(_hash_head[getBucket(i, j, k)]); id < n;
+                     id = _hash_next[id])
+                {
+                    Point const& p(*(*_data_vec)[id]);
+                    if (id < found && fabs(p[0] - pnt[0]) < eps &&
+                        fabs(p[1] - pnt[1]) < eps && fabs(p[2] - pnt[2]) < eps)
+                        found = id;
+                }
+            }
+    return found;
+}
+
+void PointVec::insertIntoHash(size_t id)
+{
+    if (id >= _hash_head.size())
     {
-        if (*it == NULL)
-            it = pnt_vec->erase(it);
-        else
-            it++;
+        // the cell size is adapted to the current extension of the points
+        rebuildHash(2 * (id + 1), id + 1);
+        return;
     }
+    long cell[3];
+    getCell((*_data_vec)[id]->getData(), cell);
+    const size_t bucket(getBucket(cell[0], cell[1], cell[2]));
+    _hash_next.resize(id + 1);
+    _hash_next[id] = _hash_head[bucket];
+    _hash_head[bucket] = id;
+}
 
-    // renumber id-mapping
-    size_t cnt(0);
-    for (size_t k(0); k < n_pnts_in_file; k++)
+void PointVec::rebuildHash(size_t n_buckets, size_t n_pnts)
+{
+    size_t n(16);
+    while (n < n_buckets)
+        n *= 2;
+    _hash_head.assign(n, std::numeric_limits<size_t>::max());
+
+    // the bounding box contains all points of _data_vec, also those which
+    // are not hashed yet
+    double max_extent(0.0);
+    size_t dim(0);
+    for (size_t d(0); d < 3; d++)
     {
-        if (pnt_id_map[k] == k)  // point not removed, if necessary: id change
+        if (_data_vec->empty())
         {
-            pnt_id_map[k] = cnt;
-            cnt++;
+            _hash_origin[d] = 0.0;
+            continue;
         }
-        else
-            pnt_id_map[k] = pnt_id_map[pnt_id_map[k]];
+        _hash_origin[d] = _aabb.getMinPoint()[d];
+        const double extent(_aabb.getMaxPoint()[d] - _aabb.getMinPoint()[d]);
+        if (extent > 0.0)
+            dim++;
+        max_extent = std::max(max_extent, extent);
+    }
+    // about one point per cell, the cells of points in a plane or on a line
+    // are spread over the non-degenerate directions only
+    _hash_cell_size = 1.0;
+    if (dim > 0)
+        _hash_cell_size = max_extent / pow(static_cast<double>(n),
+                                           1.0 / static_cast<double>(dim));
+
+    _hash_next.resize(n_pnts);
+    for (size_t id(0); id < n_pnts; id++)
+    {
+        long cell[3];
+        getCell((*_data_vec)[id]->getData(), cell);
+        const size_t bucket(getBucket(cell[0], cell[1], cell[2]));
+        _hash_next[id] = _hash_head[bucket];
+        _hash_head[bucket] = id;
     }
-
-    // KR correct renumbering of indices
-    //	size_t cnt(0);
-    //	std::map<size_t, size_t> reg_ids;
-    //	for (size_t k(0); k < n_pnts_in_file; k++) {
-    //		if (pnt_id_map[k] == k) {
-    //			reg_ids.insert(std::pair<size_t, size_t>(k, cnt));
-    //			cnt++;
-    //		} else reg_ids.insert(std::pair<size_t, size_t>(k,
-    // reg_ids[pnt_id_map[k]]));
-    //	}
-    //	for (size_t k(0); k < n_pnts_in_file; k++)
-    //		pnt_id_map[k] = reg_ids[k];
 }
 
-void PointVec::calculateShortestDistance()
+void PointVec::getCell(double const* const x, long* const cell) const
 {
-    size_t i, j;
-    BruteForceClosestPair(*_data_vec, i, j);
-    _sqr_shortest_dist = MathLib::sqrDist((*_data_vec)[i], (*_data_vec)[j]);
+    // limit the cell index to cope with points far away from the origin
+    const double max_cell(1e9);
+    for (size_t d(0); d < 3; d++)
+    {
+        const double c(floor((x[d] - _hash_origin[d]) / _hash_cell_size));
+        cell[d] = static_cast<long>(std::max(-max_cell, std::min(c, max_cell)));
+    }
 }
 
-void PointVec::calculateAxisAlignedBoundingBox()
+size_t PointVec::getBucket(long i, long j, long k) const
 {
-    const size_t n_pnts(_data_vec->size());
-    for (size_t i(0); i < n_pnts; i++)
-        _aabb.update(*(*_data_vec)[i]);
+    return ((static_cast<size_t>(i) * 73856093) ^
+            (static_cast<size_t>(j) * 19349663) ^
+            (static_cast<size_t>(k) * 83492791)) &
+           (_hash_head.size() - 1);
 }
 
 std::vector<GEOLIB::Point*>* PointVec::getSubset(
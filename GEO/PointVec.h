@@ -114,10 +114,32 @@ public:
     /// specified in "subset" as PointWithID-objects
     std::vector<GEOLIB::Point*>* getSubset(const std::vector<size_t>& subset);
 
+    /**
+     * Adds the point to the vector if there is no identical point yet,
+     * otherwise the point is destroyed. In contrast to push_back() no entry
+     * is appended to the id map, i.e. the method is intended for points
+     * without an id of their own, e.g. the points of TIN surfaces.
+     * @param pnt the pointer to the Point, PointVec takes ownership
+     * @return the id of the point within the internal vector
+     */
+    size_t uniqueInsert(Point* pnt);
+
+    /**
+     * Appends the point to the vector even if there is an identical point,
+     * e.g. a point closing a polyline which has to keep an id of its own.
+     * As uniqueInsert() the method appends no entry to the id map.
+     * @param pnt the pointer to the Point, PointVec takes ownership
+     * @return the id of the point within the internal vector
+     */
+    size_t insert(Point* pnt);
+
 private:
-    void makePntsUnique(std::vector<GEOLIB::Point*>* pnt_vec,
-                        std::vector<size_t>& pnt_id_map,
-                        double eps = sqrt(std::numeric_limits<double>::min()));
+    /**
+     * Removes the identical points from the internal vector and sets up the
+     * id map and the spatial hash of the points. Two points are identical
+     * iff their coordinates differ by less than eps.
+     */
+    void makePntsUnique(double eps = sqrt(std::numeric_limits<double>::min()));
 
     /** copy constructor doesn't have an implementation */
     // compiler does not create a (possible unwanted) copy constructor
@@ -131,8 +153,6 @@ private:
     // operator
     PointVec& operator=(const PointVec& rhs);
 
-    size_t uniqueInsert(Point* pnt);
-
     /** the type of the point (\sa enum PointType) */
     PointType _type;
 
@@ -145,15 +165,40 @@ private:
     /**
      * method calculates the shortest distance of points inside the _pnt_vec
      */
-    void calculateShortestDistance();
+    void calculateShortestDistance() const;
     /**
-     * squared shortest distance - calculated by
-     * calculateShortestAndLargestDistance, possible update by uniqueInsert
+     * squared shortest distance - calculated on demand by
+     * calculateShortestDistance, reset by uniqueInsert
      */
-    double _sqr_shortest_dist;
+    mutable double _sqr_shortest_dist;
 
     void calculateAxisAlignedBoundingBox();
     AABB _aabb;
+
+    /**
+     * Searches a point within the distance eps (in every coordinate) of pnt.
+     * @return the smallest id of such a point or _data_vec->size() if there
+     * is none
+     */
+    size_t findPoint(Point const& pnt, double eps) const;
+    /// Enters the point with the given id into the spatial hash, which is
+    /// enlarged if the number of points exceeds the number of buckets.
+    void insertIntoHash(size_t id);
+    /// Sets up the hash with at least n_buckets buckets for the first n_pnts
+    /// points.
+    void rebuildHash(size_t n_buckets, size_t n_pnts);
+    size_t getBucket(long i, long j, long k) const;
+    void getCell(double const* const x, long* const cell) const;
+
+    /**
+     * Spatial hash of the points: the points are sorted into cells of size
+     * _hash_cell_size, which are mapped to the buckets. The points of a
+     * bucket are linked by _hash_next.
+     */
+    std::vector<size_t> _hash_head;
+    std::vector<size_t> _hash_next;
+    double _hash_origin[3];
+    double _hash_cell_size;
 };
 }  // namespace GEOLIB
 
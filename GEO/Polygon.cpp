@@ -10,6 +10,7 @@
  *              http://www.opengeosys.org/project/license
  */
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>  // for exit
 
@@ -30,13 +31,17 @@
 
 namespace GEOLIB
 {
-Polygon::Polygon(const Polyline& ply, bool init) : Polyline(ply)
+Polygon::Polygon(const Polyline& ply, bool init)
+    : Polyline(ply), _edge_bucket_y_min(0.0), _edge_bucket_dy(0.0)
 {
     if (init)
         initialise();
 }
 
-Polygon::Polygon(const std::vector<Point*>& pnt_vec) : Polyline(pnt_vec) {}
+Polygon::Polygon(const std::vector<Point*>& pnt_vec)
+    : Polyline(pnt_vec), _edge_bucket_y_min(0.0), _edge_bucket_dy(0.0)
+{
+}
 
 Polygon::~Polygon()
 {
@@ -80,22 +85,36 @@ bool Polygon::isPntInPolygon(GEOLIB::Point const& pnt) const
 
     if (_simple_polygon_list.empty())
     {
-        const size_t n_nodes(getNumberOfPoints() - 1);
-        for (size_t k(0); k < n_nodes; k++)
+        if (_edge_bucket_ptr.empty())
         {
-            if (((*(getPoint(k)))[1] <= pnt[1] &&
-                 pnt[1] <= (*(getPoint(k + 1)))[1]) ||
-                ((*(getPoint(k + 1)))[1] <= pnt[1] &&
-                 pnt[1] <= (*(getPoint(k)))[1]))
+            const size_t n_nodes(getNumberOfPoints() - 1);
+            for (size_t k(0); k < n_nodes; k++)
             {
-                switch (getEdgeType(k, pnt))
+                switch (getOverlappingEdgeType(k, pnt))
                 {
                     case EdgeType::TOUCHING:
                         return true;
                     case EdgeType::CROSSING:
                         n_intersections++;
                         break;
-                    case EdgeType::INESSENTIAL:
+                    default:
+                        // do nothing
+                        ;
+                }
+            }
+        }
+        else
+        {
+            const size_t bucket(getEdgeBucket(pnt[1]));
+            const size_t end(_edge_bucket_ptr[bucket + 1]);
+            for (size_t i(_edge_bucket_ptr[bucket]); i < end; i++)
+            {
+                switch (getOverlappingEdgeType(_edge_bucket_ids[i], pnt))
+                {
+                    case EdgeType::TOUCHING:
+                        return true;
+                    case EdgeType::CROSSING:
+                        n_intersections++;
                         break;
                     default:
                         // do nothing
@@ -127,6 +146,99 @@ bool Polygon::isPntInPolygon(double x, double y, double z) const
     return isPntInPolygon(pnt);
 }
 
+void Polygon::getPntsInPolygon(std::vector<double const*> const& pnts,
+                               std::vector<size_t>& pnt_ids) const
+{
+    buildEdgeBuckets();
+
+    const long n_pnts(static_cast<long>(pnts.size()));
+    std::vector<char> is_inside(pnts.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long k = 0; k < n_pnts; k++)
+    {
+        if (isPntInPolygon(GEOLIB::Point(pnts[k])))
+            is_inside[k] = 1;
+    }
+
+    for (size_t k(0); k < pnts.size(); k++)
+    {
+        if (is_inside[k])
+            pnt_ids.push_back(k);
+    }
+}
+
+void Polygon::buildEdgeBuckets() const
+{
+    for (std::list<Polygon*>::const_iterator it(_simple_polygon_list.begin());
+         it != _simple_polygon_list.end();
+         ++it)
+    {
+        if (*it != this)
+            (*it)->buildEdgeBuckets();
+    }
+
+    if (!_edge_bucket_ptr.empty() || getNumberOfPoints() < 2)
+        return;
+
+    const size_t n_edges(getNumberOfPoints() - 1);
+    _edge_bucket_y_min = _aabb.getMinPoint()[1];
+    const double height(_aabb.getMaxPoint()[1] - _edge_bucket_y_min);
+
+    // One slab per edge, unless the edges are so long in y direction that
+    // the buckets would hold more than a few entries per edge.
+    double sum_edge_heights(0.0);
+    for (size_t k(0); k < n_edges; k++)
+        sum_edge_heights +=
+            fabs((*(getPoint(k + 1)))[1] - (*(getPoint(k)))[1]);
+    size_t n_buckets(n_edges);
+    if (height <= 0.0)
+        n_buckets = 1;
+    else if (sum_edge_heights > 8.0 * height)
+        n_buckets = std::max(
+            static_cast<size_t>(8.0 * n_edges * height / sum_edge_heights),
+            static_cast<size_t>(1));
+    _edge_bucket_dy = (height > 0.0) ? height / n_buckets : 1.0;
+
+    // Count the edges of each slab, then fill the slabs. An edge is stored
+    // in all slabs overlapping with its y range, such that the slab of a
+    // point contains every edge that getOverlappingEdgeType() accepts.
+    _edge_bucket_ptr.assign(n_buckets + 1, 0);
+    for (size_t k(0); k < n_edges; k++)
+    {
+        const double y0((*(getPoint(k)))[1]);
+        const double y1((*(getPoint(k + 1)))[1]);
+        const size_t end(getEdgeBucket(std::max(y0, y1)));
+        for (size_t i(getEdgeBucket(std::min(y0, y1))); i <= end; i++)
+            _edge_bucket_ptr[i + 1]++;
+    }
+    for (size_t i(0); i < n_buckets; i++)
+        _edge_bucket_ptr[i + 1] += _edge_bucket_ptr[i];
+
+    _edge_bucket_ids.resize(_edge_bucket_ptr[n_buckets]);
+    std::vector<size_t> pos(_edge_bucket_ptr.begin(),
+                            _edge_bucket_ptr.end() - 1);
+    for (size_t k(0); k < n_edges; k++)
+    {
+        const double y0((*(getPoint(k)))[1]);
+        const double y1((*(getPoint(k + 1)))[1]);
+        const size_t end(getEdgeBucket(std::max(y0, y1)));
+        for (size_t i(getEdgeBucket(std::min(y0, y1))); i <= end; i++)
+            _edge_bucket_ids[pos[i]++] = k;
+    }
+}
+
+size_t Polygon::getEdgeBucket(double y) const
+{
+    if (!(y > _edge_bucket_y_min))
+        return 0;
+    const size_t bucket(
+        static_cast<size_t>((y - _edge_bucket_y_min) / _edge_bucket_dy));
+    const size_t n_buckets(_edge_bucket_ptr.size() - 1);
+    return (bucket < n_buckets) ? bucket : n_buckets - 1;
+}
+
 bool Polygon::isPolylineInPolygon(const Polyline& ply) const
 {
     size_t ply_size(ply.getNumberOfPoints()), cnt(0);
@@ -240,6 +352,15 @@ void Polygon::computeListOfSimplePolygons()
         (*it)->initialise();
 }
 
+EdgeType::value Polygon::getOverlappingEdgeType(size_t k,
+                                                GEOLIB::Point const& pnt) const
+{
+    if (((*(getPoint(k)))[1] <= pnt[1] && pnt[1] <= (*(getPoint(k + 1)))[1]) ||
+        ((*(getPoint(k + 1)))[1] <= pnt[1] && pnt[1] <= (*(getPoint(k)))[1]))
+        return getEdgeType(k, pnt);
+    return EdgeType::INESSENTIAL;
+}
+
 EdgeType::value Polygon::getEdgeType(size_t k, GEOLIB::Point const& pnt) const
 {
     switch (getLocationOfPoint(k, pnt))
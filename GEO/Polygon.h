@@ -15,6 +15,7 @@
 
 // STL
 #include <list>
+#include <vector>
 
 // GEOLIB
 #include "AxisAlignedBoundingBox.h"
@@ -80,6 +81,18 @@ public:
      * @return if point is inside the polygon true, else false
      */
     bool isPntInPolygon(double x, double y, double z) const;
+    /**
+     * Method checks which points of the given point array are inside the
+     * polygon. The result is identical to calling isPntInPolygon() for each
+     * point, but the edges of the polygon are bucketed into horizontal slabs
+     * beforehand, such that only the edges of the slab containing a point
+     * are tested. The points are classified in parallel if OpenMP is used.
+     * @param pnts coordinates of the points, e.g. the data of mesh nodes
+     * @param pnt_ids (output) the indices (in ascending order) of the points
+     * that are inside the polygon
+     */
+    void getPntsInPolygon(std::vector<double const*> const& pnts,
+                          std::vector<size_t>& pnt_ids) const;
     /**
      * Method checks if all points of the polyline ply are inside of the
      * polygon.
@@ -126,6 +139,23 @@ private:
      */
     EdgeType::value getEdgeType(size_t k, GEOLIB::Point const& pnt) const;
 
+    /**
+     * get the type of edge k with respect to the given point, if the edge
+     * overlaps with the point in y direction.
+     * @return a value of enum EdgeType, INESSENTIAL if there is no overlap
+     */
+    EdgeType::value getOverlappingEdgeType(size_t k,
+                                           GEOLIB::Point const& pnt) const;
+
+    /**
+     * Builds the y-slab edge buckets of this polygon and of its simple
+     * polygons. Once built, they are used by isPntInPolygon().
+     */
+    void buildEdgeBuckets() const;
+
+    /// Index of the y-slab that contains the given y coordinate.
+    size_t getEdgeBucket(double y) const;
+
     void calculateAxisAlignedBoundingBox();
     void ensureCWOrientation();
 
@@ -133,6 +163,13 @@ private:
     void splitPolygonAtPoint(std::list<Polygon*>::iterator polygon_it);
     std::list<Polygon*> _simple_polygon_list;
     AABB _aabb;
+
+    /// Edge ids of slab i are _edge_bucket_ids[_edge_bucket_ptr[i]] to
+    /// _edge_bucket_ids[_edge_bucket_ptr[i+1]-1].
+    mutable std::vector<size_t> _edge_bucket_ptr;
+    mutable std::vector<size_t> _edge_bucket_ids;
+    mutable double _edge_bucket_y_min;
+    mutable double _edge_bucket_dy;
 };
 
 /**
@@ -97,9 +97,8 @@ CElem::CElem() : CCore(0), normal_vector(NULL)
 CElem::CElem(size_t Index, CElem* onwer, int Face)
     : CCore(Index), normal_vector(NULL), owner(onwer)
 {
-    int i, j, k, n, ne;
+    int i, n;
     int faceIndex_loc[10];
-    int edgeIndex_loc[10] = {};
     no_faces_on_surface = 0;
     n = owner->GetElementFaceNodes(Face, faceIndex_loc);
     face_index = Face;
@@ -156,15 +155,37 @@ CElem::CElem(size_t Index, CElem* onwer, int Face)
             (nodes[i]->GetBoundaryType() != '1'))
             nodes[i]->SetBoundaryType('B');
     }
-    // Face edges
-    ne = owner->GetEdgesNumber();
+    SetFaceEdges();
+
+#if defined(USE_PETSC)  // || defined(using other parallel scheme). WW
+    g_index = NULL;
+#endif
+}
+
+/**************************************************************************
+   MSHLib-Method:
+   Task: Link the edges of a surface face to the edges of its owner
+   Programing:
+   11/2018 Implementation (taken from the face constructor)
+**************************************************************************/
+void CElem::SetFaceEdges()
+{
+    int faceIndex_loc[10];
+    int edgeIndex_loc[10] = {};
+    // Faces are linear as the mesh might be quadratic already
+    const bool quad = owner->GetOrder();
+    owner->SetOrder(false);
+    owner->GetElementFaceNodes(face_index, faceIndex_loc);
+    owner->SetOrder(quad);
+
+    const int ne = owner->GetEdgesNumber();
     edges.resize(nnodes);
     edges_orientation.resize(nnodes);
     edges_orientation = 1;
-    for (i = 0; i < nnodes; i++)
+    for (int i = 0; i < nnodes; i++)
     {
-        k = (i + 1) % nnodes;
-        for (j = 0; j < ne; j++)
+        const int k = (i + 1) % nnodes;
+        for (int j = 0; j < ne; j++)
         {
             owner->GetLocalIndicesOfEdgeNodes(j, edgeIndex_loc);
             if ((faceIndex_loc[i] == edgeIndex_loc[0] &&
@@ -181,10 +202,6 @@ CElem::CElem(size_t Index, CElem* onwer, int Face)
             }
         }
     }
-
-#if defined(USE_PETSC)  // || defined(using other parallel scheme). WW
-    g_index = NULL;
-#endif
 }
 
 /**************************************************************************
@@ -821,6 +838,11 @@ void CElem::InitializeMembers()
     neighbors.resize(nfaces);
     for (size_t i = 0; i < nfaces; i++)
         neighbors[i] = NULL;
+    InitializeEdges();
+}
+
+void CElem::InitializeEdges()
+{
     edges.resize(nedges);
     edges_orientation.resize(nedges);
     for (size_t i = 0; i < nedges; i++)
@@ -927,9 +949,11 @@ void CElem::MarkingAll(bool makop)
     for (int i = 0; i < SizeV; i++)
         nodes[i]->SetMark(makop);
 
+    // Edges are constructed on demand
     size_t nedg = edges.Size();
     for (size_t i = 0; i < nedg; i++)
-        edges[i]->SetMark(makop);
+        if (edges[i])
+            edges[i]->SetMark(makop);
 }
 /**************************************************************************
    MSHLib-Method:
@@ -8,6 +8,7 @@
 #ifndef msh_elem_INC
 #define msh_elem_INC
 
+#include <cassert>
 #include <iostream>
 #include <string>
 
@@ -192,6 +193,7 @@ public:
     CElem* GetOwner() const { return owner; }             // YD
     // Initialize topological properties
     void InitializeMembers();
+    void InitializeEdges();
     //------------------------------------------------------------------
     // Edges
     void GetEdges(Math_Group::vec<CEdge*>& ele_edges)
@@ -217,6 +219,8 @@ public:
         edges.resize(0);
         edges_orientation.resize(0);
     }
+    /// Links the edges of a surface face to the edges of its owner
+    void SetFaceEdges();
     void GetLocalIndicesOfEdgeNodes(const int Edge, int* EdgeNodes);
     size_t GetEdgesNumber() const { return nedges; }
     //------------------------------------------------------------------
@@ -244,7 +248,13 @@ public:
         for (size_t i = 0; i < nfaces; i++)
             ele_neighbors[i] = neighbors[i];
     }
-    CElem* GetNeighbor(int index) { return neighbors[index]; }
+    /// The neighbors on the domain surface are the surface faces, which
+    /// exist after CFEMesh::ConstructFaces() only.
+    CElem* GetNeighbor(int index)
+    {
+        assert(neighbors[index] != NULL || geo_type == MshElemType::LINE);
+        return neighbors[index];
+    }
     //------------------------------------------------------------------
     /// Coordinates transform
     ///  \param recompute_matrix, an indicator to determine whether the
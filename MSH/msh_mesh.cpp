@@ -141,6 +141,8 @@ CFEMesh::CFEMesh(GEOLIB::GEOObjects* geo_obj, std::string* geo_name)
       _msh_n_pyras(0),
       _min_edge_length(1e-3),
       _search_length(0.0),
+      _edges_constructed(false),
+      _faces_constructed(false),
       NodesNumber_Linear(0),
       NodesNumber_Quadratic(0),
       useQuadratic(false),
@@ -168,7 +170,11 @@ CFEMesh::CFEMesh(GEOLIB::GEOObjects* geo_obj, std::string* geo_name)
 // Copy-Constructor for CFEMeshes.
 // Programming: 2010/11/10 KR
 CFEMesh::CFEMesh(CFEMesh const& old_mesh)
-    : PT(NULL), _search_length(old_mesh._search_length), _mesh_grid(NULL)
+    : PT(NULL),
+      _search_length(old_mesh._search_length),
+      _edges_constructed(false),
+      _faces_constructed(false),
+      _mesh_grid(NULL)
 {
     std::cout << "Copying mesh object ... ";
 
@@ -329,15 +335,21 @@ double CFEMesh::getMinEdgeLength() const
 
 void CFEMesh::computeMinEdgeLength()
 {
-    const size_t s_edge_vec(edge_vector.size());
-    if (s_edge_vec > 0)
-    {
-        _min_edge_length = edge_vector[0]->getLength();
-        for (size_t k(1); k < s_edge_vec; k++)
-        {
-            const double kth_edge_length(edge_vector[k]->getLength());
-            if (kth_edge_length < _min_edge_length)
+    // Local edges of the elements, so that the edges need not be constructed
+    bool found = false;
+    int edge_nodes[2];
+    for (size_t e = 0; e < ele_vector.size(); e++)
+    {
+        CElem* const elem(ele_vector[e]);
+        for (size_t i = 0; i < elem->GetEdgesNumber(); i++)
+        {
+            elem->GetLocalIndicesOfEdgeNodes(i, edge_nodes);
+            const double kth_edge_length(
+                sqrt(MathLib::sqrDist(elem->GetNode(edge_nodes[0])->getData(),
+                                      elem->GetNode(edge_nodes[1])->getData())));
+            if (!found || kth_edge_length < _min_edge_length)
                 _min_edge_length = kth_edge_length;
+            found = true;
         }
     }
 }
@@ -540,21 +552,17 @@ void CFEMesh::ConstructGrid()
     bool done;
 
     Math_Group::vec<CNode*> e_nodes0(20);
-    Math_Group::vec<int> Edge_Orientation(15);
-    Math_Group::vec<CEdge*> Edges(15);
-    Math_Group::vec<CEdge*> Edges0(15);
     Math_Group::vec<CElem*> Neighbors(15);
     Math_Group::vec<CElem*> Neighbors0(15);
 
-    Math_Group::vec<CNode*> e_edgeNodes0(3);
-    Math_Group::vec<CNode*> e_edgeNodes(3);
-
 #if !defined( \
     USE_PETSC)  // &&! defined(USE_OTHER Parallel solver lib) //WW 06.2013
     NodesNumber_Linear = nod_vector.size();
 #endif
 
-    Edge_Orientation = 1;
+    // Edges and surface faces are constructed on demand
+    _edges_constructed = false;
+    _faces_constructed = false;
 
     // Set neighbors of node
     ConnectedElements2Node();
@@ -681,87 +689,9 @@ void CFEMesh::ConstructGrid()
         }
         // --------------------------------
 
-        // Edges
-        size_t nedges0(elem->GetEdgesNumber());
-        elem->GetEdges(Edges0);
-        for (size_t i = 0; i < nedges0; i++)  // edges
-        {
-            int edgeIndex_loc0[2];
-            elem->GetLocalIndicesOfEdgeNodes(i, edgeIndex_loc0);
-            // Check neighbors
-            done = false;
-            for (size_t k = 0; k < 2; k++)  // beginning and end of edge
-            {
-                size_t nConnElem(e_nodes0[edgeIndex_loc0[k]]
-                                     ->getConnectedElementIDs()
-                                     .size());
-                for (size_t ei = 0; ei < nConnElem;
-                     ei++)  // elements connected to edge node
-                {
-                    size_t ee(e_nodes0[edgeIndex_loc0[k]]
-                                  ->getConnectedElementIDs()[ei]);
-                    if (ee == e)
-                        continue;
-                    CElem* connElem(ele_vector[ee]);
-                    const Math_Group::vec<long>& node_index_glb(
-                        connElem->GetNodeIndeces());
-                    size_t nedges(connElem->GetEdgesNumber());
-                    connElem->GetEdges(Edges);
-                    // Edges of neighbors
-                    int edgeIndex_loc[2];
-                    for (size_t ii = 0; ii < nedges;
-                         ii++)  // edges of element connected to edge node
-                    {
-                        connElem->GetLocalIndicesOfEdgeNodes(ii, edgeIndex_loc);
-
-                        if ((node_index[edgeIndex_loc0[0]] ==
-                                 node_index_glb[edgeIndex_loc[0]] &&
-                             node_index[edgeIndex_loc0[1]] ==
-                                 node_index_glb[edgeIndex_loc[1]]) ||
-                            (node_index[edgeIndex_loc0[0]] ==
-                                 node_index_glb[edgeIndex_loc[1]] &&
-                             node_index[edgeIndex_loc0[1]] ==
-                                 node_index_glb
-                                     [edgeIndex_loc[0]]))  // check if elements
-                                                           // share edge
-
-                            if (Edges[ii])
-                            {
-                                Edges0[i] = Edges[ii];
-                                Edges[ii]->GetNodes(e_edgeNodes);
-                                if ((size_t)node_index[edgeIndex_loc0[0]] ==
-                                        e_edgeNodes[1]->GetIndex() &&
-                                    (size_t)node_index[edgeIndex_loc0[1]] ==
-                                        e_edgeNodes[0]
-                                            ->GetIndex())  // check direction of
-                                                           // edge
-                                    Edge_Orientation[i] = -1;
-                                done = true;
-                                break;
-                            }
-                    }  //  for(ii=0; ii<nedges; ii++)
-                    if (done)
-                        break;
-                }  // for(ei=0; ei<e_size_l; ei++)
-                if (done)
-                    break;
-            }           // for(k=0;k<2;k++)
-            if (!done)  // new edges and new node
-            {
-                Edges0[i] = new CEdge((long)edge_vector.size());
-                Edges0[i]->SetOrder(false);
-                e_edgeNodes0[0] = e_nodes0[edgeIndex_loc0[0]];
-                e_edgeNodes0[1] = e_nodes0[edgeIndex_loc0[1]];
-                e_edgeNodes0[2] = NULL;
-                Edges0[i]->SetNodes(e_edgeNodes0);
-                edge_vector.push_back(Edges0[i]);
-            }  // new edges
-        }      //  for(i=0; i<nedges0; i++)
         //
-        // Set edges and nodes
+        // Set nodes
         elem->SetOrder(false);
-        elem->SetEdgesOrientation(Edge_Orientation);
-        elem->SetEdges(Edges0);
         // Resize is true
         elem->SetNodes(e_nodes0, true);
     }  // Over elements
@@ -807,26 +737,6 @@ void CFEMesh::ConstructGrid()
         // Compute volume meanwhile
         elem->ComputeVolume();
 
-        if (elem->GetElementType() == MshElemType::LINE)
-            continue;  // line element
-        //		thisElem0->GetNodeIndeces(node_index_glb0);
-        //		const vec<long>& node_index_glb0 (thisElem0->GetNodeIndeces());
-        //// compiler said: unused variable // TF
-        elem->GetNeighbors(Neighbors0);
-        size_t m0 = elem->GetFacesNumber();
-
-        // Check face on surface
-        for (size_t i = 0; i < m0; i++)  // Faces
-        {
-            if (Neighbors0[i])
-                continue;
-            CElem* newFace = new CElem((long)face_vector.size(), elem, i);
-            //          thisElem0->boundary_type='B';
-            elem->no_faces_on_surface++;
-            face_vector.push_back(newFace);
-            Neighbors0[i] = newFace;
-        }
-        elem->SetNeighbors(Neighbors0);
     }
 #if !defined( \
     USE_PETSC)  // &&! defined(USE_OTHER Parallel solver lib) //WW 06.2013
@@ -932,13 +842,8 @@ void CFEMesh::ConstructGrid()
     e_nodes0.resize(0);
     //	node_index_glb.resize(0);
     //	node_index_glb0.resize(0);
-    Edge_Orientation.resize(0);
-    Edges.resize(0);
-    Edges0.resize(0);
     Neighbors.resize(0);
     Neighbors0.resize(0);
-    e_edgeNodes0.resize(0);
-    e_edgeNodes.resize(0);
     std::cout << " done."
               << "\n";
 
@@ -948,6 +853,165 @@ void CFEMesh::ConstructGrid()
     constructMeshGrid();
 }
 
+/**************************************************************************
+   MSHLib-Method:
+   Task: Construct the element edges, which are needed by quadratic elements,
+         edge integrals and some element length measures. Called on demand.
+**************************************************************************/
+void CFEMesh::ConstructEdges()
+{
+    if (_edges_constructed)
+        return;
+    _edges_constructed = true;
+
+    bool done;
+    Math_Group::vec<CNode*> e_nodes0(20);
+    Math_Group::vec<int> Edge_Orientation(15);
+    Math_Group::vec<CEdge*> Edges(15);
+    Math_Group::vec<CEdge*> Edges0(15);
+    Math_Group::vec<CNode*> e_edgeNodes0(3);
+    Math_Group::vec<CNode*> e_edgeNodes(3);
+
+    Edge_Orientation = 1;
+
+    const size_t e_size(ele_vector.size());
+    for (size_t e = 0; e < e_size; e++)
+        ele_vector[e]->InitializeEdges();
+
+    for (size_t e = 0; e < e_size; e++)
+    {
+        CElem* elem(ele_vector[e]);
+        const Math_Group::vec<long>& node_index(elem->GetNodeIndeces());
+        for (size_t i = 0; i < static_cast<size_t>(elem->nnodes); i++)
+            e_nodes0[i] = nod_vector[node_index[i]];
+
+        // Edges
+        size_t nedges0(elem->GetEdgesNumber());
+        elem->GetEdges(Edges0);
+        for (size_t i = 0; i < nedges0; i++)  // edges
+        {
+            int edgeIndex_loc0[2];
+            elem->GetLocalIndicesOfEdgeNodes(i, edgeIndex_loc0);
+            // Check neighbors
+            done = false;
+            for (size_t k = 0; k < 2; k++)  // beginning and end of edge
+            {
+                size_t nConnElem(e_nodes0[edgeIndex_loc0[k]]
+                                     ->getConnectedElementIDs()
+                                     .size());
+                for (size_t ei = 0; ei < nConnElem;
+                     ei++)  // elements connected to edge node
+                {
+                    size_t ee(e_nodes0[edgeIndex_loc0[k]]
+                                  ->getConnectedElementIDs()[ei]);
+                    if (ee == e)
+                        continue;
+                    CElem* connElem(ele_vector[ee]);
+                    const Math_Group::vec<long>& node_index_glb(
+                        connElem->GetNodeIndeces());
+                    size_t nedges(connElem->GetEdgesNumber());
+                    connElem->GetEdges(Edges);
+                    // Edges of neighbors
+                    int edgeIndex_loc[2];
+                    for (size_t ii = 0; ii < nedges;
+                         ii++)  // edges of element connected to edge node
+                    {
+                        connElem->GetLocalIndicesOfEdgeNodes(ii, edgeIndex_loc);
+
+                        if ((node_index[edgeIndex_loc0[0]] ==
+                                 node_index_glb[edgeIndex_loc[0]] &&
+                             node_index[edgeIndex_loc0[1]] ==
+                                 node_index_glb[edgeIndex_loc[1]]) ||
+                            (node_index[edgeIndex_loc0[0]] ==
+                                 node_index_glb[edgeIndex_loc[1]] &&
+                             node_index[edgeIndex_loc0[1]] ==
+                                 node_index_glb
+                                     [edgeIndex_loc[0]]))  // check if elements
+                                                           // share edge
+
+                            if (Edges[ii])
+                            {
+                                Edges0[i] = Edges[ii];
+                                Edges[ii]->GetNodes(e_edgeNodes);
+                                if ((size_t)node_index[edgeIndex_loc0[0]] ==
+                                        e_edgeNodes[1]->GetIndex() &&
+                                    (size_t)node_index[edgeIndex_loc0[1]] ==
+                                        e_edgeNodes[0]
+                                            ->GetIndex())  // check direction of
+                                                           // edge
+                                    Edge_Orientation[i] = -1;
+                                done = true;
+                                break;
+                            }
+                    }  //  for(ii=0; ii<nedges; ii++)
+                    if (done)
+                        break;
+                }  // for(ei=0; ei<e_size_l; ei++)
+                if (done)
+                    break;
+            }           // for(k=0;k<2;k++)
+            if (!done)  // new edges and new node
+            {
+                Edges0[i] = new CEdge((long)edge_vector.size());
+                Edges0[i]->SetOrder(false);
+                e_edgeNodes0[0] = e_nodes0[edgeIndex_loc0[0]];
+                e_edgeNodes0[1] = e_nodes0[edgeIndex_loc0[1]];
+                e_edgeNodes0[2] = NULL;
+                Edges0[i]->SetNodes(e_edgeNodes0);
+                edge_vector.push_back(Edges0[i]);
+            }  // new edges
+        }      //  for(i=0; i<nedges0; i++)
+
+        elem->SetEdgesOrientation(Edge_Orientation);
+        elem->SetEdges(Edges0);
+    }  // Over elements
+}
+
+/**************************************************************************
+   MSHLib-Method:
+   Task: Construct the faces on the domain surface, which are needed by face
+         integrals and surface fluxes. Called on demand.
+**************************************************************************/
+void CFEMesh::ConstructFaces()
+{
+    if (_faces_constructed)
+        return;
+    // Faces refer to the edges of their owner
+    ConstructEdges();
+    _faces_constructed = true;
+    // Faces kept after FreeEdgeMemory get the rebuilt edges
+    for (size_t i = 0; i < face_vector.size(); i++)
+        face_vector[i]->SetFaceEdges();
+
+    Math_Group::vec<CElem*> Neighbors0(15);
+    const size_t e_size(ele_vector.size());
+    for (size_t e = 0; e < e_size; e++)
+    {
+        CElem* elem(ele_vector[e]);
+        if (elem->GetElementType() == MshElemType::LINE)
+            continue;  // line element
+        elem->GetNeighbors(Neighbors0);
+        size_t m0 = elem->GetFacesNumber();
+
+        // Faces are linear as the mesh might be quadratic already
+        const bool quadratic = elem->GetOrder();
+        elem->SetOrder(false);
+        // Check face on surface
+        for (size_t i = 0; i < m0; i++)  // Faces
+        {
+            if (Neighbors0[i])
+                continue;
+            CElem* newFace = new CElem((long)face_vector.size(), elem, i);
+            //          thisElem0->boundary_type='B';
+            elem->no_faces_on_surface++;
+            face_vector.push_back(newFace);
+            Neighbors0[i] = newFace;
+        }
+        elem->SetOrder(quadratic);
+        elem->SetNeighbors(Neighbors0);
+    }
+}
+
 void CFEMesh::constructMeshGrid()
 {
     //#ifndef NDEBUG
@@ -979,6 +1043,8 @@ void CFEMesh::GenerateHighOrderNodes()
     bool done;
     double x0 = 0.0, y0 = 0.0, z0 = 0.0;  // OK411
 
+    ConstructEdges();
+
     // Set neighbors of node. All elements, even in deactivated subdomains, are
     // taken into account here.
     for (e = 0; e < (long)nod_vector.size(); e++)
@@ -3006,6 +3072,7 @@ void CFEMesh::FaceNormal()
 
     if (!face_normal.empty())
         return;  // WW
+    ConstructFaces();
     //------------------------
     for (size_t i = 0; i < face_vector.size(); i++)
     {
@@ -3459,12 +3526,20 @@ void CFEMesh::FreeEdgeMemory()
         edge_vector[edge_vector.size() - 1] = NULL;
         edge_vector.pop_back();
     }
+    _edges_constructed = false;
 
     const size_t ne = ele_vector.size();
     for (size_t i = 0; i < ne; i++)
     {
         ele_vector[i]->FreeEdgeMemory();
     }
+
+    // Surface faces are kept, their edges are linked again by the next
+    // ConstructFaces
+    _faces_constructed = false;
+    const size_t nf = face_vector.size();
+    for (size_t i = 0; i < nf; i++)
+        face_vector[i]->FreeEdgeMemory();
 }
 
 /**************************************************************************
@@ -3519,6 +3594,7 @@ void CFEMesh::markTopSurfaceFaceElements3D()
         node_mark[i] = false;
 #endif
 
+    ConstructFaces();
     const double tol = sqrt(std::numeric_limits<double>::epsilon());  // 1.e-5;
     for (std::size_t i = 0; i < face_vector.size(); i++)
     {
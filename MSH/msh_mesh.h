@@ -197,6 +197,11 @@ public:
     std::ios::pos_type GMSReadTIN(std::ifstream*);
     //
     void ConstructGrid();
+    /// Construct edge_vector and the element edges if not done yet.
+    void ConstructEdges();
+    /// Construct face_vector, the faces on the domain surface, if not done
+    /// yet. The edges are constructed as well.
+    void ConstructFaces();
     void GenerateHighOrderNodes();
 
     void markTopSurfaceFaceElements3D();
@@ -529,6 +534,10 @@ protected:
      */
     double _search_length;
 
+    /// Flags of the topology constructed on demand
+    bool _edges_constructed;
+    bool _faces_constructed;
+
     // Process friends
     friend class ::CRFProcess;
 
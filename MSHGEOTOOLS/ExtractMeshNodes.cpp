@@ -39,13 +39,17 @@ void ExtractMeshNodes::writeMeshNodeIDs(std::ostream& os, std::ostream& gli_out,
 
     std::vector<size_t> node_indices;
 
+    std::vector<size_t> interior_node_ids;
+    std::vector<double const*> interior_node_coords;
     for (size_t j(0); j < msh_nodes.size(); j++)
         if (msh_nodes[j]->Interior())
         {
-            GEOLIB::Point pnt(msh_nodes[j]->getData());
-            if (polygon.isPntInPolygon(pnt))
-                node_indices.push_back(j);
+            interior_node_ids.push_back(j);
+            interior_node_coords.push_back(msh_nodes[j]->getData());
         }
+    polygon.getPntsInPolygon(interior_node_coords, node_indices);
+    for (size_t k(0); k < node_indices.size(); k++)
+        node_indices[k] = interior_node_ids[node_indices[k]];
     // write data
     for (size_t k(0); k < node_indices.size(); k++)
         os << node_indices[k] << "\n";
@@ -67,13 +71,11 @@ void ExtractMeshNodes::writeTopSurfaceMeshNodeIDs(
 
     std::vector<GEOLIB::PointWithID> nodes_as_points;
 
-    for (size_t j(0); j < msh_nodes.size(); j++)
-    {
-        GEOLIB::Point pnt(msh_nodes[j]->getData());
-        if (polygon.isPntInPolygon(pnt))
-            nodes_as_points.push_back(
-                GEOLIB::PointWithID(msh_nodes[j]->getData(), j));
-    }
+    std::vector<size_t> node_ids;
+    getMeshNodeIDsWithinPolygon(polygon, node_ids);
+    for (size_t k(0); k < node_ids.size(); k++)
+        nodes_as_points.push_back(GEOLIB::PointWithID(
+            msh_nodes[node_ids[k]]->getData(), node_ids[k]));
 
     std::vector<size_t> perm;
     for (size_t k(0); k < nodes_as_points.size(); k++)
@@ -327,12 +329,7 @@ void ExtractMeshNodes::writeMesh2DNodeIDAndArea(std::ostream& os,
     // store node id
     std::vector<size_t> node_ids;
 
-    for (size_t j(0); j < msh_nodes.size(); j++)
-    {
-        GEOLIB::Point pnt(msh_nodes[j]->getData());
-        if (polygon.isPntInPolygon(pnt))
-            node_ids.push_back(j);
-    }
+    getMeshNodeIDsWithinPolygon(polygon, node_ids);
     std::sort(node_ids.begin(), node_ids.end());
 
     size_t n_nodes(node_ids.size());
@@ -401,21 +398,23 @@ void ExtractMeshNodes::writeMesh2DNodeIDAndArea(
     std::vector<size_t> node_ids;
 
     const size_t n_holes(holes.size());
-    for (size_t j(0); j < msh_nodes.size(); j++)
+    std::vector<size_t> bounded_node_ids;
+    getMeshNodeIDsWithinPolygon(bounding_polygon, bounded_node_ids);
+    std::vector<double const*> bounded_node_coords(bounded_node_ids.size());
+    for (size_t j(0); j < bounded_node_ids.size(); j++)
+        bounded_node_coords[j] = msh_nodes[bounded_node_ids[j]]->getData();
+
+    std::vector<bool> is_not_in_hole(bounded_node_ids.size(), true);
+    for (size_t k(0); k < n_holes; k++)
     {
-        GEOLIB::Point pnt(msh_nodes[j]->getData());
-        if (bounding_polygon.isPntInPolygon(pnt))
-        {
-            bool is_not_in_hole(true);
-
-            for (size_t k(0); k < n_holes && is_not_in_hole; k++)
-                if ((holes[k])->isPntInPolygon(pnt))
-                    is_not_in_hole = false;
-
-            if (is_not_in_hole)
-                node_ids.push_back(j);
-        }
+        std::vector<size_t> ids_in_hole;
+        holes[k]->getPntsInPolygon(bounded_node_coords, ids_in_hole);
+        for (size_t j(0); j < ids_in_hole.size(); j++)
+            is_not_in_hole[ids_in_hole[j]] = false;
     }
+    for (size_t j(0); j < bounded_node_ids.size(); j++)
+        if (is_not_in_hole[j])
+            node_ids.push_back(bounded_node_ids[j]);
     std::sort(node_ids.begin(), node_ids.end());
 
     size_t n_nodes(node_ids.size());
@@ -495,13 +494,10 @@ void ExtractMeshNodes::getMeshNodeIDsWithinPolygon(
 
     // check if nodes (projected to x-y-plane) are inside the polygon
     const size_t number_of_mesh_nodes(mesh_nodes.size());
+    std::vector<double const*> mesh_node_coords(number_of_mesh_nodes);
     for (size_t j(0); j < number_of_mesh_nodes; j++)
-    {
-        if (polygon.isPntInPolygon(mesh_nodes[j]->getData()))
-        {
-            node_ids.push_back(j);
-        }
-    }
+        mesh_node_coords[j] = mesh_nodes[j]->getData();
+    polygon.getPntsInPolygon(mesh_node_coords, node_ids);
 }
 
 }  // end namespace MeshLib
@@ -0,0 +1,162 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Definition of member functions of class PETScAssemblyBuffer
+*/
+#include "PETScAssemblyBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace petsc_group
+{
+void PETScAssemblyBuffer::setOwnedRange(const PetscInt start_row,
+                                        const PetscInt end_row)
+{
+    _owned_start = start_row;
+    _owned_end = end_row;
+    _owned_row_ids.assign(end_row - start_row, -1);
+    _ghost_row_ids.clear();
+    for (std::size_t i = 0; i < _rows.size(); i++)
+    {
+        const PetscInt row = _rows[i];
+        if (row >= _owned_start && row < _owned_end)
+            _owned_row_ids[row - _owned_start] = static_cast<long>(i);
+        else
+            _ghost_row_ids[row] = static_cast<long>(i);
+    }
+}
+
+long PETScAssemblyBuffer::getRowIndex(const PetscInt row) const
+{
+    if (row >= _owned_start && row < _owned_end)
+        return _owned_row_ids[row - _owned_start];
+
+    std::map<PetscInt, long>::const_iterator it = _ghost_row_ids.find(row);
+    return (it == _ghost_row_ids.end()) ? -1 : it->second;
+}
+
+void PETScAssemblyBuffer::add(const int m, const int idxm[], const int n,
+                              const int idxn[], const double v[])
+{
+    _modified = true;
+    for (int i = 0; i < m; i++)
+    {
+        const PetscInt row = idxm[i];
+        if (row < 0)  // Negative indices are ignored as in MatSetValues
+            continue;
+        double const* const v_row = v + i * n;
+
+        const long row_id = getRowIndex(row);
+        if (row_id < 0)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                if (idxn[j] < 0)
+                    continue;
+                Entry entry;
+                entry.row = row;
+                entry.col = idxn[j];
+                entry.val = v_row[j];
+                _pending.push_back(entry);
+            }
+            continue;
+        }
+
+        PetscInt const* const cols_begin = &_cols[0] + _row_ptr[row_id];
+        PetscInt const* const cols_end = &_cols[0] + _row_ptr[row_id + 1];
+        double* const vals = &_vals[0] + _row_ptr[row_id];
+        for (int j = 0; j < n; j++)
+        {
+            const PetscInt col = idxn[j];
+            if (col < 0)
+                continue;
+            PetscInt const* const pos =
+                std::lower_bound(cols_begin, cols_end, col);
+            if (pos != cols_end && *pos == col)
+            {
+                vals[pos - cols_begin] += v_row[j];
+                continue;
+            }
+            Entry entry;
+            entry.row = row;
+            entry.col = col;
+            entry.val = v_row[j];
+            _pending.push_back(entry);
+        }
+    }
+}
+
+void PETScAssemblyBuffer::setZero()
+{
+    std::fill(_vals.begin(), _vals.end(), 0.0);
+    _pending.clear();
+    _modified = false;
+}
+
+std::size_t PETScAssemblyBuffer::getBlockSize(const std::size_t i) const
+{
+    const PetscInt n = getRowLength(i);
+    PetscInt const* const cols = getColumns(i);
+    std::size_t k = i + 1;
+    while (k < _rows.size() && getRowLength(k) == n &&
+           std::memcmp(getColumns(k), cols, n * sizeof(PetscInt)) == 0)
+        k++;
+    return k - i;
+}
+
+void PETScAssemblyBuffer::mergePendingEntries()
+{
+    if (_pending.empty())
+        return;
+
+    // Merge the existing pattern and values with the pending entries.
+    std::vector<Entry> entries;
+    entries.reserve(_cols.size() + _pending.size());
+    for (std::size_t i = 0; i < _rows.size(); i++)
+    {
+        for (std::size_t k = _row_ptr[i]; k < _row_ptr[i + 1]; k++)
+        {
+            Entry entry;
+            entry.row = _rows[i];
+            entry.col = _cols[k];
+            entry.val = _vals[k];
+            entries.push_back(entry);
+        }
+    }
+    entries.insert(entries.end(), _pending.begin(), _pending.end());
+    _pending.clear();
+    std::sort(entries.begin(), entries.end());
+
+    _rows.clear();
+    _row_ptr.clear();
+    _cols.clear();
+    _vals.clear();
+    for (std::size_t k = 0; k < entries.size(); k++)
+    {
+        Entry const& entry = entries[k];
+        if (_rows.empty() || _rows.back() != entry.row)
+        {
+            _rows.push_back(entry.row);
+            _row_ptr.push_back(_cols.size());
+        }
+        else if (_cols.back() == entry.col)
+        {
+            _vals.back() += entry.val;
+            continue;
+        }
+        _cols.push_back(entry.col);
+        _vals.push_back(entry.val);
+    }
+    _row_ptr.push_back(_cols.size());
+
+    setOwnedRange(_owned_start, _owned_end);
+}
+}  // namespace petsc_group
@@ -0,0 +1,121 @@
+/**
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ *
+ */
+
+/*!
+   \brief Declaration of class PETScAssemblyBuffer
+
+   Rank local buffer for the batch insertion of element matrices into a
+   PETSc matrix.
+*/
+#ifndef PETSC_ASSEMBLY_BUFFER_INC
+#define PETSC_ASSEMBLY_BUFFER_INC
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "petscsys.h"
+
+namespace petsc_group
+{
+/*!
+   \brief Compressed row storage that collects the element matrices of one
+   rank before they are handed to PETSc in blocks of rows.
+
+   The sparsity pattern is learned during the first assembly: entries that
+   are not in the pattern yet are kept in a list of pending entries, and
+   merged into the pattern, with their values, by mergePendingEntries(). In
+   the following assemblies, the element matrices are added to the
+   preallocated values directly. Row and column indices are stored as
+   PetscInt, so that they can be handed to PETSc as they are.
+
+   The element matrices are added by one thread per rank. A threaded
+   assembly of element colours into the buffer is not possible with the
+   present local assemblers: all elements of a process are computed by one
+   CFiniteElementStd object with shared scratch matrices and function local
+   static buffers.
+*/
+class PETScAssemblyBuffer
+{
+public:
+    PETScAssemblyBuffer() : _owned_start(0), _owned_end(0), _modified(false)
+    {
+    }
+    /// Set the range of the rows owned by this rank, which are indexed
+    /// directly. Other (ghost) rows are looked up in a map.
+    void setOwnedRange(const PetscInt start_row, const PetscInt end_row);
+
+    /// Add the dense, row major m x n matrix v. The indices are those of
+    /// PETScLinearSolver::addMatrixEntries().
+    void add(const int m, const int idxm[], const int n, const int idxn[],
+             const double v[]);
+
+    /// Set all values to zero but keep the sparsity pattern.
+    void setZero();
+
+    /// Check if values were added since the last setZero().
+    bool isModified() const { return _modified; }
+
+    /// Merge the pending entries, i.e. the entries which are not in the
+    /// sparsity pattern yet, into the pattern. Their values are kept.
+    void mergePendingEntries();
+
+    std::size_t getNumberOfRows() const { return _rows.size(); }
+    PetscInt const* getRows(const std::size_t i) const { return &_rows[i]; }
+    PetscInt getRowLength(const std::size_t i) const
+    {
+        return static_cast<PetscInt>(_row_ptr[i + 1] - _row_ptr[i]);
+    }
+    PetscInt const* getColumns(const std::size_t i) const
+    {
+        return &_cols[_row_ptr[i]];
+    }
+    double const* getValues(const std::size_t i) const
+    {
+        return &_vals[_row_ptr[i]];
+    }
+
+    /// Number of the rows, starting with row i, which have the same columns
+    /// as row i. Their values are a dense, row major block.
+    std::size_t getBlockSize(const std::size_t i) const;
+
+private:
+    struct Entry
+    {
+        PetscInt row;
+        PetscInt col;
+        double val;
+        bool operator<(Entry const& other) const
+        {
+            if (row != other.row)
+                return row < other.row;
+            return col < other.col;
+        }
+    };
+
+    /// Index of the given row in _rows, or -1 if not present.
+    long getRowIndex(const PetscInt row) const;
+
+    PetscInt _owned_start;
+    PetscInt _owned_end;
+    /// Row index of the owned rows, -1 if the row is not in the pattern.
+    std::vector<long> _owned_row_ids;
+    /// Row index of the ghost rows.
+    std::map<PetscInt, long> _ghost_row_ids;
+
+    std::vector<PetscInt> _rows;
+    std::vector<std::size_t> _row_ptr;
+    std::vector<PetscInt> _cols;
+    std::vector<double> _vals;
+
+    std::vector<Entry> _pending;
+    bool _modified;
+};
+}  // namespace petsc_group
+#endif
@@ -38,6 +38,7 @@ PETScLinearSolver::PETScLinearSolver(const int size)
     m_size_loc = PETSC_DECIDE;
     mpi_size = 0;
     rank = 0;
+    batch_assembly = false;
 }
 
 PETScLinearSolver::~PETScLinearSolver()
@@ -222,6 +223,7 @@ void PETScLinearSolver::MatrixCreate(PetscInt m, PetscInt n)
     // matrix with version 3.3
 
     MatGetOwnershipRange(A, &i_start, &i_end);
+    assembly_buffer.setOwnedRange(i_start, i_end);
 }
 
 void PETScLinearSolver::getLocalRowColumnSizes(int* m, int* n)
@@ -363,6 +365,9 @@ void PETScLinearSolver::AssembleUnkowns_PETSc()
 }
 void PETScLinearSolver::AssembleMatrixPETSc(const MatAssemblyType type)
 {
+    if (batch_assembly)
+        flushAssemblyBuffer();
+
     MatAssemblyBegin(A, type);
     MatAssemblyEnd(A, type);
 }
@@ -513,11 +518,17 @@ void PETScLinearSolver::Initialize()
     VecSet(b, 0.0);
     VecSet(x, 0.0);
     MatZeroEntries(A);
+    assembly_buffer.setZero();
 }
 
 void PETScLinearSolver::addMatrixEntry(const int i, const int j,
                                        const double value)
 {
+    if (batch_assembly)
+    {
+        assembly_buffer.add(1, &i, 1, &j, &value);
+        return;
+    }
     MatSetValue(A, i, j, value, ADD_VALUES);
 }
 
@@ -525,9 +536,40 @@ void PETScLinearSolver::addMatrixEntries(const int m, const int idxm[],
                                          const int n, const int idxn[],
                                          const PetscScalar v[])
 {
+    if (batch_assembly)
+    {
+        assembly_buffer.add(m, idxm, n, idxn, v);
+        return;
+    }
     MatSetValues(A, m, idxm, n, idxn, v, ADD_VALUES);
 }
 
+void PETScLinearSolver::flushAssemblyBuffer()
+{
+    // Nothing was added since the last flush, e.g. after zeroRows_in_Matrix
+    if (!assembly_buffer.isModified())
+        return;
+
+    // Entries found in the first assembly become part of the pattern, so
+    // that they are sent with the rest.
+    assembly_buffer.mergePendingEntries();
+
+    // One MatSetValues call per block of consecutive rows with the same
+    // sorted column indices.
+    const std::size_t n_rows = assembly_buffer.getNumberOfRows();
+    for (std::size_t i = 0; i < n_rows;)
+    {
+        const std::size_t m = assembly_buffer.getBlockSize(i);
+        MatSetValues(A, static_cast<PetscInt>(m), assembly_buffer.getRows(i),
+                     assembly_buffer.getRowLength(i),
+                     assembly_buffer.getColumns(i),
+                     assembly_buffer.getValues(i), ADD_VALUES);
+        i += m;
+    }
+
+    assembly_buffer.setZero();
+}
+
 void PETScLinearSolver::zeroRows_in_Matrix(const int nrows,
                                            const PetscInt* rows)
 {
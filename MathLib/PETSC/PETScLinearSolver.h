@@ -25,6 +25,8 @@
 #include "petscmat.h"
 #include "petscksp.h"
 
+#include "PETScAssemblyBuffer.h"
+
 #if (PETSC_VERSION_NUMBER > 3030)
 #include "petsctime.h"
 #endif
@@ -78,6 +80,17 @@ public:
     void addMatrixEntries(const int m, const int idxm[], const int n,
                           const int idxn[], const PetscScalar v[]);
 
+    /*!
+         \brief Collect the matrix entries in a rank local buffer, which is
+                 handed to PETSc in one step by AssembleMatrixPETSc(),
+                 instead of calling MatSetValues for each element.
+                 The elements are still assembled sequentially on each rank,
+                 see PETScAssemblyBuffer.
+         \param use_batch Flag to use the batch assembly.
+    */
+    void setBatchAssembly(const bool use_batch) { batch_assembly = use_batch; }
+    bool isBatchAssembly() const { return batch_assembly; }
+
     void Initialize();
 
     void zeroRows_in_Matrix(const int nrow, const PetscInt* rows);
@@ -126,6 +139,9 @@ private:
     int mpi_size;
     int rank;
 
+    bool batch_assembly;
+    PETScAssemblyBuffer assembly_buffer;
+
     void VectorCreate(PetscInt m);
     void MatrixCreate(PetscInt m, PetscInt n);
 
@@ -138,6 +154,9 @@ private:
                             PetscScalar global_array[]);
 
     void UpdateSolutions(PetscScalar* u);
+
+    /// Hand the content of the assembly buffer to the PETSc matrix.
+    void flushAssemblyBuffer();
 };
 
 // extern std::vector<PETScLinearSolver*> EQS_Vector;
@@ -0,0 +1,93 @@
+/**
+ * \file convertNodeValuesToBinary.cpp
+ *
+ * Writes the binary companion file (file name + ".bin") of a node value
+ * file of DIRECT initial or boundary conditions or source terms, or of a
+ * RESTART (.rfr) file, and reports the reading times of both formats.
+ * The binary file is only used by the simulation while the text file is
+ * not changed, otherwise it has to be written again.
+ *
+ * Usage: convertNodeValuesToBinary file [--restart]
+ * Files with the extension .rfr are read as RESTART files.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchtimer.h"
+
+// FileIO
+#include "FEMIO/NodeValuesBinaryIO.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: " << argv[0] << " file [--restart]" << std::endl;
+        return -1;
+    }
+    const std::string fname(argv[1]);
+    const bool restart((argc > 2 && std::string(argv[2]) == "--restart") ||
+                       (fname.size() > 4 &&
+                        fname.compare(fname.size() - 4, 4, ".rfr") == 0));
+
+    std::vector<long> node_ids;
+    std::vector<double> values;
+    std::size_t n_columns(1);
+    BenchTimer timer;
+    timer.start();
+    const bool ok(
+        restart ? FileIO::NodeValuesBinaryIO::readRestartText(
+                      fname, node_ids, values, n_columns)
+                : FileIO::NodeValuesBinaryIO::readDirectText(fname, node_ids,
+                                                             values));
+    timer.stop();
+    if (!ok)
+    {
+        std::cout << "Could not read " << fname << std::endl;
+        return -1;
+    }
+    std::cout << "Read " << node_ids.size() << " nodes with " << n_columns
+              << " values from " << fname << " in " << timer.time_s()
+              << " s" << std::endl;
+
+    // The size identifies the text file the binary file is written from
+    std::ifstream text(fname.c_str(), std::ios::in | std::ios::binary);
+    text.seekg(0, std::ios::end);
+    const uint64_t text_size = static_cast<uint64_t>(text.tellg());
+    text.close();
+
+    const std::string bin_name(
+        FileIO::NodeValuesBinaryIO::getBinaryFileName(fname));
+    if (!FileIO::NodeValuesBinaryIO::write(bin_name, node_ids, values,
+                                           n_columns, text_size))
+    {
+        std::cout << "Could not write " << bin_name << std::endl;
+        return -1;
+    }
+
+    std::vector<long> bin_ids;
+    std::vector<double> bin_values;
+    std::size_t bin_columns(0);
+    timer.start();
+    FileIO::NodeValuesBinaryIO::read(bin_name, bin_ids, bin_values,
+                                     bin_columns);
+    timer.stop();
+    if (bin_ids != node_ids || bin_values != values || bin_columns != n_columns)
+    {
+        std::cout << "Error: " << bin_name << " differs from " << fname
+                  << std::endl;
+        return -1;
+    }
+    std::cout << "Wrote " << bin_name << ", read back in " << timer.time_s()
+              << " s" << std::endl;
+    return 0;
+}
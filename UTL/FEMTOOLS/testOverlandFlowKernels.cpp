@@ -0,0 +1,131 @@
+/**
+ * \file testOverlandFlowKernels.cpp
+ *
+ * Measures the throughput of the Newton assembly of overland flow
+ * (residual and Jacobian per element) on a synthetic catchment surface of
+ * n x n cells, meshed with quadrilaterals or with triangles.
+ *
+ * Usage: testOverlandFlowKernels [n] [quad|tri] [iterations]
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "benchtimer.h"
+
+// FEM
+#include "OverlandFlowKernels.h"
+#include "rf_mmp_new.h"
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n(argc > 1 ? atol(argv[1]) : 1000);
+    const bool quads(argc > 2 ? strcmp(argv[2], "tri") != 0 : true);
+    const std::size_t n_iterations(argc > 3 ? atol(argv[3]) : 5);
+    if (n == 0 || n_iterations == 0)
+    {
+        std::cout << "Usage: " << argv[0] << " [n] [quad|tri] [iterations]"
+                  << std::endl;
+        return -1;
+    }
+
+    // Hillslope of 10 m cells draining to a valley along x = 0, with a
+    // thin water film on top.
+    const double cell(10.0);
+    const std::size_t n_points((n + 1) * (n + 1));
+    std::vector<double> x(n_points), y(n_points), z(n_points), head(n_points),
+        head_old(n_points);
+    for (std::size_t j(0); j <= n; j++)
+        for (std::size_t i(0); i <= n; i++)
+        {
+            const std::size_t k(j * (n + 1) + i);
+            x[k] = cell * i;
+            y[k] = cell * j;
+            z[k] = 0.01 * x[k] + 0.002 * y[k] + 0.5 * sin(0.05 * x[k]) *
+                                                    cos(0.03 * y[k]);
+            head_old[k] = z[k] + 0.01;
+            head[k] = z[k] + 0.01 + 0.005 * cos(0.1 * x[k] + 0.07 * y[k]);
+        }
+
+    std::vector<std::size_t> connectivity;
+    for (std::size_t j(0); j < n; j++)
+        for (std::size_t i(0); i < n; i++)
+        {
+            const std::size_t k0(j * (n + 1) + i), k1(k0 + 1),
+                k2(k0 + n + 2), k3(k0 + n + 1);
+            if (quads)
+            {
+                connectivity.push_back(k0);
+                connectivity.push_back(k1);
+                connectivity.push_back(k2);
+                connectivity.push_back(k3);
+            }
+            else
+            {
+                connectivity.push_back(k0);
+                connectivity.push_back(k1);
+                connectivity.push_back(k2);
+                connectivity.push_back(k0);
+                connectivity.push_back(k2);
+                connectivity.push_back(k3);
+            }
+        }
+    const int n_nodes(quads ? 4 : 3);
+    const int geo_type(quads ? 2 : 4);
+    const std::size_t n_elements(connectivity.size() / n_nodes);
+
+    CMediumProperties mmp;
+    mmp.friction_coefficient = 20.0;
+    mmp.friction_exp_slope = 0.5;
+    mmp.friction_exp_depth = 2.0 / 3.0;
+    mmp.overland_width = 1.0;
+    mmp.rill_height = 0.0;
+    mmp.rill_epsilon = 0.005;
+    mmp.channel = false;
+    const FiniteElement::OverlandFlowParameters parameters(mmp);
+    FiniteElement::OverlandFlowGeometryCache geometry;
+    const double dt(60.0);
+
+    double X[4], Y[4], Z[4], h[4], h_old[4], residual[4], jacobian[16];
+    double norm(0.0);
+    BenchTimer timer;
+    timer.start();
+    for (std::size_t it(0); it < n_iterations; it++)
+        for (std::size_t e(0); e < n_elements; e++)
+        {
+            const std::size_t* nodes(&connectivity[e * n_nodes]);
+            for (int i(0); i < n_nodes; i++)
+            {
+                X[i] = x[nodes[i]];
+                Y[i] = y[nodes[i]];
+                Z[i] = z[nodes[i]];
+                h[i] = head[nodes[i]];
+                h_old[i] = head_old[nodes[i]];
+            }
+            const FiniteElement::OverlandElementGeometry* geo(
+                geometry.get(e, geo_type, X, Y, Z));
+            FiniteElement::assembleOverlandNewton(*geo, parameters, h, h_old,
+                                                  dt, residual, jacobian);
+            for (int i(0); i < n_nodes; i++)
+                norm += residual[i] * residual[i];
+        }
+    timer.stop();
+
+    const double assemblies((double)n_elements * n_iterations);
+    std::cout << "assembled " << n_elements << (quads ? " quad" : " tri")
+              << " elements x " << n_iterations << " iterations in "
+              << timer.time_s() << " s, " << assemblies / timer.time_s()
+              << " elements per second" << std::endl;
+    std::cout << "residual norm " << sqrt(norm) << std::endl;
+
+    return 0;
+}
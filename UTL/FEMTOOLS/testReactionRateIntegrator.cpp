@@ -0,0 +1,85 @@
+/**
+ * \file testReactionRateIntegrator.cpp
+ *
+ * Measures the time per Gauss point of the batched integration of the
+ * conversion rate of the CaOH2 system (TES/TNEQ processes).
+ *
+ * Usage: testReactionRateIntegrator [number of points] [batch size]
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "benchtimer.h"
+
+// FEM
+#include "conversion_rate.h"
+#include "ReactionRateIntegrator.h"
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n_points(argc > 1 ? atol(argv[1]) : 1000000);
+    const std::size_t batch_size(argc > 2 ? atol(argv[2]) : 10000);
+    if (n_points == 0 || batch_size == 0)
+    {
+        std::cout << "Usage: " << argv[0]
+                  << " [number of points] [batch size]" << std::endl;
+        return -1;
+    }
+
+    // CaOH2 with the material data of the TES benchmarks
+    const double rho_s_0(1656.0), phi_solid(0.5), delta_t(1.0);
+    const double rho_lower(1665.1), rho_upper(2200.0);
+    conversion_rate model(573.0, 573.0, 0.0, 0.0, rho_s_0, phi_solid, delta_t,
+                          FiniteElement::CaOH2);
+    FiniteElement::ReactionRateIntegrator integrator(model);
+
+    // The points are spread over hydration and dehydration conditions.
+    std::vector<double> rho_s(batch_size), q_R(batch_size);
+    double rho_s_sum(0.0);
+    BenchTimer timer;
+    timer.start();
+    for (std::size_t offset(0); offset < n_points; offset += batch_size)
+    {
+        const std::size_t n(std::min(batch_size, n_points - offset));
+        for (std::size_t i(0); i < n; i++)
+        {
+            const double s((double)((offset + i) % 1000) / 1000.0);
+            FiniteElement::ReactiveGaussPoint pnt;
+            pnt.T_solid = 573.0 + 200.0 * s;
+            pnt.T_gas = pnt.T_solid;
+            pnt.p_gas = 1.0;
+            pnt.w_water = 0.1 + 0.8 * s;
+            pnt.rho_s_prev = rho_lower + (rho_upper - rho_lower) * (1.0 - s);
+            pnt.phi_solid = phi_solid;
+            pnt.system = FiniteElement::CaOH2;
+            pnt.xv_NR = 0.0;
+            pnt.rho_NR = 0.0;
+            pnt.rho_lower = rho_lower;
+            pnt.rho_upper = rho_upper;
+            pnt.rho_s_curr = &rho_s[i];
+            pnt.q_R = &q_R[i];
+            integrator.add(pnt);
+        }
+        integrator.integrate(delta_t);
+        for (std::size_t i(0); i < n; i++)
+            rho_s_sum += rho_s[i];
+    }
+    timer.stop();
+
+    std::cout << "integrated " << n_points << " Gauss points in batches of "
+              << batch_size << " in " << timer.time_s() << " s, "
+              << timer.time_s() / n_points * 1e6 << " us per point"
+              << std::endl;
+    std::cout << "mean solid density " << rho_s_sum / n_points << std::endl;
+
+    return 0;
+}
@@ -98,6 +98,7 @@ void ModifyMeshProperties::setMaterial(const GEOLIB::Polygon& polygon,
 
     // *** perform search and modify mesh
     const size_t msh_elem_size(msh_elem.size());
+    std::vector<double> centers(3 * msh_elem_size);
     for (size_t j(0); j < msh_elem_size; j++)
     {
         // indices of nodes of the j-th element
@@ -124,7 +125,8 @@ void ModifyMeshProperties::setMaterial(const GEOLIB::Polygon& polygon,
         //		if (cnt >= 2)
         //			msh_elem[j]->setPatchIndex (mat_id);
 
-        double center[3] = {0.0, 0.0, 0.0};
+        double* center(&centers[3 * j]);
+        center[0] = center[1] = center[2] = 0.0;
         for (size_t k(0); k < nodes_indices.Size(); k++)
         {
             center[0] += (*(mesh_nodes_as_points[nodes_indices[k]]))[0];
@@ -139,13 +141,16 @@ void ModifyMeshProperties::setMaterial(const GEOLIB::Polygon& polygon,
         //		std::cout << "center of element " << j << ": " << center[0] <<
         //", " << center[1] << ", " << center[2] <<
         // std::endl;
-
-        if (rot_polygon.isPntInPolygon(center[0], center[1], center[2]))
-        {
-            msh_elem[j]->setPatchIndex(mat_id);
-        }
     }
 
+    std::vector<double const*> center_coords(msh_elem_size);
+    for (size_t j(0); j < msh_elem_size; j++)
+        center_coords[j] = &centers[3 * j];
+    std::vector<size_t> elem_ids;
+    rot_polygon.getPntsInPolygon(center_coords, elem_ids);
+    for (size_t k(0); k < elem_ids.size(); k++)
+        msh_elem[elem_ids[k]]->setPatchIndex(mat_id);
+
     for (size_t k(0); k < polygon_points.size(); k++)
         delete polygon_points[k];
     for (size_t j(0); j < mesh_nodes_as_points.size(); j++)
@@ -11,6 +11,9 @@
 
 #include "mHMPreprocessor.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <limits>
 
 #ifndef _MSC_VER
@@ -37,14 +40,190 @@ struct RasterDataGIS
     double csize;            /// cell size.
     double ndata_v;          /// invalid data.
     std::vector<double> zz;  /// of cells.
+
+    bool hasSameGeometry(RasterDataGIS const& other) const
+    {
+        return nrows == other.nrows && ncols == other.ncols &&
+               x0 == other.x0 && y0 == other.y0 && csize == other.csize;
+    }
+};
+
+/// Sparse raster cell to mesh node operator in the compressed row storage.
+/// Row i belongs to the top surface node node_ids[i].
+struct RasterToNodeOperator
+{
+    std::vector<std::size_t> node_ids;
+    std::vector<std::size_t> row_ptr;
+    std::vector<std::size_t> cell_ids;
+    std::vector<double> weights;
+
+    /// nodal_flux[i] = ratio * sum_j weights_ij * cell_value_j, where the
+    /// cells with the no data value contribute nothing.
+    void apply(RasterDataGIS const& raster_data, double ratio,
+               std::vector<double>& nodal_flux) const
+    {
+        const std::size_t n_rows = node_ids.size();
+        nodal_flux.resize(n_rows);
+        for (std::size_t i = 0; i < n_rows; i++)
+        {
+            double val = 0.0;
+            for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; k++)
+            {
+                const double cell_val = raster_data.zz[cell_ids[k]];
+                if (fabs(cell_val - raster_data.ndata_v) <
+                    std::numeric_limits<double>::min())
+                    continue;
+                val += weights[k] * cell_val;
+            }
+            nodal_flux[i] = ratio * val;
+        }
+    }
 };
 
+namespace
+{
+/// Entry of the operator before it is compressed.
+struct OperatorEntry
+{
+    std::size_t node_id;
+    std::size_t cell_id;
+    double weight;
+
+    bool operator<(OperatorEntry const& other) const
+    {
+        if (node_id != other.node_id)
+            return node_id < other.node_id;
+        return cell_id < other.cell_id;
+    }
+};
+
+/// Get the index of the raster cell whose value is assigned to point pnt.
+std::size_t getRasterCellIndex(RasterDataGIS const& raster_data,
+                               double const* const pnt)
+{
+    long nx = static_cast<long>((pnt[0] - raster_data.x0) / raster_data.csize);
+    long ny = static_cast<long>((pnt[1] - raster_data.y0) / raster_data.csize);
+    ny = raster_data.nrows - ny;
+    if (ny < 0)
+        ny = 0;
+    if (ny > static_cast<long>(raster_data.nrows))
+        ny = raster_data.nrows;
+
+    if (nx * raster_data.csize + raster_data.x0 >= pnt[0])
+        nx -= 1;
+    if (ny * raster_data.csize + raster_data.y0 >= pnt[1])
+        ny -= 1;
+    if (nx >= static_cast<long>(raster_data.ncols) - 1)
+        nx = raster_data.ncols - 2;
+    if (ny >= static_cast<long>(raster_data.nrows) - 1)
+        ny = raster_data.nrows - 2;
+    if (nx < 0)
+        nx = 0;
+    if (ny < 0)
+        ny = 0;
+
+    return raster_data.ncols * ny + nx;
+}
+
+/// Read the file into a null terminated buffer. If header_only is true, only
+/// the six header lines of the raster file are read.
+bool readFileToBuffer(std::string const& fname, std::vector<char>& buffer,
+                      const bool header_only)
+{
+    std::ifstream ins(fname.c_str(), std::ios::binary);
+    if (!ins.good())
+        return false;
+
+    if (header_only)
+    {
+        std::string header;
+        std::string aline;
+        for (int i = 0; i < 6 && getline(ins, aline); i++)
+            header += aline + "\n";
+        buffer.assign(header.begin(), header.end());
+        buffer.push_back('\0');
+        return true;
+    }
+
+    ins.seekg(0, std::ios::end);
+    const std::streamoff size = ins.tellg();
+    ins.seekg(0, std::ios::beg);
+
+    buffer.resize(static_cast<std::size_t>(size) + 1);
+    if (size > 0)
+        ins.read(&buffer[0], size);
+    buffer[static_cast<std::size_t>(size)] = '\0';
+    return true;
+}
+
+/// Skip the key word of a header line, and return the position of its value.
+char* skipHeaderKey(char* pos)
+{
+    while (*pos != '\0' && isspace(*pos))
+        pos++;
+    while (*pos != '\0' && !isspace(*pos))
+        pos++;
+    return pos;
+}
+}  // end of anonymous namespace
+
 mHMPreprocessor::~mHMPreprocessor()
 {
     if (_fem)
         delete _fem;
 }
 
+//---------------------------------------------------------------------------
+/*!
+   \brief Read GIS shapfile
+
+   The whole file is read into memory at once, and the values are parsed
+   with strtod, which is much faster than the stream extraction.
+   Return false if the file cannot be opened or the data are incomplete.
+
+   \param fname       The file name.
+   \param raster_data The raster data.
+   \param header_only If true, only the header of the file is read.
+
+   03/2010 WW
+ */
+bool ReadShapeFile(std::string const& fname, RasterDataGIS& raster_data,
+                   const bool header_only = false)
+{
+    std::vector<char> buffer;
+    if (!readFileToBuffer(fname, buffer, header_only))
+    {
+        std::cout << "Can not find file " << fname << "\n";
+        return false;
+    }
+
+    char* pos = &buffer[0];
+    char* end = NULL;
+    raster_data.ncols = strtoul(skipHeaderKey(pos), &end, 10);
+    raster_data.nrows = strtoul(skipHeaderKey(end), &end, 10);
+    raster_data.x0 = strtod(skipHeaderKey(end), &end);
+    raster_data.y0 = strtod(skipHeaderKey(end), &end);
+    raster_data.csize = strtod(skipHeaderKey(end), &end);
+    raster_data.ndata_v = strtod(skipHeaderKey(end), &end);
+
+    raster_data.zz.clear();
+    if (header_only)
+        return true;
+
+    raster_data.zz.resize(raster_data.nrows * raster_data.ncols);
+    for (std::size_t i = 0; i < raster_data.zz.size(); i++)
+    {
+        pos = end;
+        raster_data.zz[i] = strtod(pos, &end);
+        if (pos == end)
+        {
+            std::cout << "Not enough data in file " << fname << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
 void mHMPreprocessor::transform_mHMData(const std::string& output_path)
 {
 #ifndef _MSC_VER
@@ -108,15 +287,14 @@ void mHMPreprocessor::transform_mHMData(const std::string& output_path)
 
     std::string of_path = (output_path.empty()) ? file_path : output_path;
 
-    const std::string infiltration_files =
-        pathJoin(of_path, file_base_name + ".ifl");
-    std::ofstream infil(infiltration_files.c_str(), std::ios::trunc);
-
-    double step = 0.;
+    // Collect the names of the mHM files, and read their headers.
+    std::vector<std::string> mHM_keys;
+    std::vector<RasterDataGIS> raster_headers;
     while (!ins.eof())
     {
         getline(ins, aline);
         ss.str(aline);
+        key.clear();
         ss >> key;
         ss.clear();
 
@@ -126,23 +304,95 @@ void mHMPreprocessor::transform_mHMData(const std::string& output_path)
         if (key.find("#STOP") != std::string::npos)
             break;
 
-        std::string mHM_file_name = pathJoin(file_path, key);
+        RasterDataGIS raster_header;
+        if (!ReadShapeFile(pathJoin(file_path, key), raster_header, true))
+            continue;
+        mHM_keys.push_back(key);
+        raster_headers.push_back(raster_header);
+    }
+
+    // Build the raster-to-node operator once for each raster geometry.
+    // Normally, all data have the same geometry.
+    std::vector<RasterToNodeOperator*> operators;
+    std::vector<std::size_t> operator_ids(mHM_keys.size());
+    for (std::size_t i = 0; i < mHM_keys.size(); i++)
+    {
+        std::size_t k = 0;
+        for (; k < i; k++)
+        {
+            if (raster_headers[i].hasSameGeometry(raster_headers[k]))
+                break;
+        }
+        if (k < i)
+        {
+            operator_ids[i] = operator_ids[k];
+            continue;
+        }
+
+        RasterToNodeOperator* op = new RasterToNodeOperator();
+        buildRasterToNodeOperator(raster_headers[i], *op);
+        operator_ids[i] = operators.size();
+        operators.push_back(op);
+        std::cout << "Built the raster-to-node operator with "
+                  << op->node_ids.size() << " nodes and " << op->weights.size()
+                  << " weights." << std::endl;
+    }
+
+    const long n_files = static_cast<long>(mHM_keys.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (long i = 0; i < n_files; i++)
+    {
+        const std::string& mHM_key = mHM_keys[i];
+        const std::string mHM_file_name = pathJoin(file_path, mHM_key);
+#ifdef _OPENMP
+#pragma omp critical(mHM2OGS_output)
+#endif
         std::cout << "Processing file: " << mHM_file_name << std::endl;
-        const std::string ofname = pathJoin(of_path, key + ".bin");
-        const RasterDataGIS& raster_data =
-            transfromSingle_mHMdataToNodalFlux(mHM_file_name, ofname, ratio);
 
-        // Assume that the geometries of all data are the same.
-        if (step == 0.0)
+        RasterDataGIS raster_data;
+        if (!ReadShapeFile(mHM_file_name, raster_data))
+            continue;
+
+        RasterToNodeOperator const& op = *operators[operator_ids[i]];
+        std::vector<double> nodal_flux;
+        op.apply(raster_data, ratio, nodal_flux);
+
+        const std::string ofname = pathJoin(of_path, mHM_key + ".bin");
+        std::ofstream ofile_bin(ofname.c_str(),
+                                std::ios::trunc | std::ios::binary);
+        const std::size_t counter = op.node_ids.size();
+        ofile_bin.write((char*)(&counter), sizeof(counter));
+        for (std::size_t k = 0; k < counter; k++)
         {
-            infil << "GIS shapefile data headers:" << std::endl;
-            infil << raster_data.ncols << " " << raster_data.nrows << " "
-                  << raster_data.x0 << " " << raster_data.y0 << " "
-                  << raster_data.csize << " " << raster_data.ndata_v
-                  << std::endl;
+            ofile_bin.write((char*)(&op.node_ids[k]), sizeof(op.node_ids[k]));
+            ofile_bin.write((char*)(&nodal_flux[k]), sizeof(nodal_flux[k]));
         }
+        ofile_bin.close();
+    }
+
+    for (std::size_t i = 0; i < operators.size(); i++)
+        delete operators[i];
 
-        infil << step << " " << key + ".bin"
+    const std::string infiltration_files =
+        pathJoin(of_path, file_base_name + ".ifl");
+    std::ofstream infil(infiltration_files.c_str(), std::ios::trunc);
+
+    // Assume that the geometries of all data are the same.
+    if (!raster_headers.empty())
+    {
+        RasterDataGIS const& raster_header = raster_headers[0];
+        infil << "GIS shapefile data headers:" << std::endl;
+        infil << raster_header.ncols << " " << raster_header.nrows << " "
+              << raster_header.x0 << " " << raster_header.y0 << " "
+              << raster_header.csize << " " << raster_header.ndata_v
+              << std::endl;
+    }
+    double step = 0.;
+    for (std::size_t i = 0; i < mHM_keys.size(); i++)
+    {
+        infil << step << " " << mHM_keys[i] + ".bin"
               << "\n";
 
         step += 1.0;
@@ -160,84 +410,12 @@ void mHMPreprocessor::transform_mHMData(const std::string& output_path)
     std::cout << "Elapsed time: " << elapsed_time << " s" << std::endl;
 }
 
-//---------------------------------------------------------------------------
-/*!
-   \brief Read GIS shapfile
-
-   \param fname The file name.
-
-   03/2010 WW
- */
-void ReadShapeFile(std::string const& fname, RasterDataGIS& raster_data)
+void mHMPreprocessor::buildRasterToNodeOperator(
+    RasterDataGIS const& raster_header, RasterToNodeOperator& op)
 {
-    std::ifstream ins(fname.c_str());
-    if (!ins.good())
-    {
-        std::cout << "Can not find file "
-                  << "\n";
-        return;
-    }
-
-    std::string aline;
-    std::stringstream ss;
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.ncols;
-    ss.clear();
-
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.nrows;
-    ss.clear();
-
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.x0;
-    ss.clear();
-
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.y0;
-    ss.clear();
-
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.csize;
-    ss.clear();
-
-    getline(ins, aline);
-    ss.str(aline);
-    ss >> aline >> raster_data.ndata_v;
-    ss.clear();
-
-    raster_data.zz.clear();
-    raster_data.zz.resize(raster_data.nrows * raster_data.ncols);
-    for (std::size_t i = 0; i < raster_data.zz.size(); i++)
-        ins >> raster_data.zz[i];
-    ins.close();
-}
-
-RasterDataGIS mHMPreprocessor::transfromSingle_mHMdataToNodalFlux(
-    std::string const& fname, std::string const& ofname, double ratio)
-{
-    std::vector<double> val;
-    val.resize(NodesNumber_Linear);
-    const std::size_t nod_vector_size(nod_vector.size());
-    for (std::size_t i = 0; i < nod_vector_size; i++)
-    {
-        nod_vector[i]->SetMark(false);
-        val[i] = 0.0;
-    }
-
-    //
-    RasterDataGIS raster_data;
-    ReadShapeFile(fname, raster_data);
-
-    //
-    std::ofstream ofile_bin(ofname.c_str(), std::ios::trunc | std::ios::binary);
-    ofile_bin.setf(std::ios::scientific, std::ios::floatfield);
-    ofile_bin.precision(14);
+    std::vector<OperatorEntry> entries;
 
+    std::size_t cell_ids[8];
     double node_val[8];
     for (std::size_t i = 0; i < face_vector.size(); i++)
     {
@@ -245,79 +423,58 @@ RasterDataGIS mHMPreprocessor::transfromSingle_mHMdataToNodalFlux(
         if (!elem->GetMark())
             continue;
 
-        for (std::size_t k = 0; k < elem->GetNodesNumber(false); k++)
-            node_val[k] = 0.0;
-
-        for (std::size_t k = 0; k < elem->GetNodesNumber(false); k++)
-        {
-            CNode const* const node = elem->GetNode(k);
-            double const* const pnt_k(node->getData());
-
-            long nx = static_cast<long>((pnt_k[0] - raster_data.x0) /
-                                        raster_data.csize);
-            long ny = static_cast<long>((pnt_k[1] - raster_data.y0) /
-                                        raster_data.csize);
-            ny = raster_data.nrows - ny;
-            if (ny < 0)
-                ny = 0;
-            if (ny > static_cast<long>(raster_data.nrows))
-                ny = raster_data.nrows;
-
-            if (nx * raster_data.csize + raster_data.x0 >= pnt_k[0])
-                nx -= 1;
-            if (ny * raster_data.csize + raster_data.y0 >= pnt_k[1])
-                ny -= 1;
-            if (nx >= static_cast<long>(raster_data.ncols) - 1)
-                nx = raster_data.ncols - 2;
-            if (ny >= static_cast<long>(raster_data.nrows) - 1)
-                ny = raster_data.nrows - 2;
-            if (nx < 0)
-                nx = 0;
-            if (ny < 0)
-                ny = 0;
-
-            node_val[k] = raster_data.zz[raster_data.ncols * ny + nx];
-            if (fabs(node_val[k] - raster_data.ndata_v) <
-                std::numeric_limits<double>::min())
-                node_val[k] = 0.;
-        }
+        const std::size_t nnodes = elem->GetNodesNumber(false);
+        for (std::size_t k = 0; k < nnodes; k++)
+            cell_ids[k] =
+                getRasterCellIndex(raster_header, elem->GetNode(k)->getData());
 
         elem->ComputeVolume();
         _fem->setOrder(getOrder() + 1);
         _fem->ConfigElement(elem);
-        _fem->FaceIntegration(node_val);
-        for (std::size_t k = 0; k < elem->GetNodesNumber(false); k++)
+
+        // Column k of the local operator is the face integral of the unit
+        // value at node k.
+        for (std::size_t k = 0; k < nnodes; k++)
         {
-            CNode* node = elem->GetNode(k);
-            node->SetMark(true);
-            val[node->GetIndex()] += node_val[k];
+            for (std::size_t l = 0; l < 8; l++)
+                node_val[l] = 0.0;
+            node_val[k] = 1.0;
+            _fem->FaceIntegration(node_val);
+
+            for (std::size_t l = 0; l < nnodes; l++)
+            {
+                OperatorEntry entry;
+                entry.node_id = elem->GetNode(l)->GetIndex();
+                entry.cell_id = cell_ids[k];
+                entry.weight = node_val[l];
+                entries.push_back(entry);
+            }
         }
     }
 
-    std::size_t counter = 0;
-    for (size_t i = 0; i < nod_vector_size; i++)
-    {
-        if (!nod_vector[i]->GetMark())
-            continue;
-        counter++;
-        val[i] *= ratio;
-    }
-    ofile_bin.write((char*)(&counter), sizeof(counter));
+    std::sort(entries.begin(), entries.end());
 
-    for (std::size_t i = 0; i < nod_vector_size; i++)
+    op.node_ids.clear();
+    op.row_ptr.clear();
+    op.cell_ids.clear();
+    op.weights.clear();
+    for (std::size_t i = 0; i < entries.size(); i++)
     {
-        CNode* node = nod_vector[i];
-        if (!node->GetMark())
+        OperatorEntry const& entry = entries[i];
+        if (op.node_ids.empty() || op.node_ids.back() != entry.node_id)
+        {
+            op.node_ids.push_back(entry.node_id);
+            op.row_ptr.push_back(op.cell_ids.size());
+        }
+        else if (op.cell_ids.back() == entry.cell_id)
+        {
+            op.weights.back() += entry.weight;
             continue;
-        std::size_t nx = node->GetIndex();
-        ofile_bin.write((char*)(&nx), sizeof(nx));
-        ofile_bin.write((char*)(&val[i]), sizeof(val[i]));
+        }
+        op.cell_ids.push_back(entry.cell_id);
+        op.weights.push_back(entry.weight);
     }
-
-    ofile_bin.close();
-    val.clear();
-
-    return raster_data;
+    op.row_ptr.push_back(op.cell_ids.size());
 }
 
 }  // end of namespace MeshLib
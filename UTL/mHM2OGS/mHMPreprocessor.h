@@ -25,6 +25,7 @@ class ShapeFunctionPool;
 namespace MeshLib
 {
 struct RasterDataGIS;
+struct RasterToNodeOperator;
 
 /**
  * Process the recharge data of mHM in order to used it as the Neumman BC on the
@@ -42,6 +43,10 @@ public:
     /*!
        \brief Transform the precipitation data of mHM to the Neumann BC of the
      groundwater flow equation.
+     The raster files listed in the pcp file are converted in parallel (if
+     OpenMP is available) by applying a precomputed raster-to-node operator
+     to each raster. The results are written in the binary format that is
+     read by the PRECIPITATION source term.
        06/2010  WW
      */
     void transform_mHMData(const std::string& output_path);
@@ -49,19 +54,16 @@ public:
 private:
     FiniteElement::CElement* _fem;
 
-    /*!  \brief Read GIS shapfile that stores the precipitation data.
-     * This function reads the data of mHM, which is stored in the syntax of
-     * raster file, finds face elements on the top surface, and then performs
-     * the numerical integration on the found surface elements to convert the
-     * mHM data into nodal flux values.
-     *  \param fname        The input file name.
-     *  \param ofname       The output file name.
-     *  \param os_filenames Output stream for file names.
-     *  \param ratio        The ration of precipitation to the infiltration.
-     * 03/2010  WW
+    /*!  \brief Build the sparse operator that maps raster cell values to the
+     * nodal flux on the top surface.
+     * The face integration is linear in the nodal values that are picked from
+     * the raster cells. Therefore it is performed only once per raster
+     * geometry with unit nodal values, and the resulting weights are merged
+     * into a compressed row storage with one row per top surface node.
+     *  \param raster_header Raster geometry (the cell values are not used).
+     *  \param op            The operator to be filled.
      */
-    RasterDataGIS transfromSingle_mHMdataToNodalFlux(std::string const& fname,
-                                                     std::string const& ofname,
-                                                     double ratio = 0.8);
+    void buildRasterToNodeOperator(RasterDataGIS const& raster_header,
+                                   RasterToNodeOperator& op);
 };
 }  // end of namespace MeshLib
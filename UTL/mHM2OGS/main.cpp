@@ -42,7 +42,7 @@ void DisplayMessageConsole()
 }
 void DisplayVersion()
 {
-    std::string ver = "Version: 1.0.";
+    std::string ver = "Version: 1.1.";
     std::cout << ver << std::endl;
 }
 
@@ -0,0 +1,132 @@
+/**
+ * \file TestStiffODESolver.cpp
+ *
+ * Integrates the stiff Robertson problem and a smooth test equation with
+ * the ODE solvers of the kinetic reactions.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// ** INCLUDES **
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// FEM
+#include "StiffODESolver.h"
+
+namespace
+{
+// Robertson's chemical reaction problem (Hairer and Wanner, Solving
+// Ordinary Differential Equations II, Sec. IV.1)
+void robertson(double, double y[], double dydt[], int, long, double)
+{
+    dydt[1] = -0.04 * y[1] + 1.0e4 * y[2] * y[3];
+    dydt[3] = 3.0e7 * y[2] * y[2];
+    dydt[2] = -dydt[1] - dydt[3];
+}
+
+void robertsonJacobian(double, double y[], double dfdt[], double** dfdy, int,
+                       long)
+{
+    dfdt[1] = dfdt[2] = dfdt[3] = 0.0;
+    dfdy[1][1] = -0.04;
+    dfdy[1][2] = 1.0e4 * y[3];
+    dfdy[1][3] = 1.0e4 * y[2];
+    dfdy[3][1] = 0.0;
+    dfdy[3][2] = 6.0e7 * y[2];
+    dfdy[3][3] = 0.0;
+    for (int j = 1; j <= 3; j++)
+        dfdy[2][j] = -dfdy[1][j] - dfdy[3][j];
+}
+
+// y' = -y + cos(t), y(0) = 1, depends on time explicitly
+void forcedDecay(double t, double y[], double dydt[], int, long, double)
+{
+    dydt[1] = -y[1] + std::cos(t);
+}
+
+void forcedDecayJacobian(double t, double*, double dfdt[], double** dfdy,
+                         int, long)
+{
+    dfdt[1] = -std::sin(t);
+    dfdy[1][1] = -1.0;
+}
+
+double forcedDecaySolution(double t)
+{
+    return 0.5 * (std::cos(t) + std::sin(t)) + 0.5 * std::exp(-t);
+}
+
+/// Error at t = 1 of the integration with the fixed step size h
+template <typename Solver>
+double fixedStepError(Solver& solver, double h)
+{
+    double y[2] = {0.0, 1.0};
+    const double atol[2] = {0.0, 1.0e300};  // accept every step
+    double t = 0.0;
+    for (int i = 0; i < static_cast<int>(1.0 / h + 0.5); i++)
+    {
+        double dydt[2];
+        forcedDecay(t, y, dydt, 1, 0, h);
+        double h_done, h_next;
+        solver.step(y, dydt, t, h, 1.0, atol, h_done, h_next);
+    }
+    return std::fabs(y[1] - forcedDecaySolution(1.0));
+}
+}  // namespace
+
+TEST(FEM, StiffODESolverRobertson)
+{
+    FiniteElement::RosenbrockSolver solver(3, robertson, robertsonJacobian, 0);
+    double y[4] = {0.0, 1.0, 0.0, 0.0};
+    const double atol[4] = {0.0, 1.0e-12, 1.0e-12, 1.0e-12};
+    double h_next;
+    int n_unreduced, n_reduced;
+    ASSERT_TRUE(FiniteElement::integrateODE(
+        solver, robertson, y, 3, 0.0, 40.0, 1.0e-6, atol, 1.0e-6, 1.0e-20, 0,
+        20000, h_next, n_unreduced, n_reduced));
+
+    // Reference solution at t = 40
+    ASSERT_NEAR(0.7158271, y[1], 1.0e-5);
+    ASSERT_NEAR(9.185535e-6, y[2], 1.0e-9);
+    ASSERT_NEAR(0.2841637, y[3], 1.0e-5);
+    ASSERT_NEAR(1.0, y[1] + y[2] + y[3], 1.0e-12);
+    // Far fewer steps than an explicit method would need
+    ASSERT_LT(n_unreduced + n_reduced, 1000);
+}
+
+TEST(FEM, StiffODESolverOrder)
+{
+    // Halving the step size reduces the error by 2^order.
+    FiniteElement::RosenbrockSolver rosenbrock(1, forcedDecay,
+                                               forcedDecayJacobian, 0);
+    const double ratio_3 =
+        fixedStepError(rosenbrock, 0.05) / fixedStepError(rosenbrock, 0.025);
+    ASSERT_NEAR(8.0, ratio_3, 0.8);
+
+    FiniteElement::DormandPrinceSolver dopri(1, forcedDecay, 0);
+    const double ratio_5 =
+        fixedStepError(dopri, 0.1) / fixedStepError(dopri, 0.05);
+    ASSERT_NEAR(32.0, ratio_5, 3.2);
+}
+
+TEST(FEM, StiffODESolverEndPoint)
+{
+    // The integration ends exactly at t1, also for step sizes that do not
+    // divide the interval.
+    FiniteElement::DormandPrinceSolver solver(1, forcedDecay, 0);
+    double y[2] = {0.0, 1.0};
+    const double atol[2] = {0.0, 1.0e-12};
+    double h_next;
+    int n_unreduced, n_reduced;
+    ASSERT_TRUE(FiniteElement::integrateODE(
+        solver, forcedDecay, y, 1, 0.0, 2.0, 1.0e-10, atol, 0.3, 1.0e-12, 0,
+        20000, h_next, n_unreduced, n_reduced));
+    ASSERT_NEAR(forcedDecaySolution(2.0), y[1], 1.0e-8);
+}
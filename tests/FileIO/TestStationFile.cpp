@@ -0,0 +1,95 @@
+/**
+ * \file TestStationFile.cpp
+ *
+ * Reads a station file with markup that must not be taken for the end of a
+ * station element, with stations that are split between the chunks in which
+ * the file is read, and with stations outside of the station lists.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// ** INCLUDES **
+#include "gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// FileIO
+#include "XmlIO/RapidXMLInterface.h"
+
+// GEOLIB
+#include "Station.h"
+
+TEST(FileIO, ReadStationFile)
+{
+    const std::string fname("TestStationFile.stn");
+    const std::size_t n_stations(3000);
+    {
+        std::ofstream out(fname.c_str());
+        out << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n"
+            << "<!DOCTYPE OpenGeoSysSTN [ <!ENTITY e \"<>\"> ]>\n"
+            << "<OpenGeoSysSTN>\n"
+            << " <borehole id=\"7\" x=\"7\" y=\"7\"/>\n"
+            << " <stationlist>\n"
+            << "  <station id=\"6\" x=\"6\" y=\"6\">\n"
+            << "   <name>misplaced</name>\n"
+            << "  </station>\n"
+            << "  <name>list</name>\n"
+            << "  <!-- <station id=\"9\" x=\"9\" y=\"9\"> </station> -->\n"
+            << "  <note><![CDATA[<station id=\"8\" x=\"8\" y=\"8\">]]></note>\n"
+            << "  <stations>\n";
+        for (std::size_t i = 0; i < n_stations; i++)
+            out << "   <station id=\"" << i << "\" x=\"" << i
+                << "\" y=\"1\" z=\"2\" remark='a > b'>\n"
+                << "    <!-- </station> -->\n"
+                << "    <name>s" << i << "</name>\n"
+                << "   </station>\n";
+        out << "   <station id=\"" << n_stations << "\" x=\"-1\" y=\"-2\"/>\n"
+            << "  </stations>\n"
+            << "  <boreholes>\n"
+            << "   <borehole id=\"0\" x=\"5\" y=\"6\" z=\"7\">\n"
+            << "    <name>b0</name>\n"
+            << "    <bdepth>10</bdepth>\n"
+            << "    <strat>\n"
+            << "     <horizon id=\"0\" x=\"5\" y=\"6\" z=\"3\">\n"
+            << "      <name>h0</name>\n"
+            << "     </horizon>\n"
+            << "    </strat>\n"
+            << "   </borehole>\n"
+            << "  </boreholes>\n"
+            << " </stationlist>\n"
+            << "</OpenGeoSysSTN>\n";
+    }
+
+    std::vector<GEOLIB::Point*>* stations(
+        FileIO::RapidXMLInterface::readStationFile(fname));
+    std::remove(fname.c_str());
+    ASSERT_TRUE(stations != NULL);
+    ASSERT_EQ(n_stations + 2, stations->size());
+    for (std::size_t i = 0; i < n_stations; i++)
+    {
+        GEOLIB::Station const* s(
+            static_cast<GEOLIB::Station*>((*stations)[i]));
+        ASSERT_EQ(static_cast<double>(i), (*s)[0]);
+        ASSERT_EQ(2.0, (*s)[2]);
+        std::ostringstream name;
+        name << "s" << i;
+        ASSERT_EQ(name.str(), s->getName());
+    }
+    ASSERT_EQ(-2.0, (*(*stations)[n_stations])[1]);
+    GEOLIB::Station const* b(
+        static_cast<GEOLIB::Station*>((*stations)[n_stations + 1]));
+    ASSERT_EQ("b0", b->getName());
+    ASSERT_EQ(7.0, (*b)[2]);
+
+    for (std::size_t i = 0; i < stations->size(); i++)
+        delete (*stations)[i];
+    delete stations;
+}
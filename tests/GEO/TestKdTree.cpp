@@ -0,0 +1,93 @@
+/**
+ * \file TestKdTree.cpp
+ *
+ * Compares the nearest point queries of the k-d tree with a linear search.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// ** INCLUDES **
+#include "gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+// GEOLIB
+#include "KdTree.h"
+
+namespace
+{
+double sqrDist(std::vector<double> const& x, std::vector<double> const& y,
+               std::vector<double> const& z, std::size_t i, double const* p)
+{
+    return (x[i] - p[0]) * (x[i] - p[0]) + (y[i] - p[1]) * (y[i] - p[1]) +
+           (z[i] - p[2]) * (z[i] - p[2]);
+}
+}  // namespace
+
+TEST(GEO, KdTreeNearestPoints)
+{
+    // Random points and a regular grid with exact coordinates, so that the
+    // grid points have equal distances to the cell centres.
+    std::srand(1);
+    std::vector<double> x, y, z;
+    for (std::size_t i(0); i < 500; i++)
+    {
+        x.push_back(10.0 * std::rand() / (double)RAND_MAX);
+        y.push_back(10.0 * std::rand() / (double)RAND_MAX);
+        z.push_back(std::rand() / (double)RAND_MAX);
+    }
+    for (std::size_t i(0); i < 10; i++)
+        for (std::size_t j(0); j < 10; j++)
+        {
+            x.push_back(static_cast<double>(i));
+            y.push_back(static_cast<double>(j));
+            z.push_back(5.0);
+        }
+    x.push_back(x[7]);
+    y.push_back(y[7]);
+    z.push_back(z[7]);
+
+    GEOLIB::KdTree tree(x, y, z);
+    ASSERT_EQ(x.size(), tree.size());
+
+    const std::size_t k(6);
+    std::vector<std::size_t> ids;
+    std::vector<double> sqr_dists;
+    for (std::size_t q(0); q < 300; q++)
+    {
+        double p[3] = {10.0 * std::rand() / (double)RAND_MAX,
+                       10.0 * std::rand() / (double)RAND_MAX, 5.0};
+        if (q % 3 == 0)  // equidistant to four grid points
+        {
+            p[0] = 0.5 + (q % 9);
+            p[1] = 0.5 + (q % 7);
+        }
+
+        // linear search, first point of the smallest distance
+        std::vector<std::pair<double, std::size_t> > all;
+        for (std::size_t i(0); i < x.size(); i++)
+            all.push_back(std::make_pair(sqrDist(x, y, z, i, p), i));
+        std::sort(all.begin(), all.end());
+
+        ASSERT_EQ(all[0].second, tree.getNearestPoint(p));
+
+        tree.getNearestPoints(p, k, ids, sqr_dists);
+        ASSERT_EQ(k, ids.size());
+        for (std::size_t i(0); i < k; i++)
+        {
+            ASSERT_EQ(all[i].second, ids[i]);
+            ASSERT_DOUBLE_EQ(all[i].first, sqr_dists[i]);
+        }
+    }
+
+    // identical points: the smaller index is found
+    const double p7[3] = {x[7], y[7], z[7]};
+    ASSERT_EQ(7u, tree.getNearestPoint(p7));
+}
@@ -0,0 +1,74 @@
+/**
+ * \file TestPointVecUnique.cpp
+ *
+ * Tests the removal of identical points in PointVec, which uses a spatial hash
+ * of the points.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// ** INCLUDES **
+#include "gtest.h"
+
+#include <vector>
+
+// GEOLIB
+#include "Point.h"
+#include "PointVec.h"
+
+TEST(GEO, PointVecUniquePoints)
+{
+    // A regular grid of points, every third point is given twice.
+    const size_t n(20);
+    std::vector<GEOLIB::Point*>* pnts(new std::vector<GEOLIB::Point*>);
+    std::vector<size_t> expected_ids;
+    size_t n_unique(0);
+    for (size_t i(0); i < n; i++)
+        for (size_t j(0); j < n; j++)
+        {
+            const double x(0.1 * i), y(0.1 * j), z(0.01 * i * j);
+            pnts->push_back(new GEOLIB::Point(x, y, z));
+            expected_ids.push_back(n_unique);
+            if ((i * n + j) % 3 == 0)
+            {
+                pnts->push_back(new GEOLIB::Point(x, y, z));
+                expected_ids.push_back(n_unique);
+            }
+            n_unique++;
+        }
+
+    GEOLIB::PointVec pnt_vec("test", pnts);
+    ASSERT_EQ(n_unique, pnt_vec.size());
+    ASSERT_EQ(expected_ids.size(), pnt_vec.getIDMap().size());
+    for (size_t k(0); k < expected_ids.size(); k++)
+        ASSERT_EQ(expected_ids[k], pnt_vec.getIDMap()[k]);
+
+    // Points added later are compared with all points, also beyond the
+    // enlargement of the hash.
+    for (size_t i(0); i < n; i++)
+        for (size_t j(0); j < n; j++)
+        {
+            ASSERT_EQ(i * n + j, pnt_vec.uniqueInsert(new GEOLIB::Point(
+                                     0.1 * i, 0.1 * j, 0.01 * i * j)));
+            ASSERT_EQ(n_unique, pnt_vec.uniqueInsert(new GEOLIB::Point(
+                                    0.1 * i + 5.0, 0.1 * j, 0.0)));
+            n_unique++;
+        }
+    ASSERT_EQ(n_unique, pnt_vec.size());
+    ASSERT_EQ(expected_ids.size(), pnt_vec.getIDMap().size());
+
+    const size_t id(pnt_vec.push_back(new GEOLIB::Point(5.0, 0.0, 0.0)));
+    ASSERT_EQ(n * n, id);
+    ASSERT_EQ(n_unique, pnt_vec.size());
+    ASSERT_NEAR(0.1, pnt_vec.getShortestPointDistance(), 1e-12);
+
+    // A point inserted twice on purpose, the first one is found afterwards.
+    ASSERT_EQ(n_unique, pnt_vec.insert(new GEOLIB::Point(0.0, 0.0, 0.0)));
+    ASSERT_EQ(n_unique + 1, pnt_vec.size());
+    ASSERT_EQ(0u, pnt_vec.uniqueInsert(new GEOLIB::Point(0.0, 0.0, 0.0)));
+    ASSERT_EQ(0.0, pnt_vec.getShortestPointDistance());
+}
@@ -0,0 +1,85 @@
+/**
+ * \file TestPolygonEdgeBuckets.cpp
+ *
+ * Tests the batch point in polygon query, which uses the y-slab edge buckets,
+ * against the query of single points.
+ *
+ * \copyright
+ * Copyright (c) 2018, OpenGeoSys Community (http://www.opengeosys.org)
+ *            Distributed under a Modified BSD License.
+ *              See accompanying file LICENSE.txt or
+ *              http://www.opengeosys.org/project/license
+ */
+
+// ** INCLUDES **
+#include "gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// GEOLIB
+#include "Point.h"
+#include "Polyline.h"
+#include "Polygon.h"
+
+TEST(GEO, PointInPolygonEdgeBuckets)
+{
+    // A star shaped polygon with horizontal and vertical edges at the tips.
+    std::vector<GEOLIB::Point*> ply_pnts;
+    const size_t n_tips(50);
+    for (size_t k(0); k < n_tips; k++)
+    {
+        const double phi(2.0 * 3.14159265358979323846 * k / n_tips);
+        const double r_outer(k % 2 == 0 ? 4.0 : 3.0);
+        const double y(std::floor(r_outer * std::sin(phi) * 4.0) / 4.0);
+        ply_pnts.push_back(new GEOLIB::Point(
+            std::floor(r_outer * std::cos(phi) * 4.0) / 4.0, y, 0.0));
+        ply_pnts.push_back(new GEOLIB::Point(
+            std::floor(std::cos(phi) * 4.0) / 4.0 + 0.25, y, 0.0));
+    }
+    GEOLIB::Polyline ply(ply_pnts);
+    for (size_t k(0); k < ply_pnts.size(); k++)
+        ply.addPoint(k);
+    ply.addPoint(0);
+
+    GEOLIB::Polygon polygon(ply);
+    GEOLIB::Polygon polygon_batch(ply);
+
+    // Points on a regular grid hit vertices and edges of the polygon.
+    std::vector<GEOLIB::Point*> pnts;
+    std::vector<double const*> pnt_coords;
+    for (size_t j(0); j < 201; j++)
+    {
+        for (size_t k(0); k < 201; k++)
+        {
+            pnts.push_back(new GEOLIB::Point(-5.0 + k / 20.0, -5.0 + j / 20.0,
+                                             0.0));
+            pnt_coords.push_back(pnts.back()->getData());
+        }
+    }
+
+    std::vector<size_t> ids_single;
+    for (size_t k(0); k < pnts.size(); k++)
+    {
+        if (polygon.isPntInPolygon(*(pnts[k])))
+            ids_single.push_back(k);
+    }
+
+    std::vector<size_t> ids_batch;
+    polygon_batch.getPntsInPolygon(pnt_coords, ids_batch);
+
+    ASSERT_FALSE(ids_single.empty());
+    ASSERT_EQ(ids_single.size(), ids_batch.size());
+    for (size_t k(0); k < ids_single.size(); k++)
+        ASSERT_EQ(ids_single[k], ids_batch[k]);
+
+    // Single point queries use the edge buckets once they are built.
+    for (size_t k(0); k < pnts.size(); k++)
+        ASSERT_EQ(polygon.isPntInPolygon(*(pnts[k])),
+                  polygon_batch.isPntInPolygon(*(pnts[k])));
+
+    for (size_t k(0); k < pnts.size(); k++)
+        delete pnts[k];
+    for (size_t k(0); k < ply_pnts.size(); k++)
+        delete ply_pnts[k];
+}